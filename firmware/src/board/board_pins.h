@@ -53,6 +53,11 @@
 #define PIN_IAC_STEP_B1         11      // Stepper phase B+
 #define PIN_IAC_STEP_B2         12      // Stepper phase B-
 
+// PWM idle valve (instead of the stepper). FTM0 is the crank/cam capture
+// timebase and FTM1/FTM2 run the output-compare scheduler, so auxiliary
+// PWM outputs use FTM3.
+#define PIN_IDLE_VALVE          2       // PWM idle valve (FTM3_CH0)
+
 //=============================================================================
 // Auxiliary Outputs
 //=============================================================================
@@ -61,7 +66,7 @@
 #define PIN_TACHOMETER          28      // Tachometer output signal
 #define PIN_COOLING_FAN         29      // Radiator fan relay
 #define PIN_CHECK_ENGINE        30      // Malfunction indicator lamp (MIL)
-#define PIN_BOOST_CONTROL       31      // Electronic wastegate (PWM)
+#define PIN_BOOST_CONTROL       14      // Electronic wastegate (PWM, FTM3_CH1)
 
 //=============================================================================
 // Analog Sensor Inputs (ADC)
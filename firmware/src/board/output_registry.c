@@ -0,0 +1,193 @@
+/**
+ * @file output_registry.c
+ * @brief Precomputed output channels implementation
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "output_registry.h"
+#include "board_pins.h"
+#include "gpio_k64.h"
+#include "compiler_k64.h"
+
+//=============================================================================
+// Private Definitions
+//=============================================================================
+
+#define PIN_NONE                0xFF
+#define TEENSY_PIN_COUNT        58
+
+#define PB(port, bit)           ((uint8_t)(((port) << 5) | (bit)))
+#define PB_PORT(pb)             ((uint8_t)((pb) >> 5))
+#define PB_BIT(pb)              ((uint8_t)((pb) & 0x1F))
+
+//=============================================================================
+// Private Variables
+//=============================================================================
+
+/**
+ * @brief Teensy 3.5 pin number -> MK64FX512 port/bit
+ */
+static const uint8_t teensy_pin_map[TEENSY_PIN_COUNT] = {
+    PB(1, 16), PB(1, 17), PB(3, 0),  PB(0, 12), PB(0, 13),  //  0 -  4
+    PB(3, 7),  PB(3, 4),  PB(3, 2),  PB(3, 3),  PB(2, 3),   //  5 -  9
+    PB(2, 4),  PB(2, 6),  PB(2, 7),  PB(2, 5),  PB(3, 1),   // 10 - 14
+    PB(2, 0),  PB(1, 0),  PB(1, 1),  PB(1, 3),  PB(1, 2),   // 15 - 19
+    PB(3, 5),  PB(3, 6),  PB(2, 1),  PB(2, 2),  PB(4, 26),  // 20 - 24
+    PB(0, 5),  PB(0, 14), PB(0, 15), PB(0, 16), PB(1, 18),  // 25 - 29
+    PB(1, 19), PB(1, 10), PB(1, 11), PB(4, 24), PB(4, 25),  // 30 - 34
+    PB(2, 8),  PB(2, 9),  PB(2, 10), PB(2, 11), PB(0, 17),  // 35 - 39
+    PB(0, 28), PB(0, 29), PB(0, 26), PB(1, 20), PB(1, 22),  // 40 - 44
+    PB(1, 23), PB(1, 21), PB(3, 8),  PB(3, 9),  PB(1, 4),   // 45 - 49
+    PB(1, 5),  PB(3, 14), PB(3, 13), PB(3, 12), PB(3, 15),  // 50 - 54
+    PB(3, 11), PB(4, 10), PB(4, 11),                        // 55 - 57
+};
+
+/**
+ * @brief Teensy pin of each logical output
+ */
+static const uint8_t output_pins[OUTPUT_COUNT] = {
+    [OUTPUT_INJECTOR_1]   = PIN_INJECTOR_1,
+    [OUTPUT_INJECTOR_2]   = PIN_INJECTOR_2,
+    [OUTPUT_INJECTOR_3]   = PIN_INJECTOR_3,
+    [OUTPUT_INJECTOR_4]   = PIN_INJECTOR_4,
+    [OUTPUT_INJECTOR_5]   = PIN_INJECTOR_5,
+    [OUTPUT_INJECTOR_6]   = PIN_INJECTOR_6,
+    [OUTPUT_COIL_1]       = PIN_IGNITION_1,
+    [OUTPUT_COIL_2]       = PIN_IGNITION_2,
+    [OUTPUT_COIL_3]       = PIN_IGNITION_3,
+    [OUTPUT_COIL_4]       = PIN_IGNITION_4,
+    [OUTPUT_COIL_5]       = PIN_IGNITION_5,
+    [OUTPUT_COIL_6]       = PIN_IGNITION_6,
+    [OUTPUT_TACH]         = PIN_TACHOMETER,
+    [OUTPUT_FAN]          = PIN_COOLING_FAN,
+    [OUTPUT_FUEL_PUMP]    = PIN_FUEL_PUMP,
+    [OUTPUT_CHECK_ENGINE] = PIN_CHECK_ENGINE,
+};
+
+static const output_id_t bank_first[OUTPUT_BANK_COUNT] = {
+    [OUTPUT_BANK_INJECTORS] = OUTPUT_INJECTOR_1,
+    [OUTPUT_BANK_COILS]     = OUTPUT_COIL_1,
+};
+
+static GPIO_Type* const gpio_ports[5] = { GPIOA, GPIOB, GPIOC, GPIOD, GPIOE };
+
+/**
+ * @brief Dummy target for unconfigured outputs (mask 0, no effect)
+ */
+static volatile uint32_t output_sink;
+
+FAST_DATA output_channel_t output_channels[OUTPUT_COUNT];
+FAST_DATA output_bank_t output_banks[OUTPUT_BANK_COUNT];
+
+//=============================================================================
+// Private Helper Functions
+//=============================================================================
+
+/**
+ * @brief Build per-port masks for every combination of a bank
+ */
+static void build_bank(output_bank_t* bank, output_id_t first)
+{
+    uint8_t ports[OUTPUT_BANK_SIZE];
+    uint32_t bit_masks[OUTPUT_BANK_SIZE];
+
+    memset(bank, 0, sizeof(output_bank_t));
+
+    // Port slot used by each output of the bank
+    for (uint8_t i = 0; i < OUTPUT_BANK_SIZE; i++) {
+        const output_channel_t* ch = &output_channels[first + i];
+        uint8_t slot;
+
+        for (slot = 0; slot < bank->num_ports; slot++) {
+            if (bank->psor[slot] == ch->psor) {
+                break;
+            }
+        }
+        if (slot == bank->num_ports && slot < OUTPUT_BANK_MAX_PORTS) {
+            bank->psor[slot] = ch->psor;
+            bank->pcor[slot] = ch->pcor;
+            bank->num_ports++;
+        }
+
+        ports[i] = slot;
+        bit_masks[i] = (slot < OUTPUT_BANK_MAX_PORTS) ? ch->mask : 0;
+    }
+
+    for (uint32_t combo = 0; combo < OUTPUT_BANK_COMBOS; combo++) {
+        for (uint8_t i = 0; i < OUTPUT_BANK_SIZE; i++) {
+            if ((combo & (1U << i)) != 0 && bit_masks[i] != 0) {
+                bank->mask[ports[i]][combo] |= bit_masks[i];
+            }
+        }
+    }
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+bool output_registry_map_pin(uint8_t teensy_pin, uint8_t* port, uint8_t* bit)
+{
+    if (port == NULL || bit == NULL || teensy_pin >= TEENSY_PIN_COUNT) {
+        return false;
+    }
+
+    uint8_t pb = teensy_pin_map[teensy_pin];
+    if (pb == PIN_NONE) {
+        return false;
+    }
+
+    *port = PB_PORT(pb);
+    *bit = PB_BIT(pb);
+    return true;
+}
+
+bool output_registry_init(void)
+{
+    bool ok = true;
+
+    for (uint8_t id = 0; id < OUTPUT_COUNT; id++) {
+        output_channel_t* ch = &output_channels[id];
+        uint8_t port;
+        uint8_t bit;
+
+        if (!output_registry_map_pin(output_pins[id], &port, &bit)) {
+            ch->psor = &output_sink;
+            ch->pcor = &output_sink;
+            ch->mask = 0;
+            ok = false;
+            continue;
+        }
+
+        GPIO_Type* gpio = gpio_ports[port];
+        ch->psor = &gpio->PSOR;
+        ch->pcor = &gpio->PCOR;
+        ch->mask = 1UL << bit;
+
+        // Drive low before switching to output so nothing fires at init
+        gpio->PCOR = ch->mask;
+        gpio_config((gpio_port_t)port, (gpio_pin_t)bit, GPIO_DIR_OUTPUT);
+    }
+
+    for (uint8_t b = 0; b < OUTPUT_BANK_COUNT; b++) {
+        build_bank(&output_banks[b], bank_first[b]);
+    }
+
+    return ok;
+}
+
+FAST_CODE void output_coils_on(cylinder_mask_t mask)
+{
+    output_bank_on(OUTPUT_BANK_COILS, (uint8_t)mask);
+}
+
+FAST_CODE void output_coils_off(cylinder_mask_t mask)
+{
+    output_bank_off(OUTPUT_BANK_COILS, (uint8_t)mask);
+}
@@ -0,0 +1,179 @@
+/**
+ * @file output_registry.h
+ * @brief Precomputed output channels (PSOR/PCOR pointer + mask)
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * board_pins.h names outputs by Teensy pin number. gpio_set()/gpio_clear()
+ * take a (port, pin) pair and decode the port on every call. In the
+ * injector/coil callback path that decode is done thousands of times per
+ * second for values that never change.
+ *
+ * output_registry_init() maps every logical output (injector N, coil N,
+ * tach, fan, ...) once to its GPIO port and builds:
+ * - per output: PSOR/PCOR register pointers and the pin mask, so one edge
+ *   is one store (output_on() / output_off(), inlined)
+ * - per bank (injectors, coils): for every combination of outputs in the
+ *   bank, the mask to write on each port used by the bank, so a batch /
+ *   simultaneous injection or a wasted-spark pair is one store per port
+ *   (output_bank_on() / output_bank_off())
+ *
+ * Bank masks use the same bit numbering as the dispatcher and
+ * ignition_coils_t: bit n = injector/coil n+1. output_coils_on() and
+ * output_coils_off() match multispark_coil_t.
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef OUTPUT_REGISTRY_H
+#define OUTPUT_REGISTRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "engine_capacity.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=============================================================================
+// Logical Outputs
+//=============================================================================
+
+typedef enum {
+    OUTPUT_INJECTOR_1 = 0,
+    OUTPUT_INJECTOR_2,
+    OUTPUT_INJECTOR_3,
+    OUTPUT_INJECTOR_4,
+    OUTPUT_INJECTOR_5,
+    OUTPUT_INJECTOR_6,
+    OUTPUT_COIL_1,
+    OUTPUT_COIL_2,
+    OUTPUT_COIL_3,
+    OUTPUT_COIL_4,
+    OUTPUT_COIL_5,
+    OUTPUT_COIL_6,
+    OUTPUT_TACH,
+    OUTPUT_FAN,
+    OUTPUT_FUEL_PUMP,
+    OUTPUT_CHECK_ENGINE,
+    OUTPUT_COUNT
+} output_id_t;
+
+typedef enum {
+    OUTPUT_BANK_INJECTORS = 0,
+    OUTPUT_BANK_COILS,
+    OUTPUT_BANK_COUNT
+} output_bank_id_t;
+
+#define OUTPUT_BANK_SIZE        6       ///< Outputs per bank (board_pins.h)
+#define OUTPUT_BANK_COMBOS      (1U << OUTPUT_BANK_SIZE)
+#define OUTPUT_BANK_MAX_PORTS   4
+
+//=============================================================================
+// Registry Types
+//=============================================================================
+
+/**
+ * @brief One output: set/clear register and pin mask
+ */
+typedef struct {
+    volatile uint32_t* psor;
+    volatile uint32_t* pcor;
+    uint32_t mask;
+} output_channel_t;
+
+/**
+ * @brief Bank of outputs: per used port, the mask for each combination
+ */
+typedef struct {
+    uint8_t num_ports;
+    volatile uint32_t* psor[OUTPUT_BANK_MAX_PORTS];
+    volatile uint32_t* pcor[OUTPUT_BANK_MAX_PORTS];
+    uint32_t mask[OUTPUT_BANK_MAX_PORTS][OUTPUT_BANK_COMBOS];
+} output_bank_t;
+
+extern output_channel_t output_channels[OUTPUT_COUNT];
+extern output_bank_t output_banks[OUTPUT_BANK_COUNT];
+
+//=============================================================================
+// Function Prototypes
+//=============================================================================
+
+/**
+ * @brief Configure all outputs (driven low) and build the registry
+ *
+ * Call after gpio_init().
+ *
+ * @return true on success, false if a pin has no GPIO mapping
+ */
+bool output_registry_init(void);
+
+/**
+ * @brief Map a Teensy 3.5 pin number to GPIO port and bit
+ *
+ * @param teensy_pin Teensy pin number (board_pins.h)
+ * @param port Receives the port (0 = A ... 4 = E)
+ * @param bit Receives the bit number in the port
+ * @return true if the pin exists
+ */
+bool output_registry_map_pin(uint8_t teensy_pin, uint8_t* port, uint8_t* bit);
+
+//=============================================================================
+// Output Edges (one store each)
+//=============================================================================
+
+static inline void output_on(output_id_t id)
+{
+    *output_channels[id].psor = output_channels[id].mask;
+}
+
+static inline void output_off(output_id_t id)
+{
+    *output_channels[id].pcor = output_channels[id].mask;
+}
+
+/**
+ * @brief Drive several outputs of a bank high (one store per port)
+ */
+static inline void output_bank_on(output_bank_id_t bank, uint8_t outputs)
+{
+    const output_bank_t* b = &output_banks[bank];
+    outputs &= (OUTPUT_BANK_COMBOS - 1);
+    for (uint8_t p = 0; p < b->num_ports; p++) {
+        uint32_t mask = b->mask[p][outputs];
+        if (mask != 0) {
+            *b->psor[p] = mask;
+        }
+    }
+}
+
+/**
+ * @brief Drive several outputs of a bank low (one store per port)
+ */
+static inline void output_bank_off(output_bank_id_t bank, uint8_t outputs)
+{
+    const output_bank_t* b = &output_banks[bank];
+    outputs &= (OUTPUT_BANK_COMBOS - 1);
+    for (uint8_t p = 0; p < b->num_ports; p++) {
+        uint32_t mask = b->mask[p][outputs];
+        if (mask != 0) {
+            *b->pcor[p] = mask;
+        }
+    }
+}
+
+/**
+ * @brief Coil callbacks (multispark_coil_t signature)
+ *
+ * The board wires OUTPUT_BANK_SIZE coils; higher mask bits are ignored.
+ */
+void output_coils_on(cylinder_mask_t mask);
+void output_coils_off(cylinder_mask_t mask);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OUTPUT_REGISTRY_H
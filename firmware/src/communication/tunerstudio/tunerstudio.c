@@ -12,6 +12,9 @@
 
 #include "tunerstudio.h"
 #include "../../hal/uart_k64.h"
+#include "../../hal/compiler_k64.h"
+#include "../../memory/mem_report.h"
+#include "../../memory/event_trace.h"
 #include <string.h>
 
 //=============================================================================
@@ -23,7 +26,7 @@ ts_counters_t ts_counters;
 static uint8_t ts_buffer[TS_MAX_PACKET_SIZE];
 static uint16_t ts_buffer_index = 0;
 static uint8_t ts_packet_state = 0;
-static uint8_t ts_expected_size = 0;
+static uint16_t ts_expected_size = 0;
 static uint32_t ts_last_timestamp = 0;
 
 //=============================================================================
@@ -77,6 +80,21 @@ static uint8_t uart_bytes_available(void) {
 // Packet Processing
 //=============================================================================
 
+static void reset_framing(void) {
+    ts_buffer_index = 0;
+    ts_packet_state = 0;
+    ts_expected_size = 0;
+}
+
+/**
+ * @brief Check that [offset, offset + size) lies inside one config page
+ *
+ * Done in 32-bit so offset + size cannot wrap.
+ */
+static int chunk_in_page(uint16_t offset, uint16_t size) {
+    return ((uint32_t)offset + (uint32_t)size) <= TS_PAGE_SIZE;
+}
+
 static void process_query_command(void) {
     // Send query response
     uint8_t response[32];
@@ -126,6 +144,13 @@ static void process_output_channels_command(void) {
 
 static void process_read_page_command(uint16_t page, uint16_t size) {
     uint8_t data[TS_MAX_DATA_SIZE];
+
+    // Response must fit in one packet
+    if (size > TS_MAX_DATA_SIZE) {
+        ts_counters.errorOutOfRange++;
+        tunerstudio_send_response(TS_RESPONSE_OUT_OF_RANGE, NULL, 0);
+        return;
+    }
     
     // Read page data
     tunerstudio_read_page(page, data, size);
@@ -136,7 +161,11 @@ static void process_read_page_command(uint16_t page, uint16_t size) {
 
 static void process_write_chunk_command(uint16_t page, uint16_t offset, const uint8_t* data, uint8_t size) {
     // Write chunk data
-    tunerstudio_write_chunk(page, offset, data, size);
+    if (tunerstudio_write_chunk(page, offset, data, size) != 0) {
+        ts_counters.errorOutOfRange++;
+        tunerstudio_send_response(TS_RESPONSE_OUT_OF_RANGE, NULL, 0);
+        return;
+    }
     
     // Send acknowledgment
     tunerstudio_send_response(TS_RESPONSE_OK, NULL, 0);
@@ -151,17 +180,22 @@ static void process_burn_command(uint16_t page) {
 }
 
 static void process_packet(void) {
-    if (ts_buffer_index < TS_PACKET_HEADER_SIZE) {
+    if (ts_buffer_index < TS_PACKET_HEADER_SIZE + TS_PACKET_TAIL_SIZE) {
+        ts_counters.errorUnderrunCounter++;
         return;  // Incomplete packet
     }
     
     // Parse packet header
     uint8_t command = ts_buffer[0];
     uint16_t offset = (ts_buffer[1] << 8) | ts_buffer[2];
-    uint8_t data_size = ts_buffer_index - TS_PACKET_HEADER_SIZE;
+
+    // Payload sits between header and CRC tail; framing guarantees it
+    // never exceeds TS_MAX_DATA_SIZE, so it fits the uint8_t chunk size
+    uint16_t data_size = ts_buffer_index - TS_PACKET_HEADER_SIZE - TS_PACKET_TAIL_SIZE;
     
     // Update counters
     ts_counters.totalCounter++;
+    event_trace_record(EVENT_TRACE_TS_PACKET, command, data_size);
     
     switch (command) {
         case TS_COMMAND_QUERY:
@@ -181,7 +215,8 @@ static void process_packet(void) {
             
         case TS_COMMAND_WRITE_CHUNK:
             ts_counters.writeChunkCommandCounter++;
-            tunerstudio_write_chunk(0, offset, &ts_buffer[TS_PACKET_HEADER_SIZE], data_size);
+            process_write_chunk_command(0, offset, &ts_buffer[TS_PACKET_HEADER_SIZE],
+                                        (uint8_t)data_size);
             break;
             
         case TS_COMMAND_BURN:
@@ -228,9 +263,7 @@ void tunerstudio_init(void) {
     memset(&ts_counters, 0, sizeof(ts_counters));
     
     // Initialize buffer
-    ts_buffer_index = 0;
-    ts_packet_state = 0;
-    ts_expected_size = 0;
+    reset_framing();
     
     tunerstudio_debug("TunerStudio initialized");
 }
@@ -258,24 +291,29 @@ void tunerstudio_process_byte(uint8_t byte) {
             ts_buffer_index = 0;
         }
     } else if (ts_packet_state == 1) {
-        // Read packet size
-        ts_expected_size = byte + TS_PACKET_HEADER_SIZE + TS_PACKET_TAIL_SIZE;
+        // Read packet size, rejecting payloads that cannot fit the buffer
+        if (byte > TS_MAX_DATA_SIZE) {
+            ts_counters.errorOverrunCounter++;
+            reset_framing();
+            return;
+        }
+        ts_expected_size = (uint16_t)byte + TS_PACKET_HEADER_SIZE + TS_PACKET_TAIL_SIZE;
         ts_packet_state = 2;
     } else if (ts_packet_state == 2) {
         // Read packet data
-        if (ts_buffer_index < ts_expected_size) {
-            ts_buffer[ts_buffer_index++] = byte;
-            
-            if (ts_buffer_index >= ts_expected_size) {
-                // Packet complete, process it
-                process_packet();
-                
-                // Reset for next packet
-                ts_buffer_index = 0;
-                ts_packet_state = 0;
-                ts_expected_size = 0;
-            }
+        ts_buffer[ts_buffer_index++] = byte;
+
+        if (ts_buffer_index >= ts_expected_size) {
+            // Packet complete, process it
+            process_packet();
+
+            // Reset for next packet
+            reset_framing();
         }
+    } else {
+        // Unknown state - resynchronize on next start byte
+        ts_counters.errorOther++;
+        reset_framing();
     }
 }
 
@@ -330,18 +368,39 @@ void tunerstudio_update_channels(void) {
 void tunerstudio_read_page(uint16_t page, uint8_t* data, uint16_t size) {
     // TODO: Implement page reading from flash/EEPROM
     memset(data, 0, size);
+
+    // Memory footprint page is generated live
+    if (page == TS_PAGE_MEMORY) {
+        mem_report_t report;
+        uint8_t report_data[MEM_REPORT_SIZE];
+
+        mem_report_collect(&report);
+        uint16_t length = mem_report_serialize(&report, report_data, sizeof(report_data));
+        memcpy(data, report_data, (length < size) ? length : size);
+        return;
+    }
+
+    // Event trace dump, one EVENT_TRACE_CHUNK_SIZE chunk per page
+    if ((page & 0xFF00) == TS_PAGE_EVENT_TRACE) {
+        event_trace_read_chunk((uint8_t)(page & 0xFF), data, size);
+        return;
+    }
     
     tunerstudio_debug("Page read requested");
 }
 
-void tunerstudio_write_chunk(uint16_t page, uint16_t offset, const uint8_t* data, uint8_t size) {
+int tunerstudio_write_chunk(uint16_t page, uint16_t offset, const uint8_t* data, uint8_t size) {
+    // Reject chunks that would run past the end of the page, and writes
+    // to the read-only memory report and event trace pages
+    if (data == NULL || !chunk_in_page(offset, size) || page == TS_PAGE_MEMORY ||
+        (page & 0xFF00) == TS_PAGE_EVENT_TRACE) {
+        return -1;
+    }
+
     // TODO: Implement chunk writing to flash/EEPROM
-    (void)page;
-    (void)offset;
-    (void)data;
-    (void)size;
     
     tunerstudio_debug("Chunk write requested");
+    return 0;
 }
 
 void tunerstudio_burn_page(uint16_t page) {
@@ -356,7 +415,7 @@ uint32_t tunerstudio_get_timestamp(void) {
     return ts_last_timestamp;
 }
 
-void tunerstudio_debug(const char* message) {
+COLD_FUNC void tunerstudio_debug(const char* message) {
     // Send debug message via UART
     uart_puts(UART_0, "[TS_DEBUG] ");
     uart_puts(UART_0, message);
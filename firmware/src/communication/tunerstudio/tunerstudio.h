@@ -40,6 +40,8 @@ extern "C" {
 #define TS_PAGE_SETTINGS              0x0000
 #define TS_PAGE_SCATTER_OFFSETS        0x0100
 #define TS_PAGE_LTFT_TRIMS             0x0200
+#define TS_PAGE_MEMORY                 0x0300  // Read-only, see mem_report.h
+#define TS_PAGE_EVENT_TRACE            0x0400  // Read-only, 0x04nn = chunk nn, see event_trace.h
 
 // Packet structure
 #define TS_PACKET_HEADER_SIZE          3
@@ -47,6 +49,9 @@ extern "C" {
 #define TS_MAX_PACKET_SIZE             256
 #define TS_MAX_DATA_SIZE              (TS_MAX_PACKET_SIZE - TS_PACKET_HEADER_SIZE - TS_PACKET_TAIL_SIZE)
 
+// Configuration page geometry (must match CONFIG_PAGE_SIZE in config.h)
+#define TS_PAGE_SIZE                   1024
+
 // Response codes
 #define TS_RESPONSE_OK                 0x00
 #define TS_RESPONSE_ERROR              0x01
@@ -85,6 +90,15 @@ typedef enum {
     TS_CHANNEL_DEBUG_INT2,
     TS_CHANNEL_DEBUG_INT3,
     TS_CHANNEL_DEBUG_INT4,
+    TS_CHANNEL_EGT_1,               // Per-cylinder EGT (°C), ext_sensors
+    TS_CHANNEL_EGT_2,
+    TS_CHANNEL_EGT_3,
+    TS_CHANNEL_EGT_4,
+    TS_CHANNEL_EGT_5,
+    TS_CHANNEL_EGT_6,
+    TS_CHANNEL_EGT_7,
+    TS_CHANNEL_EGT_8,
+    TS_CHANNEL_FUEL_PRESSURE,       // kPa, external ADC
     TS_CHANNEL_COUNT
 } ts_channel_e;
 
@@ -142,7 +156,7 @@ void tunerstudio_update_channels(void);
 
 // Configuration functions
 void tunerstudio_read_page(uint16_t page, uint8_t* data, uint16_t size);
-void tunerstudio_write_chunk(uint16_t page, uint16_t offset, const uint8_t* data, uint8_t size);
+int tunerstudio_write_chunk(uint16_t page, uint16_t offset, const uint8_t* data, uint8_t size);
 void tunerstudio_burn_page(uint16_t page);
 
 // Utility functions
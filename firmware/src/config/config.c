@@ -12,8 +12,14 @@
  */
 
 #include "config.h"
+#include "../memory/mem_pool.h"
+#include <stddef.h>
 #include <string.h>
 
+#if MEM_POOL_PAGE_SIZE < CONFIG_PAGE_SIZE
+#error "MEM_POOL_PAGE_SIZE must hold a full configuration page"
+#endif
+
 // Simplified flash operations for Teensy 3.5
 // TODO: Implement proper flash driver
 
@@ -73,7 +79,7 @@ static void config_set_default_engine(void) {
     config_engine.coolant_temp_limit = 120;      // 120°C
     config_engine.oil_temp_limit = 130;           // 130°C
     config_engine.knock_limit = 5;               // 5V
-    config_engine.serial_speed = 115200;        // 115200 baud
+    config_engine.serial_speed = CONFIG_SERIAL_115200;
     config_engine.serial_enabled = 1;           // Enabled
     config_engine.can_enabled = 1;              // Enabled
     config_engine.wideband_enabled = 1;          // Enabled
@@ -86,7 +92,7 @@ static void config_set_default_ve_table(void) {
     // VE Table (simplified)
     for (int i = 0; i < 16; i++) {
         for (int j = 0; j < 16; j++) {
-            config_ve_table.ve_table[i][j] = 1000 + (i * 100) + (j * 10); // Simple linear VE table
+            config_ve_table.ve_table[i][j] = 1000 + (i * 60) + (j * 6); // Simple linear VE table, 100-199 %
         }
     }
     
@@ -191,17 +197,20 @@ int config_burn_page(uint16_t page) {
     }
     
     // Validate page before burning
-    uint8_t buffer[CONFIG_PAGE_SIZE];
-    if (config_read_page(page, buffer) != 0) {
-        return -1;  // Read failed
+    uint8_t* buffer = (uint8_t*)mem_pool_alloc(MEM_POOL_PAGE);
+    if (buffer == NULL) {
+        return -1;  // No page buffer available
     }
     
-    if (config_validate_page(page, buffer) != 0) {
-        return -1;  // Validation failed
+    int result = -1;
+    if (config_read_page(page, buffer) == 0 &&
+        config_validate_page(page, buffer) == 0) {
+        // Burn to Flash (simplified - just write for now)
+        result = config_write_page(page, buffer);
     }
     
-    // Burn to Flash (simplified - just write for now)
-    return config_write_page(page, buffer);
+    mem_pool_free(MEM_POOL_PAGE, buffer);
+    return result;
 }
 
 config_engine_t* config_get_engine(void) {
@@ -231,9 +240,11 @@ int config_validate_page(uint16_t page, const uint8_t* buffer) {
             break;
             
         case CONFIG_PAGE_VE_TABLE:
-            // Validate VE table
-            for (int i = 0; i < CONFIG_PAGE_SIZE; i++) {
-                if (buffer[i] > 2000) return -1;  // Invalid VE value
+            // Validate VE table cells (uint16_t, page image in memory order)
+            for (size_t i = 0; i < 16 * 16; i++) {
+                uint16_t ve;
+                memcpy(&ve, &buffer[offsetof(config_ve_table_t, ve_table) + i * sizeof(ve)], sizeof(ve));
+                if (ve > CONFIG_VE_MAX) return -1;  // Invalid VE value
             }
             break;
             
@@ -252,19 +263,29 @@ int config_validate_page(uint16_t page, const uint8_t* buffer) {
 }
 
 int config_validate_all(void) {
-    uint8_t buffer[CONFIG_PAGE_SIZE];
+    uint8_t* buffer = (uint8_t*)mem_pool_alloc(MEM_POOL_PAGE);
+    if (buffer == NULL) {
+        return -1;  // No page buffer available
+    }
     
     // Validate all pages
+    int result = 0;
     for (uint16_t page = 0; page < CONFIG_TOTAL_PAGES; page++) {
-        if (config_read_page(page, buffer) != 0) {
-            return -1;  // Read failed
-        }
-        if (config_validate_page(page, buffer) != 0) {
-            return -1;  // Validation failed
+        if (config_read_page(page, buffer) != 0 ||
+            config_validate_page(page, buffer) != 0) {
+            result = -1;  // Read or validation failed
+            break;
         }
     }
     
-    return 0;  // All pages valid
+    mem_pool_free(MEM_POOL_PAGE, buffer);
+    return result;
+}
+
+uint32_t config_serial_baud(uint8_t code) {
+    static const uint32_t bauds[] = { 9600, 19200, 38400, 57600, 115200, 230400 };
+
+    return (code < sizeof(bauds) / sizeof(bauds[0])) ? bauds[code] : 0;
 }
 
 int config_backup_all(void) {
@@ -38,6 +38,16 @@ extern "C" {
 #define CONFIG_PAGE_SIZE              1024  // 1KB per page
 #define CONFIG_TOTAL_PAGES           8     // Total pages available
 
+// config_engine_t.serial_speed codes (one byte in the settings page)
+#define CONFIG_SERIAL_9600             0
+#define CONFIG_SERIAL_19200            1
+#define CONFIG_SERIAL_38400            2
+#define CONFIG_SERIAL_57600            3
+#define CONFIG_SERIAL_115200           4
+#define CONFIG_SERIAL_230400           5
+
+#define CONFIG_VE_MAX                  2000  // VE cell limit (0.1 %)
+
 //=============================================================================
 // Configuration Data Structures
 //=============================================================================
@@ -85,7 +95,7 @@ typedef struct {
     uint16_t knock_limit;
     
     // TunerStudio Configuration
-    uint8_t serial_speed;
+    uint8_t serial_speed;               // CONFIG_SERIAL_* code
     uint8_t serial_enabled;
     uint8_t can_enabled;
     uint8_t wideband_enabled;
@@ -147,6 +157,9 @@ config_spark_table_t* config_get_spark_table(void);
 
 // Validation
 int config_validate_page(uint16_t page, const uint8_t* buffer);
+
+// Serial speed
+uint32_t config_serial_baud(uint8_t code);  // CONFIG_SERIAL_* code to baud (0 if unknown)
 int config_validate_all(void);
 
 // Backup and Restore
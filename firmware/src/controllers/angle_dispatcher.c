@@ -0,0 +1,601 @@
+/**
+ * @file angle_dispatcher.c
+ * @brief Angle-window injector/ignition dispatcher implementation
+ *
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "angle_dispatcher.h"
+#include "compiler_k64.h"
+#include <string.h>
+
+//=============================================================================
+// Private Helper Functions
+//=============================================================================
+
+/**
+ * @brief Round and normalize an angle to 0-719°
+ */
+static int16_t cycle_position(float angle)
+{
+    int32_t a = (int32_t)(angle + (angle >= 0.0f ? 0.5f : -0.5f)) % FULL_CYCLE_ANGLE;
+    if (a < 0) {
+        a += FULL_CYCLE_ANGLE;
+    }
+    return (int16_t)a;
+}
+
+/**
+ * @brief Insert event keeping the list sorted by position
+ */
+static void add_event(dispatch_list_t* list, int16_t position,
+                      uint8_t cylinder, dispatch_event_type_t type)
+{
+    if (list->num_events >= DISPATCH_MAX_EVENTS) {
+        return;
+    }
+
+    // Insertion sort (at most DISPATCH_MAX_EVENTS entries, once per cycle)
+    uint8_t i = list->num_events;
+    while (i > 0 && list->events[i - 1].position > position) {
+        list->events[i] = list->events[i - 1];
+        i--;
+    }
+
+    list->events[i].position = position;
+    list->events[i].cylinder = cylinder;
+    list->events[i].type = (uint8_t)type;
+    list->num_events++;
+}
+
+/**
+ * @brief Index of first event at or after position (num_events if none)
+ */
+static uint8_t lower_bound(const dispatch_list_t* list, int16_t position)
+{
+    for (uint8_t i = 0; i < list->num_events; i++) {
+        if (list->events[i].position >= position) {
+            return i;
+        }
+    }
+    return list->num_events;
+}
+
+static void build_injection_events(dispatch_list_t* list, ecu_state_t* ecu,
+                                   uint8_t num_cylinders)
+{
+    switch (list->mode) {
+        case INJECTION_MODE_SEQUENTIAL:
+            // One event per cylinder, 180° before its TDC
+            for (uint8_t cyl = 0; cyl < num_cylinders; cyl++) {
+                add_event(list, cycle_position(calculate_injection_timing(ecu, cyl)), cyl,
+                          DISPATCH_EVENT_INJECTION);
+            }
+            break;
+
+        case INJECTION_MODE_BATCH: {
+            if (ecu->fuel.num_batch_pairs == 0) {
+                init_batch_injection_pairs(ecu);
+            }
+            if (ecu->fuel.num_batch_pairs == 0) {
+                break;
+            }
+
+            // Each pair fires twice per cycle, 360° apart
+            float degrees_per_pair = 360.0f / ecu->fuel.num_batch_pairs;
+            for (uint8_t pair = 0; pair < ecu->fuel.num_batch_pairs; pair++) {
+                float angle = pair * degrees_per_pair;
+                for (uint8_t k = 0; k < 2; k++) {
+                    uint8_t cyl = ecu->fuel.batch_pairs[pair][k];
+                    add_event(list, cycle_position(angle), cyl, DISPATCH_EVENT_INJECTION);
+                    add_event(list, cycle_position(angle + 360.0f), cyl, DISPATCH_EVENT_INJECTION);
+                }
+            }
+            break;
+        }
+
+        case INJECTION_MODE_SIMULTANEOUS:
+            // All injectors together once per cycle at sync point
+            for (uint8_t cyl = 0; cyl < num_cylinders; cyl++) {
+                add_event(list, 0, cyl, DISPATCH_EVENT_INJECTION);
+            }
+            break;
+
+        case INJECTION_MODE_SINGLE_POINT:
+            add_event(list, 0, 0, DISPATCH_EVENT_INJECTION);
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void build_spark_events(angle_dispatcher_t* disp, dispatch_list_t* list,
+                               ecu_state_t* ecu, uint8_t num_cylinders)
+{
+    int16_t dwell_deg = (ecu->ignition.dwell_angle_deg < DISPATCH_MAX_LEAD_DEG) ?
+                        (int16_t)ecu->ignition.dwell_angle_deg : DISPATCH_MAX_LEAD_DEG;
+    int16_t correction = (disp->rev_limiter != NULL) ? -(int16_t)disp->rev_limiter->retard_deg : 0;
+    if (disp->idle != NULL) {
+        correction += idle_control_spark_correction(disp->idle, ecu->sensors.rpm);
+    }
+
+    // Spark at slot TDC (odd-fire offsets included) minus advance, relative
+    // to the cycle of that TDC: slot 0's spark stays in this list (before
+    // 0°) whatever the advance. Dwell start a precomputed angle before it.
+    for (uint8_t cyl = 0; cyl < num_cylinders; cyl++) {
+        int16_t advance = (int16_t)ecu->ignition.cylinder_timing_deg[cyl] + correction;
+        if (advance < 0) {
+            advance = 0;
+        } else if (advance > DISPATCH_MAX_LEAD_DEG) {
+            advance = DISPATCH_MAX_LEAD_DEG;
+        }
+        int16_t spark = cycle_position(engine_slot_tdc_angle(&ecu->config, cyl)) - advance;
+        if (disp->dwell_action != NULL) {
+            int16_t dwell = spark - dwell_deg;
+            if (dwell < -DISPATCH_MAX_LEAD_DEG) {
+                dwell = -DISPATCH_MAX_LEAD_DEG;
+            }
+            add_event(list, dwell, cyl, DISPATCH_EVENT_DWELL);
+        }
+        add_event(list, spark, cyl, DISPATCH_EVENT_SPARK);
+    }
+}
+
+/**
+ * @brief Build a sorted event list from current ECU configuration
+ *
+ * Main loop context: the list is not visible to the tooth ISR until it
+ * is published.
+ */
+static void build_list(angle_dispatcher_t* disp, dispatch_list_t* list,
+                       injection_mode_t mode)
+{
+    ecu_state_t* ecu = disp->ecu;
+    uint8_t num_cylinders = ecu->config.num_cylinders;
+    if (num_cylinders > ENGINE_MAX_CYLINDERS) {
+        num_cylinders = ENGINE_MAX_CYLINDERS;
+    }
+
+    list->num_events = 0;
+    list->mode = mode;
+    memset(list->squirts, 0, sizeof(list->squirts));
+
+    // Coil mode, then dwell lookup and duty limit for that mode
+    if (disp->ignition != NULL) {
+        ignition_coils_update(disp->ignition);
+    }
+    update_dwell(ecu, (disp->ignition != NULL) ?
+                      ignition_coils_period_deg(disp->ignition) : FULL_CYCLE_ANGLE);
+
+    if (num_cylinders > 0) {
+        build_injection_events(list, ecu, num_cylinders);
+        build_spark_events(disp, list, ecu, num_cylinders);
+    }
+
+    // Squirt count per cylinder, for the transition engine at cycle start
+    for (uint8_t i = 0; i < list->num_events; i++) {
+        const dispatch_event_t* ev = &list->events[i];
+        if (ev->type == DISPATCH_EVENT_INJECTION &&
+            ev->cylinder < INJ_TRANSITION_MAX_CYLINDERS) {
+            list->squirts[ev->cylinder]++;
+        }
+    }
+}
+
+/**
+ * @brief Buffer used by neither the current nor the next list
+ *
+ * next is read first: a cycle start in between only moves next into
+ * current, so the result is never the list the ISR runs.
+ */
+static uint8_t free_list(const angle_dispatcher_t* disp)
+{
+    uint8_t next = disp->next;
+    uint8_t current = disp->current;
+
+    for (uint8_t i = 0; i < DISPATCH_NUM_LISTS; i++) {
+        if (i != current && i != next) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Build the next cycle's list and hand it to the tooth ISR
+ */
+static void publish_list(angle_dispatcher_t* disp)
+{
+    // Rebuild an unconsumed list in place, else take a free buffer
+    uint8_t buf = __atomic_exchange_n(&disp->ready, DISPATCH_LIST_NONE, __ATOMIC_ACQUIRE);
+    if (buf == DISPATCH_LIST_NONE) {
+        buf = free_list(disp);
+    }
+
+    injection_mode_t mode = (disp->transition != NULL) ?
+                            injection_transition_next_mode(disp->transition, disp->ecu) :
+                            disp->ecu->fuel.injection_mode;
+    build_list(disp, &disp->lists[buf], mode);
+
+    __atomic_store_n(&disp->ready, buf, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Take a published list as the next cycle's list
+ */
+FAST_CODE static void take_ready(angle_dispatcher_t* disp)
+{
+    if (disp->next != DISPATCH_LIST_NONE) {
+        return;
+    }
+
+    uint8_t buf = __atomic_exchange_n(&disp->ready, DISPATCH_LIST_NONE, __ATOMIC_ACQUIRE);
+    if (buf != DISPATCH_LIST_NONE) {
+        disp->next = buf;
+        disp->next_index = 0;
+    }
+}
+
+/**
+ * @brief Run the current list again as the next cycle's list
+ *
+ * Used when the main loop has not built the next list by the time its
+ * head (events before its 0°) may need arming.
+ */
+FAST_CODE static void reuse_current(angle_dispatcher_t* disp)
+{
+    disp->next = disp->current;
+    disp->next_index = 0;
+    disp->list_overruns++;
+}
+
+/**
+ * @brief Arm one event through the angle scheduler
+ *
+ * @param angle Crank angle to fire at (0-719°)
+ */
+FAST_CODE static void arm_event(angle_dispatcher_t* disp, const dispatch_event_t* ev,
+                                uint16_t angle, uint32_t current_time_us)
+{
+    dispatch_action_t action;
+    switch (ev->type) {
+        case DISPATCH_EVENT_SPARK:
+            action = disp->spark_action;
+            break;
+        case DISPATCH_EVENT_DWELL:
+            action = disp->dwell_action;
+            break;
+        default:
+            action = disp->inject_action;
+            break;
+    }
+    if (action == NULL) {
+        return;
+    }
+
+    // With dwell events a spark only releases a coil its dwell charged
+    cylinder_mask_t slot_bit = CYLINDER_BIT(ev->cylinder);
+    if (ev->type == DISPATCH_EVENT_SPARK && disp->dwell_action != NULL) {
+        if ((disp->charged & slot_bit) == 0) {
+            return;
+        }
+        disp->charged &= (cylinder_mask_t)~slot_bit;
+    }
+
+    // Rev limiter cut pattern (one bit test). With dwell events the cut
+    // is decided at dwell start; the spark then only releases what charged.
+    if (disp->rev_limiter != NULL) {
+        bool allowed = true;
+        if (ev->type == DISPATCH_EVENT_INJECTION) {
+            allowed = rev_limiter_allow(disp->rev_limiter, REV_LIMIT_CUT_FUEL, ev->cylinder);
+        } else if (ev->type == DISPATCH_EVENT_DWELL || disp->dwell_action == NULL) {
+            allowed = rev_limiter_allow(disp->rev_limiter, REV_LIMIT_CUT_SPARK, ev->cylinder);
+        }
+        if (!allowed) {
+            return;
+        }
+    }
+
+    if (ev->type == DISPATCH_EVENT_INJECTION && disp->dfco != NULL &&
+        !dfco_allow(disp->dfco, ev->cylinder)) {
+        return;
+    }
+
+    // Pulse for the squirt, booked as delivered only once it is scheduled
+    if (ev->type == DISPATCH_EVENT_INJECTION && disp->transition != NULL &&
+        injection_transition_arm_squirt(disp->transition, disp->ecu, ev->cylinder) == 0) {
+        return;  // Nothing left to deliver for this cylinder
+    }
+
+    if (disp->ignition != NULL && ev->type != DISPATCH_EVENT_INJECTION) {
+        // Coils are chosen at dwell start; the spark releases the same coils
+        cylinder_mask_t mask;
+        if (ev->type == DISPATCH_EVENT_SPARK && disp->dwell_action != NULL) {
+            mask = ignition_coils_get_mask(disp->ignition, ev->cylinder);
+        } else {
+            mask = ignition_coils_arm(disp->ignition, ev->cylinder);
+        }
+        if (mask == 0) {
+            return;  // No coil mapped (or not charged) for this slot
+        }
+    }
+
+    if (scheduler_add_event(disp->sched, angle, ev->cylinder,
+                            action, current_time_us)) {
+        disp->events_armed++;
+        if (ev->type == DISPATCH_EVENT_DWELL) {
+            disp->charged |= slot_bit;
+        } else if (ev->type == DISPATCH_EVENT_INJECTION && disp->transition != NULL) {
+            injection_transition_commit_squirt(disp->transition, ev->cylinder);
+        }
+    } else {
+        disp->arm_failures++;
+    }
+}
+
+/**
+ * @brief Arm the events of one list that fall before the next tooth
+ *
+ * @param offset Start of the list's cycle relative to the current cycle
+ * @param angle Crank angle at this tooth (0-719°)
+ * @param span_deg Angle until the next tooth
+ */
+FAST_CODE static void arm_list(angle_dispatcher_t* disp, const dispatch_list_t* list,
+                               uint8_t* index, int16_t offset, int16_t angle,
+                               int16_t span_deg, uint32_t current_time_us)
+{
+    while (*index < list->num_events) {
+        const dispatch_event_t* ev = &list->events[*index];
+        int16_t position = ev->position + offset;
+
+        if (position >= angle + span_deg) {
+            break;  // Next event is beyond this tooth
+        }
+
+        if (position < angle) {
+            // Already passed - arming it would fire it a cycle late. A coil
+            // left charging is fired now instead.
+            disp->events_late++;
+            if (ev->type == DISPATCH_EVENT_SPARK &&
+                (disp->charged & CYLINDER_BIT(ev->cylinder))) {
+                arm_event(disp, ev, (uint16_t)angle, current_time_us);
+            }
+        } else {
+            arm_event(disp, ev, (uint16_t)(position % FULL_CYCLE_ANGLE), current_time_us);
+        }
+
+        (*index)++;
+    }
+}
+
+/**
+ * @brief Cycle start (0°): the next list becomes current
+ *
+ * Mode changes take effect here, so no cylinder is fuelled from both the
+ * old and the new list. The next list's build is requested from the main
+ * loop.
+ */
+FAST_CODE static void cycle_start(angle_dispatcher_t* disp, int16_t angle,
+                                  uint32_t current_time_us)
+{
+    // Whatever the finished cycle did not arm was passed
+    arm_list(disp, &disp->lists[disp->current], &disp->current_index,
+             -FULL_CYCLE_ANGLE, angle, 0, current_time_us);
+
+    take_ready(disp);
+    if (disp->next == DISPATCH_LIST_NONE) {
+        reuse_current(disp);
+    }
+
+    disp->current = disp->next;
+    disp->current_index = disp->next_index;
+    disp->next = DISPATCH_LIST_NONE;
+    disp->next_index = 0;
+    disp->build_request = true;
+    disp->cycles++;
+
+    const dispatch_list_t* list = &disp->lists[disp->current];
+    if (disp->transition != NULL) {
+        injection_transition_end_cycle(disp->transition, disp->ecu, list->mode);
+        injection_transition_begin_cycle(disp->transition, disp->ecu, list->squirts);
+    }
+    if (disp->rev_limiter != NULL) {
+        rev_limiter_begin_cycle(disp->rev_limiter);
+    }
+    if (disp->dfco != NULL) {
+        dfco_begin_cycle(disp->dfco);
+    }
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+void dispatcher_init(angle_dispatcher_t* disp,
+                     ecu_state_t* ecu,
+                     event_scheduler_t* sched,
+                     dispatch_action_t inject_action,
+                     dispatch_action_t spark_action)
+{
+    if (disp == NULL) {
+        return;
+    }
+
+    memset(disp, 0, sizeof(angle_dispatcher_t));
+    disp->ecu = ecu;
+    disp->sched = sched;
+    disp->inject_action = inject_action;
+    disp->spark_action = spark_action;
+    disp->current = 0;
+    disp->next = DISPATCH_LIST_NONE;
+    disp->ready = DISPATCH_LIST_NONE;
+
+    dispatcher_rebuild(disp);
+}
+
+void dispatcher_update(angle_dispatcher_t* disp)
+{
+    if (disp == NULL || disp->ecu == NULL) {
+        return;
+    }
+
+    if (__atomic_exchange_n(&disp->build_request, false, __ATOMIC_ACQ_REL)) {
+        publish_list(disp);
+    }
+}
+
+void dispatcher_rebuild(angle_dispatcher_t* disp)
+{
+    if (disp == NULL || disp->ecu == NULL) {
+        return;
+    }
+
+    if (!disp->synced) {
+        // Tooth ISR not using the lists yet
+        disp->next = DISPATCH_LIST_NONE;
+        disp->ready = DISPATCH_LIST_NONE;
+        build_list(disp, &disp->lists[disp->current], disp->ecu->fuel.injection_mode);
+        disp->build_request = true;
+        return;
+    }
+
+    disp->build_request = false;
+    publish_list(disp);
+}
+
+void dispatcher_set_transition(angle_dispatcher_t* disp, injection_transition_t* transition)
+{
+    if (disp == NULL) {
+        return;
+    }
+
+    disp->transition = transition;
+    if (transition != NULL && disp->ecu != NULL) {
+        disp->ecu->fuel.injection_mode = transition->active_mode;
+        dispatcher_rebuild(disp);
+    }
+}
+
+void dispatcher_set_dwell_action(angle_dispatcher_t* disp, dispatch_action_t dwell_action)
+{
+    if (disp == NULL) {
+        return;
+    }
+
+    disp->dwell_action = dwell_action;
+    dispatcher_rebuild(disp);
+}
+
+void dispatcher_set_ignition(angle_dispatcher_t* disp, ignition_coils_t* ignition)
+{
+    if (disp == NULL) {
+        return;
+    }
+
+    disp->ignition = ignition;
+}
+
+void dispatcher_set_rev_limiter(angle_dispatcher_t* disp, rev_limiter_t* rev_limiter)
+{
+    if (disp == NULL) {
+        return;
+    }
+
+    disp->rev_limiter = rev_limiter;
+}
+
+void dispatcher_set_dfco(angle_dispatcher_t* disp, dfco_t* dfco)
+{
+    if (disp == NULL) {
+        return;
+    }
+
+    disp->dfco = dfco;
+}
+
+void dispatcher_set_idle(angle_dispatcher_t* disp, idle_control_t* idle)
+{
+    if (disp == NULL) {
+        return;
+    }
+
+    disp->idle = idle;
+}
+
+FAST_CODE void dispatcher_on_tooth(angle_dispatcher_t* disp,
+                                   uint16_t angle,
+                                   uint16_t span_deg,
+                                   uint32_t current_time_us)
+{
+    if (disp == NULL || disp->sched == NULL) {
+        return;
+    }
+
+    angle %= FULL_CYCLE_ANGLE;
+    if (span_deg >= FULL_CYCLE_ANGLE) {
+        span_deg = FULL_CYCLE_ANGLE - 1;
+    }
+
+    if (disp->rev_limiter != NULL && disp->ecu != NULL) {
+        rev_limiter_update(disp->rev_limiter, disp->ecu->sensors.rpm,
+                           disp->ecu->sensors.tps_percent);
+    }
+
+    if (!disp->synced) {
+        // Start mid-cycle: events already behind are not late
+        take_ready(disp);
+        disp->synced = true;
+        disp->charged = 0;
+        disp->current_index = lower_bound(&disp->lists[disp->current], (int16_t)angle);
+        if (disp->next != DISPATCH_LIST_NONE) {
+            disp->next_index = lower_bound(&disp->lists[disp->next],
+                                           (int16_t)angle - FULL_CYCLE_ANGLE);
+        }
+        if (disp->transition != NULL) {
+            injection_transition_reset(disp->transition);
+            injection_transition_begin_cycle(disp->transition, disp->ecu,
+                                             disp->lists[disp->current].squirts);
+        }
+    } else if (angle < disp->last_angle &&
+               disp->last_angle - angle > FULL_CYCLE_ANGLE / 2) {
+        // Crossed 0° (small backward jitter is not a new cycle)
+        cycle_start(disp, (int16_t)angle, current_time_us);
+    } else {
+        take_ready(disp);
+        if (disp->next == DISPATCH_LIST_NONE &&
+            angle + span_deg >= FULL_CYCLE_ANGLE - DISPATCH_MAX_LEAD_DEG) {
+            // Main loop did not build in time: run this list again
+            reuse_current(disp);
+        }
+    }
+    disp->last_angle = angle;
+
+    // Current cycle, then the head of the next one (events before its 0°)
+    arm_list(disp, &disp->lists[disp->current], &disp->current_index,
+             0, (int16_t)angle, (int16_t)span_deg, current_time_us);
+    if (disp->next != DISPATCH_LIST_NONE) {
+        arm_list(disp, &disp->lists[disp->next], &disp->next_index,
+                 FULL_CYCLE_ANGLE, (int16_t)angle, (int16_t)span_deg, current_time_us);
+    }
+}
+
+void dispatcher_reset(angle_dispatcher_t* disp)
+{
+    if (disp == NULL) {
+        return;
+    }
+
+    disp->synced = false;
+    disp->charged = 0;
+    disp->current_index = 0;
+    disp->next_index = 0;
+
+    if (disp->transition != NULL) {
+        injection_transition_reset(disp->transition);
+    }
+}
@@ -0,0 +1,309 @@
+/**
+ * @file angle_dispatcher.h
+ * @brief Angle-window injector/ignition dispatcher for Teensy 3.5
+ *
+ * Replaces polling get_injectors_to_fire() with an event-driven model:
+ *
+ * 1. Once per engine cycle the main loop (dispatcher_update()) builds a
+ *    sorted list of per-cylinder event angles for the active
+ *    injection_mode_t, plus one spark event per cylinder. The build is
+ *    requested at a fixed angle (the cycle start, 0°) and its list is
+ *    used for the following cycle, so no table math runs in the tooth ISR.
+ * 2. On every crank tooth it only checks whether the next event of the
+ *    current and of the following list falls before the next tooth. If
+ *    so, the event is armed exactly once through the angle scheduler
+ *    (hardware timer), and the index advances.
+ *
+ * Event positions are unwrapped degrees from the start of the cycle the
+ * list belongs to. A spark belongs to the cycle of its slot TDC, so with
+ * advance it may lie before the cycle start (down to
+ * -DISPATCH_MAX_LEAD_DEG), and its dwell start further still. The head of
+ * the next list is therefore armed while the current list is running,
+ * and a spark never moves between lists when the advance crosses 0°.
+ * Each dwell is paired with the spark of the same slot: a spark is only
+ * armed after its dwell was, and a charged coil whose spark was passed
+ * is fired at the next tooth.
+ *
+ * Events cannot be skipped at high RPM or double-fired at low RPM because
+ * arming depends on tooth windows, not on how often the code is polled.
+ *
+ * With an injection_transition_t attached, injection mode changes and
+ * per-cylinder pulse splitting are handled at the cycle start (see
+ * injection_transition.h). With an ignition_coils_t attached, each spark
+ * event is mapped to coil outputs for the active coil mode (see
+ * ignition_coils.h). With a rev_limiter_t attached, cut patterns are
+ * applied as events are armed and limiter retard is applied to the spark
+ * angles of the next list (see rev_limiter.h). With a dfco_t attached,
+ * injections are cut during decel fuel cut-off and re-enabled a few
+ * cylinders per cycle (see dfco.h). With an idle_control_t attached, the
+ * idle spark correction is added to the spark angles of each new list
+ * (see idle_control.h).
+ *
+ * @version 1.2.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef ANGLE_DISPATCHER_H
+#define ANGLE_DISPATCHER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "engine_control.h"
+#include "event_scheduler.h"
+#include "injection_transition.h"
+#include "ignition_coils.h"
+#include "rev_limiter.h"
+#include "dfco.h"
+#include "idle_control.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Maximum events per engine cycle
+ *
+ * Worst case: batch injection (2 firings per injector) + one dwell start
+ * and one spark per cylinder, at ENGINE_MAX_CYLINDERS.
+ */
+#define DISPATCH_MAX_EVENTS   ENGINE_MAX_CYCLE_EVENTS
+
+/**
+ * @brief Furthest a dwell start or spark may lead its slot TDC (degrees)
+ *
+ * Also the latest point in a cycle by which the next list must have been
+ * built. Advance and dwell angle are clamped to this lead.
+ */
+#define DISPATCH_MAX_LEAD_DEG 360
+
+/**
+ * @brief Event list buffers: current cycle, next cycle, being built
+ */
+#define DISPATCH_NUM_LISTS    3
+
+/**
+ * @brief No list (dispatch_list_t index)
+ */
+#define DISPATCH_LIST_NONE    0xFF
+
+/**
+ * @brief Dispatched event type
+ */
+typedef enum {
+    DISPATCH_EVENT_INJECTION = 0,     ///< Injector open
+    DISPATCH_EVENT_SPARK = 1,         ///< Spark (coil fire)
+    DISPATCH_EVENT_DWELL = 2          ///< Dwell start (coil charge)
+} dispatch_event_type_t;
+
+/**
+ * @brief Single event in the per-cycle angle list
+ */
+typedef struct {
+    int16_t position;                 ///< Degrees from the list's cycle start
+                                      ///< (-DISPATCH_MAX_LEAD_DEG to 719)
+    uint8_t cylinder;                 ///< Cylinder number (0-based)
+    uint8_t type;                     ///< dispatch_event_type_t
+} dispatch_event_t;
+
+/**
+ * @brief Event list of one engine cycle, sorted by position
+ */
+typedef struct {
+    dispatch_event_t events[DISPATCH_MAX_EVENTS];
+    uint8_t num_events;               ///< Events in list
+    injection_mode_t mode;            ///< Injection mode the list was built for
+    uint8_t squirts[INJ_TRANSITION_MAX_CYLINDERS];  ///< Injection events per cylinder
+} dispatch_list_t;
+
+/**
+ * @brief Event action callback (cylinder number)
+ */
+typedef void (*dispatch_action_t)(uint8_t cylinder);
+
+/**
+ * @brief Angle dispatcher state
+ */
+typedef struct {
+    // Event lists. The tooth ISR reads current and next; the main loop
+    // builds into the third buffer and publishes it through ready.
+    dispatch_list_t lists[DISPATCH_NUM_LISTS];
+    volatile uint8_t current;         ///< List of the running cycle
+    volatile uint8_t next;            ///< List of the following cycle (or NONE)
+    volatile uint8_t ready;           ///< Built, not yet taken as next (or NONE)
+    volatile bool build_request;      ///< Set at the cycle start, cleared by the build
+    uint8_t current_index;            ///< Next event to arm in the current list
+    uint8_t next_index;               ///< Next event to arm in the next list
+
+    // Tooth window tracking
+    uint16_t last_angle;              ///< Angle of the previous tooth (0-719°)
+    bool synced;                      ///< Window tracking initialized
+    cylinder_mask_t charged;          ///< Slots whose dwell is armed, spark not yet
+
+    // Configuration
+    ecu_state_t* ecu;                 ///< ECU state (mode, timing)
+    event_scheduler_t* sched;         ///< Angle scheduler used for arming
+    dispatch_action_t inject_action;  ///< Called when an injection event fires
+    dispatch_action_t spark_action;   ///< Called when a spark event fires
+    dispatch_action_t dwell_action;   ///< Called at dwell start (NULL = no dwell events)
+    injection_transition_t* transition;  ///< Mode transition engine (may be NULL)
+    ignition_coils_t* ignition;       ///< Coil mode mapping (may be NULL)
+    rev_limiter_t* rev_limiter;       ///< Rev/launch limiter (may be NULL)
+    dfco_t* dfco;                     ///< Decel fuel cut-off (may be NULL)
+    idle_control_t* idle;             ///< Idle spark correction (may be NULL)
+
+    // Statistics
+    uint32_t events_armed;            ///< Events handed to the scheduler
+    uint32_t events_late;             ///< Events passed before they could be armed
+    uint32_t arm_failures;            ///< Scheduler queue full
+    uint32_t cycles;                  ///< Cycle boundaries passed
+    uint32_t list_overruns;           ///< No new list by its deadline (previous reused)
+} angle_dispatcher_t;
+
+/**
+ * @brief Initialize dispatcher and build the first event list
+ *
+ * @param disp Dispatcher state
+ * @param ecu ECU state (injection mode, cylinder count, spark timing)
+ * @param sched Angle scheduler used to arm events
+ * @param inject_action Callback for injection events (may be NULL)
+ * @param spark_action Callback for spark events (may be NULL)
+ */
+void dispatcher_init(angle_dispatcher_t* disp,
+                     ecu_state_t* ecu,
+                     event_scheduler_t* sched,
+                     dispatch_action_t inject_action,
+                     dispatch_action_t spark_action);
+
+/**
+ * @brief Build the next cycle's event list when one is due
+ *
+ * Call from the main loop. The tooth ISR requests a build at every cycle
+ * start; the list must be ready before the current cycle reaches
+ * 720 - DISPATCH_MAX_LEAD_DEG, otherwise the current list is run again
+ * for the next cycle (counted in list_overruns) and the new one is taken
+ * a cycle later.
+ *
+ * Dwell lookup, spark correction and the coil mode for the cycle are
+ * evaluated here.
+ *
+ * @param disp Dispatcher state
+ */
+void dispatcher_update(angle_dispatcher_t* disp);
+
+/**
+ * @brief Rebuild the event list from current ECU configuration
+ *
+ * Before sync the current list is replaced. Once running, the new list
+ * takes effect at the next cycle whose events have not started arming.
+ * Call from the main loop after a configuration change. Injection mode
+ * changes should go through injection_transition_request() instead.
+ *
+ * @param disp Dispatcher state
+ */
+void dispatcher_rebuild(angle_dispatcher_t* disp);
+
+/**
+ * @brief Attach an injection mode transition engine
+ *
+ * The transition engine then owns ecu->fuel.injection_mode and supplies
+ * the pulse width of each armed injection (injection_transition_get_pulse()
+ * from the injection action).
+ *
+ * @param disp Dispatcher state
+ * @param transition Transition engine (NULL to detach)
+ */
+void dispatcher_set_transition(angle_dispatcher_t* disp, injection_transition_t* transition);
+
+/**
+ * @brief Set the dwell start action
+ *
+ * With a dwell action, one dwell event per spark is added at
+ * spark angle - ignition.dwell_angle_deg. Dwell is looked up and duty
+ * limited once per list build (update_dwell()), so the spark angle never
+ * moves to make room for the charge. The spark is only armed if its
+ * dwell was.
+ *
+ * @param disp Dispatcher state
+ * @param dwell_action Callback for dwell start events (NULL to disable)
+ */
+void dispatcher_set_dwell_action(angle_dispatcher_t* disp, dispatch_action_t dwell_action);
+
+/**
+ * @brief Attach ignition coil mapping
+ *
+ * The coil mode is re-evaluated at each list build; the spark action
+ * takes the coils to fire with ignition_coils_release().
+ *
+ * @param disp Dispatcher state
+ * @param ignition Coil state (NULL to detach)
+ */
+void dispatcher_set_ignition(angle_dispatcher_t* disp, ignition_coils_t* ignition);
+
+/**
+ * @brief Attach rev limiter / launch control
+ *
+ * The limiter is updated on every tooth from ecu->sensors.rpm and
+ * tps_percent, and its cut pattern rotates once per cycle.
+ *
+ * @param disp Dispatcher state
+ * @param rev_limiter Rev limiter (NULL to detach)
+ */
+void dispatcher_set_rev_limiter(angle_dispatcher_t* disp, rev_limiter_t* rev_limiter);
+
+/**
+ * @brief Attach decel fuel cut-off
+ *
+ * Conditions are evaluated by dfco_update() in the control loop; the
+ * dispatcher only applies the cut mask and advances re-entry per cycle.
+ *
+ * @param disp Dispatcher state
+ * @param dfco DFCO state (NULL to detach)
+ */
+void dispatcher_set_dfco(angle_dispatcher_t* disp, dfco_t* dfco);
+
+/**
+ * @brief Attach idle control for spark correction
+ *
+ * The correction is taken from ecu->sensors.rpm once per cycle, when
+ * the next spark angles are built.
+ *
+ * @param disp Dispatcher state
+ * @param idle Idle state (NULL to detach)
+ */
+void dispatcher_set_idle(angle_dispatcher_t* disp, idle_control_t* idle);
+
+/**
+ * @brief Arm events that fall before the next tooth
+ *
+ * Call from the crank tooth handler after scheduler_update_angle().
+ * Typical cost is a single comparison against the next event.
+ *
+ * @param disp Dispatcher state
+ * @param angle Crank angle at this tooth (0-719°)
+ * @param span_deg Angle until the next expected tooth (covers the gap
+ *                 at missing teeth)
+ * @param current_time_us Current timestamp in microseconds
+ */
+void dispatcher_on_tooth(angle_dispatcher_t* disp,
+                         uint16_t angle,
+                         uint16_t span_deg,
+                         uint32_t current_time_us);
+
+/**
+ * @brief Drop window tracking after loss of sync
+ *
+ * Armed events are left to the caller (scheduler_clear_events()), which
+ * must also turn off any charging coil.
+ *
+ * @param disp Dispatcher state
+ */
+void dispatcher_reset(angle_dispatcher_t* disp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ANGLE_DISPATCHER_H
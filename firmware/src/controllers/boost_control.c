@@ -0,0 +1,276 @@
+/**
+ * @file boost_control.c
+ * @brief Closed-loop wastegate boost control implementation
+ *
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "boost_control.h"
+#include "compiler_k64.h"
+#include <string.h>
+
+#define BOOST_PI    3.14159265f
+
+//=============================================================================
+// Private Helper Functions
+//=============================================================================
+
+static float clampf(float x, float lo, float hi)
+{
+    return (x < lo) ? lo : (x > hi) ? hi : x;
+}
+
+/**
+ * @brief Axis cell and fraction (clamped at the table edges)
+ */
+static uint8_t axis_cell(const float* bins, uint8_t size, float x, float* frac)
+{
+    if (x <= bins[0]) {
+        *frac = 0.0f;
+        return 0;
+    }
+    if (x >= bins[size - 1]) {
+        *frac = 1.0f;
+        return (uint8_t)(size - 2);
+    }
+
+    uint8_t i = 0;
+    while (i < size - 2 && x >= bins[i + 1]) {
+        i++;
+    }
+    *frac = (x - bins[i]) / (bins[i + 1] - bins[i]);
+    return i;
+}
+
+static float table_2d(const float table[BOOST_TABLE_SIZE][BOOST_TABLE_SIZE],
+                      uint8_t t, float tf, uint8_t r, float rf)
+{
+    float v0 = table[t][r] + (table[t][r + 1] - table[t][r]) * rf;
+    float v1 = table[t + 1][r] + (table[t + 1][r + 1] - table[t + 1][r]) * rf;
+    return v0 + (v1 - v0) * tf;
+}
+
+static float gain(const float* gains, uint8_t cell, float frac)
+{
+    return gains[cell] + (gains[cell + 1] - gains[cell]) * frac;
+}
+
+static void set_output(boost_control_t* bc)
+{
+    uint16_t ticks = pwm_duty_ticks(bc->config.pwm_ftm, (uint16_t)(bc->duty_pct * 100.0f));
+    if (bc->pwm_batch != NULL) {
+        pwm_batch_set(bc->pwm_batch, bc->config.pwm_ftm, bc->config.pwm_channel, ticks);
+    } else {
+        pwm_set_duty_value(bc->config.pwm_ftm, bc->config.pwm_channel, ticks);
+    }
+}
+
+static void set_overboost(boost_control_t* bc, bool active)
+{
+    if (bc->overboost == active) {
+        return;
+    }
+
+    bc->overboost = active;
+    if (active) {
+        bc->overboost_events++;
+    }
+    if (bc->rev_limiter != NULL) {
+        rev_limiter_set_overboost(bc->rev_limiter, active);
+    }
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+bool boost_control_init(boost_control_t* bc, rev_limiter_t* rev_limiter)
+{
+    if (bc == NULL) {
+        return false;
+    }
+
+    memset(bc, 0, sizeof(boost_control_t));
+    bc->rev_limiter = rev_limiter;
+    bc->map_kpa = 100.0f;
+
+    boost_config_t* cfg = &bc->config;
+    cfg->enabled = false;
+
+    // Target ramps in with throttle and RPM: 100 kPa (no boost) at closed
+    // throttle, up to 200 kPa at WOT above 4000 RPM
+    float rpms[] = {1000.0f, 2000.0f, 2500.0f, 3000.0f, 3500.0f, 4000.0f, 5500.0f, 7000.0f};
+    float boost_rpm[] = {0.0f, 0.0f, 0.3f, 0.6f, 0.85f, 1.0f, 1.0f, 1.0f};
+    for (uint8_t i = 0; i < BOOST_TABLE_SIZE; i++) {
+        cfg->rpm_bins[i] = rpms[i];
+        cfg->tps_bins[i] = (float)i * 100.0f / (BOOST_TABLE_SIZE - 1);
+    }
+    for (uint8_t t = 0; t < BOOST_TABLE_SIZE; t++) {
+        float tps_frac = cfg->tps_bins[t] / 100.0f;
+        for (uint8_t r = 0; r < BOOST_TABLE_SIZE; r++) {
+            cfg->target_kpa[t][r] = 100.0f + 100.0f * tps_frac * boost_rpm[r];
+            cfg->duty_pct[t][r] = 50.0f * tps_frac * boost_rpm[r];
+        }
+    }
+
+    float gain_rpms[] = {2000.0f, 3500.0f, 5000.0f, 6500.0f};
+    float kps[] = {0.8f, 0.6f, 0.5f, 0.5f};
+    float kis[] = {1.0f, 0.8f, 0.6f, 0.6f};
+    float kds[] = {0.02f, 0.02f, 0.01f, 0.01f};
+    memcpy(cfg->gain_rpm, gain_rpms, sizeof(gain_rpms));
+    memcpy(cfg->kp, kps, sizeof(kps));
+    memcpy(cfg->ki, kis, sizeof(kis));
+    memcpy(cfg->kd, kds, sizeof(kds));
+    cfg->i_limit_pct = 20.0f;
+
+    cfg->closed_loop_window_kpa = 20.0f;
+    cfg->duty_min_pct = 0.0f;
+    cfg->duty_max_pct = 95.0f;
+
+    cfg->overboost_margin_kpa = 30.0f;
+    cfg->overboost_max_kpa = 250.0f;
+    cfg->overboost_time_ms = 100;
+
+    cfg->sample_hz = 1000;
+    cfg->filter_hz = 50.0f;
+
+    cfg->pwm_ftm = PWM_FTM3;          // PIN_BOOST_CONTROL (FTM0 CH4 is crank capture)
+    cfg->pwm_channel = PWM_CHANNEL_1;
+
+    boost_control_set_filter(bc);
+
+    return true;
+}
+
+void boost_control_set_pwm_batch(boost_control_t* bc, pwm_batch_t* batch)
+{
+    if (bc == NULL) {
+        return;
+    }
+
+    bc->pwm_batch = batch;
+}
+
+void boost_control_set_filter(boost_control_t* bc)
+{
+    if (bc == NULL || bc->config.sample_hz == 0 || bc->config.filter_hz <= 0.0f) {
+        return;
+    }
+
+    // First-order low-pass: alpha = dt / (RC + dt)
+    float dt = 1.0f / (float)bc->config.sample_hz;
+    float rc = 1.0f / (2.0f * BOOST_PI * bc->config.filter_hz);
+    bc->filter_alpha = dt / (rc + dt);
+}
+
+FAST_CODE void boost_control_map_sample(boost_control_t* bc, float map_kpa)
+{
+    if (bc == NULL) {
+        return;
+    }
+
+    bc->map_kpa += bc->filter_alpha * (map_kpa - bc->map_kpa);
+    bc->samples++;
+}
+
+void boost_control_update(boost_control_t* bc, const ecu_state_t* ecu, uint32_t now_ms)
+{
+    if (bc == NULL || ecu == NULL) {
+        return;
+    }
+
+    const boost_config_t* cfg = &bc->config;
+
+    if (!cfg->enabled || !ecu->sensors.engine_running) {
+        bc->duty_pct = 0.0f;
+        bc->integral = 0.0f;
+        bc->closed_loop = false;
+        bc->overboost_pending = false;
+        set_overboost(bc, false);
+        set_output(bc);
+        bc->last_ms = now_ms;
+        bc->last_samples = bc->samples;
+        return;
+    }
+
+    uint32_t dt_ms = now_ms - bc->last_ms;
+    float dt = (float)dt_ms / 1000.0f;
+    uint32_t samples = bc->samples;
+    uint32_t received = samples - bc->last_samples;
+    bc->last_ms = now_ms;
+    bc->last_samples = samples;
+
+    float map = bc->map_kpa;
+    float rpm = (float)ecu->sensors.rpm;
+
+    // Target and open-loop duty
+    float rf, tf, gf;
+    uint8_t r = axis_cell(cfg->rpm_bins, BOOST_TABLE_SIZE, rpm, &rf);
+    uint8_t t = axis_cell(cfg->tps_bins, BOOST_TABLE_SIZE, ecu->sensors.tps_percent, &tf);
+    float target = table_2d(cfg->target_kpa, t, tf, r, rf);
+    if (bc->gear > 0 && bc->gear <= BOOST_MAX_GEARS) {
+        float cap = cfg->gear_max_kpa[bc->gear - 1];
+        if (cap > 0.0f && target > cap) {
+            target = cap;
+        }
+    }
+    bc->target = target;
+    float duty = table_2d(cfg->duty_pct, t, tf, r, rf);
+
+    // Overboost protection
+    bool over = (map > target + cfg->overboost_margin_kpa) || (map > cfg->overboost_max_kpa);
+    if (over) {
+        if (!bc->overboost_pending) {
+            bc->overboost_pending = true;
+            bc->overboost_start_ms = now_ms;
+        } else if ((now_ms - bc->overboost_start_ms) >= cfg->overboost_time_ms) {
+            set_overboost(bc, true);
+        }
+    } else {
+        bc->overboost_pending = false;
+        if (bc->overboost && map < target) {
+            set_overboost(bc, false);
+        }
+    }
+
+    if (bc->overboost) {
+        bc->duty_pct = 0.0f;  // Wastegate fully open
+        bc->integral = 0.0f;
+        bc->closed_loop = false;
+        set_output(bc);
+        return;
+    }
+
+    // Closed loop only with a live fast MAP channel, near the target
+    uint32_t expected = (uint32_t)BOOST_MIN_SAMPLE_HZ * dt_ms / 1000U;
+    bool map_live = (received >= expected / 2U) && (dt_ms > 0);
+    if (!map_live) {
+        bc->stale_steps++;
+    }
+
+    bc->closed_loop = map_live && (map > target - cfg->closed_loop_window_kpa);
+
+    if (bc->closed_loop) {
+        uint8_t g = axis_cell(cfg->gain_rpm, BOOST_GAIN_BINS, rpm, &gf);
+        float kp = gain(cfg->kp, g, gf);
+        float ki = gain(cfg->ki, g, gf);
+        float kd = gain(cfg->kd, g, gf);
+
+        float error = target - map;
+        bc->integral = clampf(bc->integral + ki * error * dt,
+                              -cfg->i_limit_pct, cfg->i_limit_pct);
+        float rate = (map - bc->prev_map) / dt;
+
+        duty += kp * error + bc->integral - kd * rate;
+    } else {
+        bc->integral = 0.0f;  // Spooling: no wind-up
+    }
+    bc->prev_map = map;
+
+    bc->duty_pct = clampf(duty, cfg->duty_min_pct, cfg->duty_max_pct);
+    set_output(bc);
+}
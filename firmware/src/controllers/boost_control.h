@@ -0,0 +1,176 @@
+/**
+ * @file boost_control.h
+ * @brief Closed-loop wastegate boost control with overboost protection
+ *
+ * Wastegate solenoid duty (pwm_k64) is built from:
+ * - Target boost (absolute kPa) from an RPM x TPS table, optionally
+ *   capped per gear
+ * - Open-loop duty from an RPM x TPS table
+ * - PID on the boost error once MAP is within closed_loop_window_kpa of
+ *   the target (below that the turbo is spooling and the integral is
+ *   held at zero). Gains are scheduled over RPM.
+ *
+ * MAP feedback: the main loop MAP reading is too slow and too noisy for
+ * boost, so the board feeds a fast channel through boost_control_map_sample()
+ * from a PIT interrupt at >= BOOST_MIN_SAMPLE_HZ. Each sample is one
+ * first-order IIR step. If fewer samples than expected arrive between two
+ * control steps, the loop falls back to open-loop duty.
+ *
+ * Overboost: MAP above target + overboost_margin_kpa, or above
+ * overboost_max_kpa, for overboost_time_ms opens the wastegate (duty 0)
+ * and requests a full fuel cut through the rev limiter
+ * (rev_limiter_set_overboost()). Released once MAP falls below the target.
+ *
+ * Every step uses fixed-size tables and no loops over unbounded data, so
+ * boost_control_update() has a bounded, constant cost.
+ *
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef BOOST_CONTROL_H
+#define BOOST_CONTROL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "engine_control.h"
+#include "rev_limiter.h"
+#include "pwm_k64.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BOOST_TABLE_SIZE      8
+#define BOOST_GAIN_BINS       4
+#define BOOST_MAX_GEARS       6
+#define BOOST_MIN_SAMPLE_HZ   500
+
+/**
+ * @brief Boost configuration
+ */
+typedef struct {
+    bool enabled;
+
+    float rpm_bins[BOOST_TABLE_SIZE];
+    float tps_bins[BOOST_TABLE_SIZE];
+    float target_kpa[BOOST_TABLE_SIZE][BOOST_TABLE_SIZE];   ///< [tps][rpm], absolute
+    float duty_pct[BOOST_TABLE_SIZE][BOOST_TABLE_SIZE];     ///< [tps][rpm], open loop
+    float gear_max_kpa[BOOST_MAX_GEARS];                    ///< Target cap per gear (0 = none)
+
+    // Gain schedule over RPM
+    float gain_rpm[BOOST_GAIN_BINS];
+    float kp[BOOST_GAIN_BINS];        ///< % duty per kPa
+    float ki[BOOST_GAIN_BINS];        ///< % duty per kPa·s
+    float kd[BOOST_GAIN_BINS];        ///< % duty per kPa/s (on measurement)
+    float i_limit_pct;
+
+    float closed_loop_window_kpa;     ///< Closed loop within this of target
+    float duty_min_pct;
+    float duty_max_pct;
+
+    // Overboost
+    float overboost_margin_kpa;       ///< Above target
+    float overboost_max_kpa;          ///< Absolute limit
+    uint16_t overboost_time_ms;
+
+    // MAP channel
+    uint16_t sample_hz;               ///< boost_control_map_sample() rate
+    float filter_hz;                  ///< IIR cutoff
+
+    // Output
+    pwm_ftm_t pwm_ftm;
+    pwm_channel_t pwm_channel;
+} boost_config_t;
+
+/**
+ * @brief Boost control state
+ */
+typedef struct {
+    boost_config_t config;
+    rev_limiter_t* rev_limiter;       ///< Overboost cut (may be NULL)
+    pwm_batch_t* pwm_batch;           ///< Stage duty here (NULL = write at once)
+
+    // Fast MAP channel (written from the sampling interrupt)
+    volatile float map_kpa;           ///< Filtered MAP
+    volatile uint32_t samples;        ///< Samples received
+    float filter_alpha;               ///< IIR coefficient (from sample/filter Hz)
+
+    // Inputs
+    uint8_t gear;                     ///< Current gear (0 = unknown)
+
+    // Outputs
+    float target;                     ///< Target MAP (kPa)
+    float duty_pct;                   ///< Commanded wastegate duty
+    bool closed_loop;
+    bool overboost;
+
+    // PID
+    float integral;
+    float prev_map;
+    uint32_t last_ms;
+    uint32_t last_samples;
+    uint32_t overboost_start_ms;
+    bool overboost_pending;
+
+    // Statistics
+    uint32_t overboost_events;
+    uint32_t stale_steps;             ///< Steps run open loop (MAP channel slow)
+} boost_control_t;
+
+/**
+ * @brief Initialize with defaults (disabled)
+ *
+ * The FTM channel must already be set up with pwm_init() and
+ * pwm_channel_init(). The default output is FTM3 CH1 (PIN_BOOST_CONTROL).
+ *
+ * @param bc Boost state
+ * @param rev_limiter Rev limiter for the overboost cut (may be NULL)
+ * @return true on success
+ */
+bool boost_control_init(boost_control_t* bc, rev_limiter_t* rev_limiter);
+
+/**
+ * @brief Recompute the MAP filter coefficient after changing
+ *        sample_hz or filter_hz
+ *
+ * @param bc Boost state
+ */
+void boost_control_set_filter(boost_control_t* bc);
+
+/**
+ * @brief Stage the wastegate duty in a PWM batch
+ *
+ * The control loop then latches all its outputs together with
+ * pwm_batch_commit() after the update functions have run.
+ *
+ * @param bc Boost state
+ * @param batch PWM batch (NULL = write the duty immediately)
+ */
+void boost_control_set_pwm_batch(boost_control_t* bc, pwm_batch_t* batch);
+
+/**
+ * @brief Feed one fast MAP sample (>= BOOST_MIN_SAMPLE_HZ, ISR context)
+ *
+ * @param bc Boost state
+ * @param map_kpa MAP from the fast channel (convert_map_voltage())
+ */
+void boost_control_map_sample(boost_control_t* bc, float map_kpa);
+
+/**
+ * @brief Run one control step and update the wastegate output
+ *
+ * @param bc Boost state
+ * @param ecu ECU state (rpm, tps_percent)
+ * @param now_ms Current time (ms)
+ */
+void boost_control_update(boost_control_t* bc, const ecu_state_t* ecu, uint32_t now_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOOST_CONTROL_H
@@ -0,0 +1,207 @@
+/**
+ * @file dfco.c
+ * @brief Deceleration fuel cut-off implementation
+ *
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "dfco.h"
+#include "compiler_k64.h"
+#include <string.h>
+
+//=============================================================================
+// Private Helper Functions
+//=============================================================================
+
+/**
+ * @brief Build enable masks: k cylinders spread evenly over the firing order
+ */
+static void build_enable_masks(dfco_t* dfco)
+{
+    uint8_t n = dfco->num_cylinders;
+
+    dfco->enable_mask[0] = 0;
+    for (uint8_t k = 1; k <= n; k++) {
+        cylinder_mask_t mask = 0;
+        for (uint8_t i = 0; i < k; i++) {
+            mask |= CYLINDER_BIT((uint16_t)i * n / k);
+        }
+        dfco->enable_mask[k] = mask;
+    }
+}
+
+/**
+ * @brief Recompute the cut mask, rotating the pattern on every entry
+ */
+static void refresh_cut_mask(dfco_t* dfco)
+{
+    uint8_t n = dfco->num_cylinders;
+    cylinder_mask_t all = CYLINDER_MASK_ALL(n);
+
+    if (dfco->state != DFCO_STATE_ACTIVE && dfco->state != DFCO_STATE_REENTRY) {
+        dfco->cut_mask = 0;
+        return;
+    }
+
+    uint8_t r = (uint8_t)(dfco->entries % n);
+    cylinder_mask_t mask = dfco->enable_mask[dfco->enabled_count];
+    if (r != 0) {
+        mask = (cylinder_mask_t)(((mask << r) | (mask >> (n - r))) & all);
+    }
+    dfco->cut_mask = (cylinder_mask_t)(all & ~mask);
+}
+
+static void set_state(dfco_t* dfco, dfco_state_t state, uint32_t now_ms)
+{
+    dfco->state = state;
+    dfco->state_ms = now_ms;
+    if (state == DFCO_STATE_ACTIVE) {
+        dfco->enabled_count = 0;
+    }
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+bool dfco_init(dfco_t* dfco, uint8_t num_cylinders)
+{
+    if (dfco == NULL || num_cylinders == 0 || num_cylinders > DFCO_MAX_CYLINDERS) {
+        return false;
+    }
+
+    memset(dfco, 0, sizeof(dfco_t));
+    dfco->num_cylinders = num_cylinders;
+    dfco->enabled_count = num_cylinders;
+
+    dfco_config_t* cfg = &dfco->config;
+    cfg->enabled = false;
+    cfg->tps_max = 2.0f;
+    cfg->rpm_enter = 1800;
+    cfg->rpm_exit = 1300;
+    cfg->clt_min = 60.0f;
+    cfg->map_enter_kpa = 30.0f;
+    cfg->map_exit_kpa = 40.0f;
+    cfg->entry_delay_ms = 500;
+    cfg->min_active_ms = 200;
+    cfg->reentry_step = 2;
+
+    build_enable_masks(dfco);
+    refresh_cut_mask(dfco);
+
+    return true;
+}
+
+void dfco_update(dfco_t* dfco, ecu_state_t* ecu, uint32_t now_ms)
+{
+    if (dfco == NULL || ecu == NULL) {
+        return;
+    }
+
+    const dfco_config_t* cfg = &dfco->config;
+    const sensor_data_t* s = &ecu->sensors;
+
+    bool throttle_closed = s->tps_percent < cfg->tps_max;
+    bool enter_ok = cfg->enabled && s->engine_running && throttle_closed &&
+                    s->rpm >= cfg->rpm_enter &&
+                    s->clt_celsius >= cfg->clt_min &&
+                    s->map_kpa <= cfg->map_enter_kpa;
+    bool hold_ok = cfg->enabled && throttle_closed &&
+                   s->rpm >= cfg->rpm_exit &&
+                   s->map_kpa <= cfg->map_exit_kpa;
+
+    if (!s->engine_running) {
+        set_state(dfco, DFCO_STATE_OFF, now_ms);
+        dfco->enabled_count = dfco->num_cylinders;
+    } else {
+        switch (dfco->state) {
+            case DFCO_STATE_OFF:
+                if (enter_ok) {
+                    set_state(dfco, DFCO_STATE_ARMED, now_ms);
+                }
+                break;
+
+            case DFCO_STATE_ARMED:
+                if (!enter_ok) {
+                    set_state(dfco, DFCO_STATE_OFF, now_ms);
+                } else if ((now_ms - dfco->state_ms) >= cfg->entry_delay_ms) {
+                    dfco->entries++;
+                    set_state(dfco, DFCO_STATE_ACTIVE, now_ms);
+                }
+                break;
+
+            case DFCO_STATE_ACTIVE:
+                // Throttle opening ends the cut at once; other exits wait
+                // for min_active_ms so the cut does not chatter
+                if (!throttle_closed ||
+                    (!hold_ok && (now_ms - dfco->state_ms) >= cfg->min_active_ms)) {
+                    set_state(dfco, DFCO_STATE_REENTRY, now_ms);
+                }
+                break;
+
+            case DFCO_STATE_REENTRY:
+                // Completed by dfco_begin_cycle()
+                break;
+        }
+    }
+
+    refresh_cut_mask(dfco);
+
+    // Share of cylinders adding fuel to the wall film this tick
+    if (dfco->state == DFCO_STATE_ACTIVE || dfco->state == DFCO_STATE_REENTRY) {
+        ecu->fuel.fuelled_fraction = (float)dfco->enabled_count / (float)dfco->num_cylinders;
+    } else {
+        ecu->fuel.fuelled_fraction = 1.0f;
+    }
+}
+
+void dfco_begin_cycle(dfco_t* dfco)
+{
+    if (dfco == NULL || dfco->state != DFCO_STATE_REENTRY) {
+        return;
+    }
+
+    uint8_t step = dfco->config.reentry_step;
+    if (step == 0) {
+        step = dfco->num_cylinders;
+    }
+
+    uint16_t count = (uint16_t)dfco->enabled_count + step;
+    if (count >= dfco->num_cylinders) {
+        dfco->enabled_count = dfco->num_cylinders;
+        dfco->state = DFCO_STATE_OFF;
+    } else {
+        dfco->enabled_count = (uint8_t)count;
+    }
+
+    refresh_cut_mask(dfco);
+}
+
+FAST_CODE bool dfco_allow(dfco_t* dfco, uint8_t cylinder)
+{
+    if (dfco == NULL || cylinder >= DFCO_MAX_CYLINDERS) {
+        return true;
+    }
+
+    if (dfco->cut_mask & CYLINDER_BIT(cylinder)) {
+        dfco->injections_cut++;
+        return false;
+    }
+
+    return true;
+}
+
+const char* dfco_get_state_name(dfco_state_t state)
+{
+    switch (state) {
+        case DFCO_STATE_OFF:     return "Off";
+        case DFCO_STATE_ARMED:   return "Armed";
+        case DFCO_STATE_ACTIVE:  return "Active";
+        case DFCO_STATE_REENTRY: return "Re-entry";
+        default:                 return "Unknown";
+    }
+}
@@ -0,0 +1,150 @@
+/**
+ * @file dfco.h
+ * @brief Deceleration fuel cut-off with wall-film aware re-entry
+ *
+ * States:
+ * - OFF:     normal fuelling
+ * - ARMED:   entry conditions met, waiting entry_delay_ms
+ * - ACTIVE:  all cylinders cut
+ * - REENTRY: cylinders re-enabled a few per cycle until all are fuelled
+ *
+ * Entry needs throttle closed, RPM above rpm_enter, engine warm and MAP
+ * below map_enter_kpa, all held for entry_delay_ms. The cut stays active
+ * until throttle opens, RPM falls below rpm_exit or MAP rises above
+ * map_exit_kpa (rpm_exit < rpm_enter and map_exit_kpa > map_enter_kpa give
+ * the hysteresis). A cut shorter than min_active_ms is held to avoid
+ * chatter at the thresholds, unless the throttle opens.
+ *
+ * Wall film: while cylinders are cut, no fuel reaches the port walls but
+ * the film keeps evaporating. dfco_update() sets
+ * fuel_control_t.fuelled_fraction, and calculate_fuel_pulse() only adds
+ * film for that fraction of cylinders, so the X-tau film mass drains
+ * during the cut. On re-entry the X-tau compensation then pre-loads the
+ * first pulses with the fuel needed to rebuild the drained film, instead
+ * of assuming the pre-cut film is still there (lean stumble).
+ *
+ * Re-entry pattern: reentry_step cylinders are re-enabled per cycle, spread
+ * evenly over the firing order, so torque returns in steps without
+ * fuelling the same cylinders first every time.
+ *
+ * dfco_update() runs once per control tick from values already in
+ * ecu->sensors (no sensor reads). dfco_begin_cycle() and dfco_allow() are
+ * called by the dispatcher (see dispatcher_set_dfco()).
+ *
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef DFCO_H
+#define DFCO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "engine_control.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DFCO_MAX_CYLINDERS    ENGINE_MAX_CYLINDERS
+
+/**
+ * @brief DFCO state
+ */
+typedef enum {
+    DFCO_STATE_OFF = 0,
+    DFCO_STATE_ARMED,                 ///< Conditions met, entry delay running
+    DFCO_STATE_ACTIVE,                ///< All cylinders cut
+    DFCO_STATE_REENTRY                ///< Gradual re-enable
+} dfco_state_t;
+
+/**
+ * @brief DFCO configuration
+ */
+typedef struct {
+    bool enabled;
+    float tps_max;                    ///< Throttle closed below this (%)
+    uint16_t rpm_enter;               ///< Minimum RPM to enter
+    uint16_t rpm_exit;                ///< Leave below this RPM (< rpm_enter)
+    float clt_min;                    ///< Minimum coolant temperature (°C)
+    float map_enter_kpa;              ///< Enter below this MAP
+    float map_exit_kpa;               ///< Leave above this MAP (> map_enter_kpa)
+    uint16_t entry_delay_ms;          ///< Conditions must hold this long
+    uint16_t min_active_ms;           ///< Minimum cut time (throttle overrides)
+    uint8_t reentry_step;             ///< Cylinders re-enabled per cycle
+} dfco_config_t;
+
+/**
+ * @brief DFCO state
+ */
+typedef struct {
+    dfco_config_t config;
+    uint8_t num_cylinders;
+
+    dfco_state_t state;
+    uint32_t state_ms;                ///< Time of the last state change
+    uint8_t enabled_count;            ///< Cylinders fuelled during re-entry
+
+    // Precomputed enable masks [cylinders enabled]
+    cylinder_mask_t enable_mask[DFCO_MAX_CYLINDERS + 1];
+    cylinder_mask_t cut_mask;         ///< Current fuel cut bitmask
+
+    // Statistics
+    uint32_t entries;
+    uint32_t injections_cut;
+} dfco_t;
+
+/**
+ * @brief Initialize with defaults (disabled)
+ *
+ * @param dfco DFCO state
+ * @param num_cylinders Cylinder count (1-ENGINE_MAX_CYLINDERS)
+ * @return true on success, false if parameters are invalid
+ */
+bool dfco_init(dfco_t* dfco, uint8_t num_cylinders);
+
+/**
+ * @brief Evaluate entry/exit conditions (once per control tick)
+ *
+ * Uses ecu->sensors as already read this tick and writes
+ * ecu->fuel.fuelled_fraction for the wall-film model. Call before
+ * calculate_fuel_pulse().
+ *
+ * @param dfco DFCO state
+ * @param ecu ECU state
+ * @param now_ms Current time (ms)
+ */
+void dfco_update(dfco_t* dfco, ecu_state_t* ecu, uint32_t now_ms);
+
+/**
+ * @brief Advance the re-entry pattern (once per cycle)
+ *
+ * @param dfco DFCO state
+ */
+void dfco_begin_cycle(dfco_t* dfco);
+
+/**
+ * @brief Check whether an injection may be armed
+ *
+ * @param dfco DFCO state
+ * @param cylinder Firing slot (0-based)
+ * @return true if the injection is allowed, false if cut
+ */
+bool dfco_allow(dfco_t* dfco, uint8_t cylinder);
+
+/**
+ * @brief Get state name
+ *
+ * @param state DFCO state
+ * @return State name string
+ */
+const char* dfco_get_state_name(dfco_state_t state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DFCO_H
@@ -0,0 +1,342 @@
+/**
+ * @file dsp_q15.c
+ * @brief Q15 fixed-point kernels implementation
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "dsp_q15.h"
+#include "compiler_k64.h"
+#include "cycle_counter_k64.h"
+
+//=============================================================================
+// Private Definitions
+//=============================================================================
+
+#define Q14_ROUND               (1 << 13)
+#define Q15_ROUND               (1 << 14)
+
+#define SELF_TEST_ITERATIONS    256
+#define BENCH_ITERATIONS        64
+
+//=============================================================================
+// Private Helper Functions
+//=============================================================================
+
+static inline int16_t sat16(int32_t x)
+{
+    return (x > 32767) ? 32767 : (x < -32768) ? -32768 : (int16_t)x;
+}
+
+/**
+ * @brief Load two adjacent int16 values as one packed word
+ */
+static inline uint32_t load_pair(const int16_t* p)
+{
+    uint32_t w;
+    memcpy(&w, p, sizeof(w));      // Single LDR (unaligned access is allowed)
+    return w;
+}
+
+static inline uint16_t clamp_q14(uint16_t frac)
+{
+    return (frac > DSP_Q14_ONE) ? DSP_Q14_ONE : frac;
+}
+
+#if DSP_Q15_SIMD
+
+static inline uint32_t simd_qadd16(uint32_t a, uint32_t b)
+{
+    uint32_t r;
+    __asm__ ("qadd16 %0, %1, %2" : "=r" (r) : "r" (a), "r" (b));
+    return r;
+}
+
+static inline uint32_t simd_qsub16(uint32_t a, uint32_t b)
+{
+    uint32_t r;
+    __asm__ ("qsub16 %0, %1, %2" : "=r" (r) : "r" (a), "r" (b));
+    return r;
+}
+
+static inline int32_t simd_smlad(uint32_t a, uint32_t b, int32_t acc)
+{
+    int32_t r;
+    __asm__ ("smlad %0, %1, %2, %3" : "=r" (r) : "r" (a), "r" (b), "r" (acc));
+    return r;
+}
+
+#endif // DSP_Q15_SIMD
+
+/**
+ * @brief Small pseudo-random generator for the self-test (LCG)
+ */
+static uint32_t test_rand(uint32_t* seed)
+{
+    *seed = *seed * 1664525UL + 1013904223UL;
+    return *seed >> 8;
+}
+
+//=============================================================================
+// Public Functions - C Reference
+//=============================================================================
+
+int16_t dsp_q15_bilinear_ref(const dsp_q15_table_t* table, uint8_t x, uint8_t y,
+                             uint16_t x_frac, uint16_t y_frac)
+{
+    const int16_t* r0 = &table->cells[y * table->cols + x];
+    const int16_t* r1 = r0 + table->cols;
+    int32_t fx = clamp_q14(x_frac);
+    int32_t fy = clamp_q14(y_frac);
+
+    int32_t v0 = (r0[0] * (DSP_Q14_ONE - fx) + r0[1] * fx + Q14_ROUND) >> 14;
+    int32_t v1 = (r1[0] * (DSP_Q14_ONE - fx) + r1[1] * fx + Q14_ROUND) >> 14;
+
+    return (int16_t)((v0 * (DSP_Q14_ONE - fy) + v1 * fy + Q14_ROUND) >> 14);
+}
+
+uint32_t dsp_q15_iir2_ref(dsp_iir2_t* filter, uint32_t samples)
+{
+    int16_t y0 = dsp_lo16(filter->state);
+    int16_t y1 = dsp_hi16(filter->state);
+    int16_t d0 = sat16((int32_t)dsp_lo16(samples) - y0);
+    int16_t d1 = sat16((int32_t)dsp_hi16(samples) - y1);
+    int16_t s0 = (int16_t)((d0 * dsp_lo16(filter->alpha) + Q15_ROUND) >> 15);
+    int16_t s1 = (int16_t)((d1 * dsp_hi16(filter->alpha) + Q15_ROUND) >> 15);
+
+    filter->state = dsp_pack16(sat16((int32_t)y0 + s0), sat16((int32_t)y1 + s1));
+    return filter->state;
+}
+
+void dsp_q15_trim8_ref(int16_t out[DSP_TRIM_CYLINDERS],
+                       const int16_t base[DSP_TRIM_CYLINDERS],
+                       const int16_t trim[DSP_TRIM_CYLINDERS])
+{
+    for (uint8_t i = 0; i < DSP_TRIM_CYLINDERS; i++) {
+        out[i] = sat16((int32_t)base[i] + trim[i]);
+    }
+}
+
+//=============================================================================
+// Public Functions - Kernels
+//=============================================================================
+
+void dsp_q15_axis(const int16_t* bins, uint8_t count, int16_t value,
+                  uint8_t* index, uint16_t* frac)
+{
+    if (bins == NULL || count < 2 || index == NULL || frac == NULL) {
+        return;
+    }
+
+    if (value <= bins[0]) {
+        *index = 0;
+        *frac = 0;
+        return;
+    }
+
+    if (value >= bins[count - 1]) {
+        *index = (uint8_t)(count - 2);
+        *frac = DSP_Q14_ONE;
+        return;
+    }
+
+    uint8_t i = 0;
+    while (i < count - 2 && value >= bins[i + 1]) {
+        i++;
+    }
+
+    int32_t span = (int32_t)bins[i + 1] - bins[i];
+    *index = i;
+    *frac = (span > 0) ? (uint16_t)((((int32_t)value - bins[i]) << 14) / span) : 0;
+}
+
+FAST_CODE int16_t dsp_q15_bilinear(const dsp_q15_table_t* table, uint8_t x, uint8_t y,
+                                   uint16_t x_frac, uint16_t y_frac)
+{
+#if DSP_Q15_SIMD
+    const int16_t* r0 = &table->cells[y * table->cols + x];
+    uint16_t fx = clamp_q14(x_frac);
+    uint16_t fy = clamp_q14(y_frac);
+    uint32_t wx = dsp_pack16((int16_t)(DSP_Q14_ONE - fx), (int16_t)fx);
+    uint32_t wy = dsp_pack16((int16_t)(DSP_Q14_ONE - fy), (int16_t)fy);
+
+    int32_t v0 = simd_smlad(load_pair(r0), wx, Q14_ROUND) >> 14;
+    int32_t v1 = simd_smlad(load_pair(r0 + table->cols), wx, Q14_ROUND) >> 14;
+
+    return (int16_t)(simd_smlad(dsp_pack16((int16_t)v0, (int16_t)v1), wy, Q14_ROUND) >> 14);
+#else
+    return dsp_q15_bilinear_ref(table, x, y, x_frac, y_frac);
+#endif
+}
+
+FAST_CODE uint32_t dsp_q15_iir2(dsp_iir2_t* filter, uint32_t samples)
+{
+#if DSP_Q15_SIMD
+    uint32_t d = simd_qsub16(samples, filter->state);
+
+    // SMULBB / SMULTT
+    int32_t s0 = (dsp_lo16(d) * dsp_lo16(filter->alpha) + Q15_ROUND) >> 15;
+    int32_t s1 = (dsp_hi16(d) * dsp_hi16(filter->alpha) + Q15_ROUND) >> 15;
+
+    filter->state = simd_qadd16(filter->state, dsp_pack16((int16_t)s0, (int16_t)s1));
+    return filter->state;
+#else
+    return dsp_q15_iir2_ref(filter, samples);
+#endif
+}
+
+FAST_CODE uint32_t dsp_q15_iir2_block(dsp_iir2_t* filter, const uint32_t* samples, uint16_t count)
+{
+    for (uint16_t i = 0; i < count; i++) {
+        dsp_q15_iir2(filter, samples[i]);
+    }
+
+    return filter->state;
+}
+
+void dsp_q15_iir2_init(dsp_iir2_t* filter, int16_t alpha0, int16_t alpha1, uint32_t initial)
+{
+    if (filter == NULL) {
+        return;
+    }
+
+    filter->alpha = dsp_pack16(alpha0 < 0 ? 0 : alpha0, alpha1 < 0 ? 0 : alpha1);
+    filter->state = initial;
+}
+
+FAST_CODE void dsp_q15_trim8(int16_t out[DSP_TRIM_CYLINDERS],
+                             const int16_t base[DSP_TRIM_CYLINDERS],
+                             const int16_t trim[DSP_TRIM_CYLINDERS])
+{
+#if DSP_Q15_SIMD
+    uint32_t r[4];
+
+    r[0] = simd_qadd16(load_pair(&base[0]), load_pair(&trim[0]));
+    r[1] = simd_qadd16(load_pair(&base[2]), load_pair(&trim[2]));
+    r[2] = simd_qadd16(load_pair(&base[4]), load_pair(&trim[4]));
+    r[3] = simd_qadd16(load_pair(&base[6]), load_pair(&trim[6]));
+
+    memcpy(out, r, sizeof(r));
+#else
+    dsp_q15_trim8_ref(out, base, trim);
+#endif
+}
+
+//=============================================================================
+// Public Functions - Verification
+//=============================================================================
+
+COLD_FUNC uint32_t dsp_q15_self_test(void)
+{
+    // Extremes first so saturation and rounding edges are always covered
+    static const int16_t cells[4][4] = {
+        {  32767, -32768,  32767, -32768 },
+        { -32768,  32767,      0,     -1 },
+        {      1,  -1000,   1000,  20000 },
+        { -20000,  32767,  32767,  32767 },
+    };
+    const dsp_q15_table_t table = { &cells[0][0], 4, 4 };
+    uint32_t seed = 0x12345678UL;
+    uint32_t errors = 0;
+
+    for (uint16_t n = 0; n < SELF_TEST_ITERATIONS; n++) {
+        // Bilinear: every cell, fractions including 0 and 1.0
+        uint8_t x = (uint8_t)(n % 3);
+        uint8_t y = (uint8_t)((n / 3) % 3);
+        uint16_t fx = (n < 16) ? (uint16_t)((n & 1) ? DSP_Q14_ONE : 0) :
+                                 (uint16_t)(test_rand(&seed) % (DSP_Q14_ONE + 1));
+        uint16_t fy = (n < 16) ? (uint16_t)((n & 2) ? DSP_Q14_ONE : 0) :
+                                 (uint16_t)(test_rand(&seed) % (DSP_Q14_ONE + 1));
+
+        if (dsp_q15_bilinear(&table, x, y, fx, fy) !=
+            dsp_q15_bilinear_ref(&table, x, y, fx, fy)) {
+            errors++;
+        }
+
+        // Filter: full-scale steps and random samples / coefficients
+        dsp_iir2_t a;
+        dsp_iir2_t b;
+        uint32_t start = (n < 16) ? dsp_pack16(-32768, 32767) : test_rand(&seed);
+        uint32_t sample = (n < 16) ? dsp_pack16(32767, -32768) : test_rand(&seed);
+        dsp_q15_iir2_init(&a, (int16_t)(test_rand(&seed) & 0x7FFF),
+                          (int16_t)(test_rand(&seed) & 0x7FFF), start);
+        b = a;
+
+        for (uint8_t k = 0; k < 4; k++) {
+            if (dsp_q15_iir2(&a, sample) != dsp_q15_iir2_ref(&b, sample)) {
+                errors++;
+            }
+        }
+
+        // Trim: random values, saturating both ways
+        int16_t base[DSP_TRIM_CYLINDERS];
+        int16_t trim[DSP_TRIM_CYLINDERS];
+        int16_t out_simd[DSP_TRIM_CYLINDERS];
+        int16_t out_ref[DSP_TRIM_CYLINDERS];
+        for (uint8_t i = 0; i < DSP_TRIM_CYLINDERS; i++) {
+            base[i] = (int16_t)test_rand(&seed);
+            trim[i] = (int16_t)test_rand(&seed);
+        }
+
+        dsp_q15_trim8(out_simd, base, trim);
+        dsp_q15_trim8_ref(out_ref, base, trim);
+        if (memcmp(out_simd, out_ref, sizeof(out_ref)) != 0) {
+            errors++;
+        }
+    }
+
+    return errors;
+}
+
+COLD_FUNC bool dsp_q15_benchmark(dsp_q15_bench_t* bench)
+{
+    if (bench == NULL) {
+        return false;
+    }
+
+    memset(bench, 0, sizeof(dsp_q15_bench_t));
+
+#if DSP_Q15_SIMD
+    static const int16_t cells[2][2] = { { 100, 200 }, { 300, 400 } };
+    const dsp_q15_table_t table = { &cells[0][0], 2, 2 };
+    static const int16_t base[DSP_TRIM_CYLINDERS] = { 1000, 2000, 3000, 4000, 5000, 6000, 7000, 8000 };
+    static const int16_t trim[DSP_TRIM_CYLINDERS] = { -10, 20, -30, 40, -50, 60, -70, 80 };
+    int16_t out[DSP_TRIM_CYLINDERS];
+    dsp_iir2_t filter;
+    volatile int32_t sink = 0;
+    uint32_t start;
+
+    cycle_counter_enable();
+
+    // Cycles per call, averaged, including call overhead
+#define BENCH(field, expr)                                      \
+    start = cycle_counter_read();                               \
+    for (uint8_t i = 0; i < BENCH_ITERATIONS; i++) {            \
+        sink += (int32_t)(expr);                                \
+    }                                                           \
+    bench->field = (cycle_counter_read() - start) / BENCH_ITERATIONS;
+
+    BENCH(bilinear_simd, dsp_q15_bilinear(&table, 0, 0, (uint16_t)(i << 8), 8192));
+    BENCH(bilinear_ref, dsp_q15_bilinear_ref(&table, 0, 0, (uint16_t)(i << 8), 8192));
+
+    dsp_q15_iir2_init(&filter, 4096, 8192, 0);
+    BENCH(iir2_simd, dsp_q15_iir2(&filter, dsp_pack16((int16_t)(i << 6), 1000)));
+    dsp_q15_iir2_init(&filter, 4096, 8192, 0);
+    BENCH(iir2_ref, dsp_q15_iir2_ref(&filter, dsp_pack16((int16_t)(i << 6), 1000)));
+
+    BENCH(trim8_simd, (dsp_q15_trim8(out, base, trim), out[i & 7]));
+    BENCH(trim8_ref, (dsp_q15_trim8_ref(out, base, trim), out[i & 7]));
+
+#undef BENCH
+
+    (void)sink;
+    return true;
+#else
+    return false;
+#endif
+}
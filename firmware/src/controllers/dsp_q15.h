@@ -0,0 +1,208 @@
+/**
+ * @file dsp_q15.h
+ * @brief Q15 fixed-point kernels using the Cortex-M4 DSP (SIMD) instructions
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * The Cortex-M4 can multiply-accumulate two 16-bit pairs in one cycle
+ * (SMUAD/SMLAD) and add/subtract two or four lanes with saturation
+ * (QADD16/QSUB16, SSAT). These kernels pack 16-bit values two per word:
+ * - dsp_q15_bilinear(): 2D table interpolation on int16 cells. The two
+ *   neighbouring cells of a row are loaded as one word and weighted with
+ *   one SMLAD; two rows and the final Y blend take three
+ * - dsp_q15_iir2(): first-order low-pass on two ADC channels packed in one
+ *   word (QSUB16 / two multiplies / QADD16)
+ * - dsp_q15_trim8(): saturating add of a per-cylinder trim to 8 values,
+ *   four QADD16
+ *
+ * Interpolation weights are Q14 (0 to 16384 = 1.0) so both w and 1 - w
+ * fit in a signed 16-bit lane and the blend is an exact convex
+ * combination.
+ *
+ * Packed words: low half = first value / channel 0, high half = second
+ * value / channel 1 (little-endian memory order).
+ *
+ * Every kernel has a portable C reference (*_ref). Without
+ * __ARM_FEATURE_DSP (host build) the public functions use it. The SIMD
+ * versions round and saturate exactly like the reference, which
+ * dsp_q15_self_test() checks on the target.
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef DSP_Q15_H
+#define DSP_Q15_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DSP_Q14_ONE             16384   ///< Interpolation weight 1.0
+#define DSP_TRIM_CYLINDERS      8
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#define DSP_Q15_SIMD            1
+#else
+#define DSP_Q15_SIMD            0
+#endif
+
+//=============================================================================
+// Types
+//=============================================================================
+
+/**
+ * @brief Q15 table (row-major, rows x cols int16 cells)
+ */
+typedef struct {
+    const int16_t* cells;
+    uint8_t rows;
+    uint8_t cols;
+} dsp_q15_table_t;
+
+/**
+ * @brief Two-channel low-pass filter
+ *
+ * y += (x - y) * alpha per channel. Samples are int16; scale 12-bit ADC
+ * readings up (e.g. << 3) to keep fractional resolution in the state;
+ * the output settles within 0.5 / alpha LSB of a constant input.
+ */
+typedef struct {
+    uint32_t state;                 ///< Packed filtered values
+    uint32_t alpha;                 ///< Packed Q15 coefficients (0-32767)
+} dsp_iir2_t;
+
+/**
+ * @brief Cycle counts of one kernel call (DWT cycle counter)
+ */
+typedef struct {
+    uint32_t bilinear_simd;
+    uint32_t bilinear_ref;
+    uint32_t iir2_simd;
+    uint32_t iir2_ref;
+    uint32_t trim8_simd;
+    uint32_t trim8_ref;
+} dsp_q15_bench_t;
+
+//=============================================================================
+// Packing
+//=============================================================================
+
+static inline uint32_t dsp_pack16(int16_t lo, int16_t hi)
+{
+    return (uint16_t)lo | ((uint32_t)(uint16_t)hi << 16);
+}
+
+static inline int16_t dsp_lo16(uint32_t packed)
+{
+    return (int16_t)(packed & 0xFFFF);
+}
+
+static inline int16_t dsp_hi16(uint32_t packed)
+{
+    return (int16_t)(packed >> 16);
+}
+
+//=============================================================================
+// Function Prototypes
+//=============================================================================
+
+/**
+ * @brief Locate a value on an axis: lower bin index and Q14 fraction
+ *
+ * Values outside the axis are clamped to the end bins.
+ *
+ * @param bins Ascending axis breakpoints
+ * @param count Number of breakpoints (>= 2)
+ * @param value Value to locate
+ * @param index Receives the lower bin index (0 to count - 2)
+ * @param frac Receives the Q14 position between index and index + 1
+ */
+void dsp_q15_axis(const int16_t* bins, uint8_t count, int16_t value,
+                  uint8_t* index, uint16_t* frac);
+
+/**
+ * @brief Bilinear interpolation of a Q15 table
+ *
+ * @param table Table
+ * @param x Column index (0 to cols - 2)
+ * @param y Row index (0 to rows - 2)
+ * @param x_frac Q14 fraction between column x and x + 1
+ * @param y_frac Q14 fraction between row y and y + 1
+ * @return Interpolated value (rounded)
+ */
+int16_t dsp_q15_bilinear(const dsp_q15_table_t* table, uint8_t x, uint8_t y,
+                         uint16_t x_frac, uint16_t y_frac);
+int16_t dsp_q15_bilinear_ref(const dsp_q15_table_t* table, uint8_t x, uint8_t y,
+                             uint16_t x_frac, uint16_t y_frac);
+
+/**
+ * @brief Filter one packed sample pair
+ *
+ * @param filter Filter state
+ * @param samples Packed int16 samples (channel 0 low, channel 1 high)
+ * @return Packed filtered values
+ */
+uint32_t dsp_q15_iir2(dsp_iir2_t* filter, uint32_t samples);
+uint32_t dsp_q15_iir2_ref(dsp_iir2_t* filter, uint32_t samples);
+
+/**
+ * @brief Filter a buffer of packed sample pairs (e.g. a DMA ADC block)
+ *
+ * @param filter Filter state
+ * @param samples Packed samples
+ * @param count Number of words
+ * @return Packed filtered values after the last sample
+ */
+uint32_t dsp_q15_iir2_block(dsp_iir2_t* filter, const uint32_t* samples, uint16_t count);
+
+/**
+ * @brief Initialize a filter
+ *
+ * @param filter Filter state
+ * @param alpha0 Channel 0 coefficient (Q15)
+ * @param alpha1 Channel 1 coefficient (Q15)
+ * @param initial Packed initial values
+ */
+void dsp_q15_iir2_init(dsp_iir2_t* filter, int16_t alpha0, int16_t alpha1, uint32_t initial);
+
+/**
+ * @brief Saturating per-cylinder trim: out[i] = sat16(base[i] + trim[i])
+ *
+ * @param out Result (may alias base)
+ * @param base Base values
+ * @param trim Per-cylinder trims
+ */
+void dsp_q15_trim8(int16_t out[DSP_TRIM_CYLINDERS],
+                   const int16_t base[DSP_TRIM_CYLINDERS],
+                   const int16_t trim[DSP_TRIM_CYLINDERS]);
+void dsp_q15_trim8_ref(int16_t out[DSP_TRIM_CYLINDERS],
+                       const int16_t base[DSP_TRIM_CYLINDERS],
+                       const int16_t trim[DSP_TRIM_CYLINDERS]);
+
+/**
+ * @brief Compare the SIMD kernels with the C reference
+ *
+ * Runs a fixed pseudo-random set of inputs, including saturation and
+ * end-of-range cases, through both versions.
+ *
+ * @return Number of mismatching results (0 = bit-exact)
+ */
+uint32_t dsp_q15_self_test(void);
+
+/**
+ * @brief Measure kernel cycle counts with the DWT cycle counter
+ *
+ * @param bench Receives the cycle counts
+ * @return true on success, false without a cycle counter (host build)
+ */
+bool dsp_q15_benchmark(dsp_q15_bench_t* bench);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DSP_Q15_H
@@ -0,0 +1,64 @@
+/**
+ * @file engine_capacity.h
+ * @brief Build-time cylinder capacity and derived queue sizes
+ *
+ * Every per-cylinder array, cylinder bitmask and scheduler queue is sized
+ * from ENGINE_MAX_CYLINDERS, so 12 and 16 cylinder engines only need a
+ * different build (CMake -DENGINE_MAX_CYLINDERS=12). The runtime cylinder
+ * count (engine_config_t.num_cylinders) may be anything up to it.
+ *
+ * cylinder_mask_t holds one bit per cylinder (bit n = cylinder n + 1,
+ * or firing slot n for coil masks): 8, 16 or 32 bits.
+ *
+ * Queue sizes for the worst case of one engine cycle:
+ * - angle list: batch injection (2 firings per injector) + dwell + spark
+ *   per cylinder
+ * - angle scheduler: injection open/close + dwell/spark per cylinder
+ *   (two-stage events, two slots each)
+ * - multi-stage scheduler: one injection and one ignition event per
+ *   cylinder
+ *
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef ENGINE_CAPACITY_H
+#define ENGINE_CAPACITY_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef ENGINE_MAX_CYLINDERS
+#define ENGINE_MAX_CYLINDERS        8
+#endif
+
+#if ENGINE_MAX_CYLINDERS < 1 || ENGINE_MAX_CYLINDERS > 32
+#error "ENGINE_MAX_CYLINDERS must be 1-32"
+#elif ENGINE_MAX_CYLINDERS <= 8
+typedef uint8_t cylinder_mask_t;
+#elif ENGINE_MAX_CYLINDERS <= 16
+typedef uint16_t cylinder_mask_t;
+#else
+typedef uint32_t cylinder_mask_t;
+#endif
+
+#define CYLINDER_BIT(n)             ((cylinder_mask_t)((cylinder_mask_t)1U << (n)))
+#define CYLINDER_MASK_ALL(n)        ((cylinder_mask_t)(((n) >= 32) ? 0xFFFFFFFFUL : ((1UL << (n)) - 1)))
+
+#define ENGINE_MAX_BATCH_PAIRS      ((ENGINE_MAX_CYLINDERS + 1) / 2)
+
+#define ENGINE_MAX_CYCLE_EVENTS     (4 * ENGINE_MAX_CYLINDERS)
+#define ENGINE_MAX_SCHEDULED_EVENTS (4 * ENGINE_MAX_CYLINDERS)
+#define ENGINE_MAX_MULTISTAGE       (2 * ENGINE_MAX_CYLINDERS)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_CAPACITY_H
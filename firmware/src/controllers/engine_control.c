@@ -46,9 +46,9 @@
 // Constants
 //=============================================================================
 
-#define STOICH_AFR              13.1f   // Stoichiometric AFR for gasoline E30
+#define STOICH_AFR              13.1f   // Default stoichiometric AFR (E30, no flex sensor)
 #define AIR_DENSITY_KG_M3       1.225f  // Air density at STP
-#define FUEL_DENSITY_G_CC       0.81f   // Gasoline E30 density
+#define FUEL_DENSITY_G_CC       0.81f   // Default fuel density (E30, no flex sensor)
 
 //=============================================================================
 // Public Functions
@@ -64,12 +64,18 @@ void ecu_init(ecu_state_t* ecu, const engine_config_t* config) {
 
     // Initialize fuel control with defaults
     ecu->fuel.afr_target = STOICH_AFR;
+    ecu->fuel.stoich_afr = STOICH_AFR;
+    ecu->fuel.fuel_density_g_cc = FUEL_DENSITY_G_CC;
+    ecu->fuel.ethanol_ve_table = NULL;
+    ecu->fuel.ethanol_blend = 0.0f;
+    ecu->ignition.ethanol_timing_table = NULL;
     ecu->fuel.fuel_pressure_kpa = 300.0f;  // 3 bar typical
     ecu->fuel.injector_flow_cc = 300.0f;   // 300cc/min injector
 
     // Initialize injection mode (rusEFI-compatible)
     // Default to SIMULTANEOUS for cranking reliability
-    // Can be changed to SEQUENTIAL/BATCH after engine starts
+    // Switched to BATCH/SEQUENTIAL at cycle boundaries by the injection
+    // transition engine (injection_transition.h)
     ecu->fuel.injection_mode = INJECTION_MODE_SIMULTANEOUS;
 
     // Initialize VE table with reasonable defaults (80% VE)
@@ -95,19 +101,30 @@ void ecu_init(ecu_state_t* ecu, const engine_config_t* config) {
     ecu->fuel.wall_wetting.beta = 0.5f;            // 50% hits the wall
     ecu->fuel.wall_wetting.fuel_film_mass = 0.0f;
     ecu->fuel.wall_wetting.prev_map_kpa = 100.0f;
+    ecu->fuel.fuelled_fraction = 1.0f;
 
     // Initialize ignition with defaults
     ecu->ignition.base_timing_deg = 10;  // 10° BTDC base
     ecu->ignition.dwell_time_us = 3000;  // 3ms dwell
 
+    // One coil per cylinder (PIN_IGNITION_x); wasted spark used until cam sync
+    ecu->ignition.ignition_mode = IGNITION_MODE_COP;
+
     // Initialize dwell table (rusEFI-compatible)
     // Lower voltage = longer dwell needed for saturation
+    // Higher RPM = slightly shorter dwell (less time between sparks)
     float dwell_voltages[] = {6.0f, 8.0f, 10.0f, 12.0f, 13.5f, 14.0f, 15.0f, 16.0f};
     float dwell_times[] = {5000.0f, 4500.0f, 4000.0f, 3500.0f, 3000.0f, 2800.0f, 2600.0f, 2500.0f};
+    float dwell_rpms[] = {500.0f, 1000.0f, 2000.0f, 3000.0f, 4500.0f, 6000.0f, 7500.0f, 9000.0f};
+    float rpm_factor[] = {1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.95f, 0.9f, 0.85f};
     for (int i = 0; i < 8; i++) {
         ecu->ignition.dwell_table.voltage[i] = dwell_voltages[i];
-        ecu->ignition.dwell_table.dwell_us[i] = dwell_times[i];
+        ecu->ignition.dwell_table.rpm[i] = dwell_rpms[i];
+        for (int j = 0; j < 8; j++) {
+            ecu->ignition.dwell_table.dwell_us[i][j] = dwell_times[i] * rpm_factor[j];
+        }
     }
+    ecu->ignition.max_dwell_duty = 0.6f;  // Leave 40% for spark burn/recovery
 
     // Initialize timing table with reasonable values
     for (int i = 0; i < 16; i++) {
@@ -196,6 +213,15 @@ uint32_t calculate_fuel_pulse(ecu_state_t* ecu) {
                               500.0f, 7000.0f,    // RPM range
                               20.0f, 100.0f);      // MAP range (kPa)
 
+    // Flex fuel: blend towards the ethanol table (see flex_fuel.h)
+    if (ecu->fuel.ethanol_ve_table != NULL && ecu->fuel.ethanol_blend > 0.0f) {
+        float ethanol_ve = lookup_table_2d(ecu->fuel.ethanol_ve_table,
+                                           rpm, map_kpa,
+                                           500.0f, 7000.0f,
+                                           20.0f, 100.0f);
+        ve += (ethanol_ve - ve) * ecu->fuel.ethanol_blend;
+    }
+
     // Calculate air mass per cycle (grams)
     float air_mass_g = (map_kpa * displacement_liters * ve) /
                        (0.287f * (ecu->sensors.iat_celsius + 273.15f));
@@ -207,14 +233,25 @@ uint32_t calculate_fuel_pulse(ecu_state_t* ecu) {
     float fuel_mass_mg = fuel_mass_g * 1000.0f;
 
     // rusEFI-compatible wall wetting compensation
-    float compensated_fuel_mg = update_wall_wetting(&ecu->fuel.wall_wetting,
+    wall_wetting_t* ww = &ecu->fuel.wall_wetting;
+    float film_mg = ww->fuel_film_mass;
+    float compensated_fuel_mg = update_wall_wetting(ww,
                                                     fuel_mass_mg,
                                                     map_kpa,
                                                     10.0f);  // 10ms cycle time
 
+    // DFCO: cut cylinders add no fuel to the film, so it drains during the
+    // cut and the compensation above rebuilds it on re-entry (see dfco.h)
+    if (ecu->fuel.fuelled_fraction < 1.0f) {
+        float alpha = (ww->alpha < 0.01f) ? 0.0f : ww->alpha;
+        float beta = (ww->beta < 0.01f) ? 0.0f : ww->beta;
+        ww->fuel_film_mass = alpha * film_mg +
+                             beta * compensated_fuel_mg * ecu->fuel.fuelled_fraction;
+    }
+
     // Convert back to grams and then to pulse width
     float compensated_fuel_g = compensated_fuel_mg / 1000.0f;
-    float fuel_cc = compensated_fuel_g / FUEL_DENSITY_G_CC;
+    float fuel_cc = compensated_fuel_g / ecu->fuel.fuel_density_g_cc;
     float pulse_us = (fuel_cc / ecu->fuel.injector_flow_cc) * 60000000.0f;
 
     // Apply corrections
@@ -253,6 +290,14 @@ uint8_t calculate_ignition_timing(ecu_state_t* ecu) {
                                        500.0f, 7000.0f,
                                        20.0f, 100.0f);
 
+    if (ecu->ignition.ethanol_timing_table != NULL && ecu->fuel.ethanol_blend > 0.0f) {
+        float ethanol_timing = lookup_table_2d(ecu->ignition.ethanol_timing_table,
+                                               rpm, map_kpa,
+                                               500.0f, 7000.0f,
+                                               20.0f, 100.0f);
+        base_timing += (ethanol_timing - base_timing) * ecu->fuel.ethanol_blend;
+    }
+
     // Apply corrections
     base_timing += ecu->ignition.clt_advance;
     base_timing += ecu->ignition.iat_advance;
@@ -262,10 +307,7 @@ uint8_t calculate_ignition_timing(ecu_state_t* ecu) {
     if (base_timing < 0.0f) base_timing = 0.0f;
     if (base_timing > 40.0f) base_timing = 40.0f;
 
-    // rusEFI-compatible dwell time scheduling
-    ecu->ignition.dwell_time_us = (uint16_t)calculate_dwell_time(
-        &ecu->ignition.dwell_table,
-        ecu->sensors.battery_voltage);
+    // Dwell is updated once per cycle by update_dwell()
 
     return (uint8_t)base_timing;
 }
@@ -401,34 +443,93 @@ float calculate_injector_latency(const injector_latency_table_t* table,
     }
 }
 
+/**
+ * @brief Find interpolation cell on an ascending 8-point axis
+ *
+ * Binary search; returns lower index and fraction (clamped to 0-1).
+ */
+static uint8_t find_axis_cell(const float axis[8], float x, float* fraction) {
+    if (x <= axis[0]) {
+        *fraction = 0.0f;
+        return 0;
+    }
+    if (x >= axis[7]) {
+        *fraction = 1.0f;
+        return 6;
+    }
+
+    uint8_t lo = 0;
+    uint8_t hi = 7;
+    while (hi - lo > 1) {
+        uint8_t mid = (uint8_t)((lo + hi) / 2);
+        if (x < axis[mid]) {
+            hi = mid;
+        } else {
+            lo = mid;
+        }
+    }
+
+    float span = axis[lo + 1] - axis[lo];
+    *fraction = (span > 0.0f) ? (x - axis[lo]) / span : 0.0f;
+    return lo;
+}
+
 float calculate_dwell_time(const dwell_table_t* table,
-                          float battery_voltage) {
+                          float battery_voltage,
+                          float rpm) {
     if (table == NULL) {
         return 3000.0f;  // Default 3ms
     }
 
-    // Find voltage breakpoints for interpolation
-    for (int i = 0; i < 7; i++) {
-        if (battery_voltage >= table->voltage[i] &&
-            battery_voltage <= table->voltage[i + 1]) {
+    float fv, fr;
+    uint8_t v = find_axis_cell(table->voltage, battery_voltage, &fv);
+    uint8_t r = find_axis_cell(table->rpm, rpm, &fr);
 
-            // Linear interpolation
-            float v0 = table->voltage[i];
-            float v1 = table->voltage[i + 1];
-            float d0 = table->dwell_us[i];
-            float d1 = table->dwell_us[i + 1];
+    // Bilinear interpolation
+    float d00 = table->dwell_us[v][r];
+    float d01 = table->dwell_us[v][r + 1];
+    float d10 = table->dwell_us[v + 1][r];
+    float d11 = table->dwell_us[v + 1][r + 1];
+
+    float d0 = d00 + (d01 - d00) * fr;
+    float d1 = d10 + (d11 - d10) * fr;
+    return d0 + (d1 - d0) * fv;
+}
 
-            float fraction = (battery_voltage - v0) / (v1 - v0);
-            return d0 + (d1 - d0) * fraction;
-        }
+void update_dwell(ecu_state_t* ecu, uint16_t coil_period_deg) {
+    if (ecu == NULL) {
+        return;
     }
 
-    // Extrapolate if out of range
-    if (battery_voltage < table->voltage[0]) {
-        return table->dwell_us[0];
+    float rpm = (float)ecu->sensors.rpm;
+    float dwell_us = calculate_dwell_time(&ecu->ignition.dwell_table,
+                                          ecu->sensors.battery_voltage,
+                                          rpm);
+
+    ecu->ignition.dwell_limited = false;
+
+    if (rpm > 0.0f && coil_period_deg > 0) {
+        // Time between two sparks on the same coil
+        float us_per_degree = 1000000.0f / (rpm * 6.0f);
+        float period_us = coil_period_deg * us_per_degree;
+
+        // Per-coil duty limit: coil must recover before the next charge
+        float duty = ecu->ignition.max_dwell_duty;
+        if (duty <= 0.0f || duty > 0.9f) {
+            duty = 0.9f;
+        }
+        float max_dwell_us = period_us * duty;
+        if (dwell_us > max_dwell_us) {
+            dwell_us = max_dwell_us;
+            ecu->ignition.dwell_limited = true;
+        }
+
+        ecu->ignition.dwell_angle_deg = (uint16_t)(dwell_us / us_per_degree + 0.5f);
     } else {
-        return table->dwell_us[7];
+        ecu->ignition.dwell_angle_deg = 0;
     }
+
+    ecu->ignition.dwell_time_us = (uint16_t)dwell_us;
 }
 
 float update_wall_wetting(wall_wetting_t* ww, float base_fuel_mg,
@@ -573,17 +674,32 @@ void diagnose_sensors(sensor_data_t* sensors) {
     }
 }
 
+float engine_slot_tdc_angle(const engine_config_t* config, uint8_t slot) {
+    if (config == NULL || config->num_cylinders == 0 || slot >= ENGINE_MAX_CYLINDERS) {
+        return 0.0f;
+    }
+
+    // Even spacing plus odd-fire offset
+    float angle = slot * (720.0f / config->num_cylinders) + config->tdc_offset_deg[slot];
+
+    while (angle < 0.0f) {
+        angle += 720.0f;
+    }
+    while (angle >= 720.0f) {
+        angle -= 720.0f;
+    }
+
+    return angle;
+}
+
 float calculate_injection_timing(ecu_state_t* ecu, uint8_t cylinder) {
     if (ecu == NULL || cylinder >= ecu->config.num_cylinders) {
         return 0.0f;
     }
 
-    // Calculate degrees per cylinder for even firing
-    float degrees_per_cylinder = 720.0f / ecu->config.num_cylinders;
-
     // Calculate injection timing for this cylinder
     // Typically inject during intake stroke (180° before TDC)
-    float injection_timing = cylinder * degrees_per_cylinder - 180.0f;
+    float injection_timing = engine_slot_tdc_angle(&ecu->config, cylinder) - 180.0f;
 
     // Normalize to 0-720° range
     while (injection_timing < 0.0f) {
@@ -684,12 +800,12 @@ float calculate_injection_timing_for_mode(ecu_state_t* ecu,
     }
 }
 
-uint8_t get_injectors_to_fire(ecu_state_t* ecu, float crank_angle) {
+cylinder_mask_t get_injectors_to_fire(ecu_state_t* ecu, float crank_angle) {
     if (ecu == NULL) {
         return 0;
     }
 
-    uint8_t injector_mask = 0;
+    cylinder_mask_t injector_mask = 0;
     float tolerance = 5.0f;  // ±5° window for triggering
 
     switch (ecu->fuel.injection_mode) {
@@ -706,7 +822,7 @@ uint8_t get_injectors_to_fire(ecu_state_t* ecu, float crank_angle) {
                 if (angle_diff < -360.0f) angle_diff += 720.0f;
 
                 if (angle_diff >= 0.0f && angle_diff < tolerance) {
-                    injector_mask |= (1 << cyl);
+                    injector_mask |= CYLINDER_BIT(cyl);
                 }
             }
             break;
@@ -723,16 +839,16 @@ uint8_t get_injectors_to_fire(ecu_state_t* ecu, float crank_angle) {
                 float diff1 = crank_angle - pair_timing_1;
                 if (diff1 >= 0.0f && diff1 < tolerance) {
                     // Fire both cylinders in this pair
-                    injector_mask |= (1 << ecu->fuel.batch_pairs[pair][0]);
-                    injector_mask |= (1 << ecu->fuel.batch_pairs[pair][1]);
+                    injector_mask |= CYLINDER_BIT(ecu->fuel.batch_pairs[pair][0]);
+                    injector_mask |= CYLINDER_BIT(ecu->fuel.batch_pairs[pair][1]);
                 }
 
                 // Check second firing point (360-720°)
                 float diff2 = crank_angle - pair_timing_2;
                 if (diff2 >= 0.0f && diff2 < tolerance) {
                     // Fire both cylinders in this pair again
-                    injector_mask |= (1 << ecu->fuel.batch_pairs[pair][0]);
-                    injector_mask |= (1 << ecu->fuel.batch_pairs[pair][1]);
+                    injector_mask |= CYLINDER_BIT(ecu->fuel.batch_pairs[pair][0]);
+                    injector_mask |= CYLINDER_BIT(ecu->fuel.batch_pairs[pair][1]);
                 }
             }
             break;
@@ -743,7 +859,7 @@ uint8_t get_injectors_to_fire(ecu_state_t* ecu, float crank_angle) {
             if (crank_angle < tolerance) {
                 // Fire all cylinders
                 for (uint8_t cyl = 0; cyl < ecu->config.num_cylinders; cyl++) {
-                    injector_mask |= (1 << cyl);
+                    injector_mask |= CYLINDER_BIT(cyl);
                 }
             }
             break;
@@ -779,3 +895,16 @@ const char* get_injection_mode_name(injection_mode_t mode) {
             return "Unknown";
     }
 }
+
+const char* get_ignition_mode_name(ignition_mode_t mode) {
+    switch (mode) {
+        case IGNITION_MODE_COP:
+            return "Coil On Plug";
+        case IGNITION_MODE_WASTED_SPARK:
+            return "Wasted Spark";
+        case IGNITION_MODE_DISTRIBUTOR:
+            return "Distributor";
+        default:
+            return "Unknown";
+    }
+}
@@ -40,17 +40,19 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "engine_capacity.h"
 
 //=============================================================================
 // Engine Configuration
 //=============================================================================
 
 typedef struct {
-    uint8_t num_cylinders;       // Number of cylinders (4, 6, 8)
+    uint8_t num_cylinders;       // Number of cylinders (1-ENGINE_MAX_CYLINDERS)
     uint16_t displacement_cc;    // Engine displacement in cc
     uint16_t crank_teeth;        // Crank wheel teeth (e.g., 36)
     uint16_t missing_teeth;      // Missing teeth (e.g., 1 for 36-1)
-    uint8_t firing_order[8];     // Firing order (e.g., {1,3,4,2} for 4-cyl)
+    uint8_t firing_order[ENGINE_MAX_CYLINDERS];  // Firing order (e.g., {1,3,4,2} for 4-cyl)
+    int16_t tdc_offset_deg[ENGINE_MAX_CYLINDERS]; // Odd-fire: slot TDC offset from even spacing
 } engine_config_t;
 
 //=============================================================================
@@ -137,8 +139,12 @@ typedef struct {
 
 typedef struct {
     uint32_t base_pulse_us;      // Base injection pulse width (µs)
-    float ve_table[16][16];      // Volumetric efficiency table
+    float ve_table[16][16];      // Volumetric efficiency table (E0 with flex fuel)
+    const float (*ethanol_ve_table)[16];  // Blended in by ethanol_blend (flex fuel, may be NULL)
+    float ethanol_blend;         // Ethanol table share 0-1 (flex fuel)
     float afr_target;            // Target air-fuel ratio
+    float stoich_afr;            // Stoichiometric AFR (flex fuel, see flex_fuel.h)
+    float fuel_density_g_cc;     // Fuel density (flex fuel)
     float fuel_pressure_kpa;     // Fuel pressure (kPa)
     float injector_flow_cc;      // Injector flow rate (cc/min)
 
@@ -150,6 +156,7 @@ typedef struct {
 
     // rusEFI-compatible wall wetting
     wall_wetting_t wall_wetting;
+    float fuelled_fraction;      // Share of cylinders fuelled (DFCO, 1 = all)
 
     // Corrections
     float clt_correction;        // Coolant temp correction
@@ -158,11 +165,11 @@ typedef struct {
     float o2_correction;         // Closed-loop O2 correction
 
     // Sequential/Batch injection state (per-cylinder)
-    uint32_t cylinder_pulse_us[8];  // Individual cylinder pulse widths
+    uint32_t cylinder_pulse_us[ENGINE_MAX_CYLINDERS];  // Individual cylinder pulse widths
     uint8_t next_injection_cylinder; // Next cylinder to inject (sequential/batch)
 
     // Batch mode state
-    uint8_t batch_pairs[4][2];   // Cylinder pairs for batch injection
+    uint8_t batch_pairs[ENGINE_MAX_BATCH_PAIRS][2];  // Cylinder pairs for batch injection
     uint8_t num_batch_pairs;     // Number of pairs (num_cylinders / 2)
 } fuel_control_t;
 
@@ -170,16 +177,32 @@ typedef struct {
 // Ignition Control
 //=============================================================================
 
-// Dwell time table (rusEFI-compatible)
+// Ignition output (coil) modes (rusEFI-compatible)
+typedef enum {
+    IGNITION_MODE_COP = 0,           // One coil per cylinder (needs cam phase)
+    IGNITION_MODE_WASTED_SPARK = 1,  // Paired cylinders 360° apart share a spark
+    IGNITION_MODE_DISTRIBUTOR = 2,   // Single coil feeding a distributor
+    IGNITION_MODE_COUNT
+} ignition_mode_t;
+
+// Dwell time table (rusEFI-compatible), battery voltage x RPM
 typedef struct {
     float voltage[8];            // Battery voltage breakpoints (V)
-    float dwell_us[8];           // Dwell time at each voltage (µs)
+    float rpm[8];                // RPM breakpoints
+    float dwell_us[8][8];        // Dwell time [voltage][rpm] (µs)
 } dwell_table_t;
 
 typedef struct {
     uint8_t base_timing_deg;     // Base timing (degrees BTDC)
-    float timing_table[16][16];  // Timing advance table
-    uint16_t dwell_time_us;      // Coil dwell time (µs)
+    float timing_table[16][16];  // Timing advance table (E0 with flex fuel)
+    const float (*ethanol_timing_table)[16];  // Blended in by fuel.ethanol_blend (may be NULL)
+    uint16_t dwell_time_us;      // Coil dwell time (µs), after duty limit
+    uint16_t dwell_angle_deg;    // Dwell in crank degrees (once per cycle)
+    float max_dwell_duty;        // Max coil on-time fraction (0-1)
+    bool dwell_limited;          // Dwell shortened by the duty limiter
+
+    // Coil wiring (COP/wasted spark/distributor)
+    ignition_mode_t ignition_mode;
 
     // rusEFI-compatible dwell scheduling
     dwell_table_t dwell_table;
@@ -190,7 +213,7 @@ typedef struct {
     float knock_retard;          // Knock sensor retard
 
     // Sequential ignition state (per-cylinder)
-    uint8_t cylinder_timing_deg[8];  // Individual cylinder timing
+    uint8_t cylinder_timing_deg[ENGINE_MAX_CYLINDERS];  // Individual cylinder timing
     uint8_t next_spark_cylinder;     // Next cylinder to spark
 } ignition_control_t;
 
@@ -317,16 +340,32 @@ float calculate_injector_latency(const injector_latency_table_t* table,
                                  float battery_voltage);
 
 /**
- * @brief Calculate dwell time based on battery voltage
+ * @brief Calculate dwell time based on battery voltage and RPM
  *
- * Ensures proper coil saturation across voltage range
+ * Ensures proper coil saturation across voltage and RPM range
+ * (bilinear interpolation, clamped at the table edges)
  *
  * @param table Pointer to dwell table
  * @param battery_voltage Current battery voltage
+ * @param rpm Engine speed
  * @return Dwell time in microseconds
  */
 float calculate_dwell_time(const dwell_table_t* table,
-                          float battery_voltage);
+                          float battery_voltage,
+                          float rpm);
+
+/**
+ * @brief Update dwell time and dwell angle for the next engine cycle
+ *
+ * Looks up the dwell table once and limits it to max_dwell_duty of the
+ * time between two sparks on the same coil, so coils never overlap and
+ * the spark is never delayed waiting for saturation.
+ *
+ * @param ecu Pointer to ECU state
+ * @param coil_period_deg Crank degrees between sparks on one coil
+ *                        (720 COP, 360 wasted spark, 720/n distributor)
+ */
+void update_dwell(ecu_state_t* ecu, uint16_t coil_period_deg);
 
 /**
  * @brief Update wall wetting compensation
@@ -364,6 +403,18 @@ void update_closed_loop_fuel(closed_loop_fuel_t* cl, float target_afr,
  */
 void diagnose_sensors(sensor_data_t* sensors);
 
+/**
+ * @brief TDC angle of a firing slot
+ *
+ * Even spacing (slot * 720 / num_cylinders) plus the slot's odd-fire
+ * offset, normalized to 0-720°.
+ *
+ * @param config Engine configuration
+ * @param slot Firing slot (0-based)
+ * @return TDC angle in crank degrees
+ */
+float engine_slot_tdc_angle(const engine_config_t* config, uint8_t slot);
+
 /**
  * @brief Calculate sequential injection timing
  *
@@ -430,11 +481,15 @@ float calculate_injection_timing_for_mode(ecu_state_t* ecu,
  *
  * Bit positions correspond to cylinder numbers (bit 0 = cylinder 0, etc.)
  *
+ * @deprecated Polling with a ±5° window skips events at high RPM and can
+ * double-fire at low RPM. Use the angle dispatcher (angle_dispatcher.h),
+ * which arms each event exactly once per cycle from the tooth handler.
+ *
  * @param ecu Pointer to ECU state
  * @param crank_angle Current crank angle (0-720°)
  * @return Bitmask of injectors to fire (bit set = fire injector)
  */
-uint8_t get_injectors_to_fire(ecu_state_t* ecu, float crank_angle);
+cylinder_mask_t get_injectors_to_fire(ecu_state_t* ecu, float crank_angle);
 
 /**
  * @brief Get injection mode name as string
@@ -444,4 +499,12 @@ uint8_t get_injectors_to_fire(ecu_state_t* ecu, float crank_angle);
  */
 const char* get_injection_mode_name(injection_mode_t mode);
 
+/**
+ * @brief Get ignition mode name as string
+ *
+ * @param mode Ignition mode enum
+ * @return Mode name string
+ */
+const char* get_ignition_mode_name(ignition_mode_t mode);
+
 #endif // ENGINE_CONTROL_H
@@ -0,0 +1,448 @@
+/**
+ * @file engine_layout.h
+ * @brief Compile-time engine layouts (C++ only)
+ *
+ * engine_config_t is runtime data, so every per-cylinder loop in
+ * engine_control.c runs to a variable count and divides by num_cylinders.
+ * For a firmware built for one engine, EngineLayout takes the crank wheel
+ * and the firing order as template parameters and resolves at compile
+ * time:
+ * - per-slot injection angles, COP / wasted-spark coil masks and
+ *   batch pair masks
+ * - per-slot event tables with the crank tooth each event is anchored to
+ *   and the angle offset from that tooth
+ * - unrolled drop-in versions of calculate_injection_timing(),
+ *   init_batch_injection_pairs() and get_injectors_to_fire() that return
+ *   the same values as the runtime functions for the same engine
+ *
+ * Slot n is the cylinder whose TDC is at n * 720 / num_cylinders, as in
+ * engine_control.c and ignition_coils.h; FiringOrder gives the physical
+ * cylinder (1-based) in each slot. Layouts are even-fire: they match the
+ * runtime functions when engine_config_t.tdc_offset_deg is all zero.
+ *
+ * The runtime path is unchanged and remains the default: C modules and
+ * builds that load the engine from config keep using engine_config_t.
+ * engine_layout_benchmark() measures both paths on the target.
+ *
+ * Usage:
+ *   typedef EngineLayout<36, 1, 1, 3, 4, 2> Engine;   // 36-1, 1-3-4-2
+ *   float angle = Engine::calculate_injection_timing(cyl);
+ *
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef ENGINE_LAYOUT_H
+#define ENGINE_LAYOUT_H
+
+#ifndef __cplusplus
+#error "engine_layout.h is C++ only; C modules use engine_config_t"
+#endif
+
+#include <stdint.h>
+#include <string.h>
+extern "C" {
+#include "engine_control.h"
+#include "cycle_counter_k64.h"
+}
+
+/**
+ * @brief Crank angle window of get_injectors_to_fire() (degrees)
+ */
+#define ENGINE_LAYOUT_FIRE_WINDOW_DEG   5.0f
+
+/**
+ * @brief Event anchored to a crank tooth
+ */
+struct layout_event_t {
+    float angle;                    ///< Cycle angle (0-720°)
+    uint8_t slot;                   ///< Firing-order slot
+    uint8_t cylinder;               ///< Physical cylinder (1-based)
+    uint8_t revolution;             ///< 0 = first crank turn, 1 = second
+    uint8_t tooth;                  ///< Anchor tooth (0 = first after the gap)
+    float tooth_offset_deg;         ///< Angle after the anchor tooth
+};
+
+/**
+ * @brief Cycle counts (runtime vs specialized), per call
+ */
+struct engine_layout_bench_t {
+    uint32_t injection_timing_runtime;
+    uint32_t injection_timing_static;
+    uint32_t injectors_to_fire_runtime;
+    uint32_t injectors_to_fire_static;
+    uint32_t batch_pairs_runtime;
+    uint32_t batch_pairs_static;
+};
+
+namespace engine_layout_detail {
+
+template <uint8_t... I> struct Indices {};
+
+template <uint8_t N, uint8_t... I>
+struct MakeIndices : MakeIndices<(uint8_t)(N - 1), (uint8_t)(N - 1), I...> {};
+
+template <uint8_t... I>
+struct MakeIndices<0, I...> {
+    typedef Indices<I...> type;
+};
+
+constexpr bool cylinders_valid(uint8_t)
+{
+    return true;
+}
+
+template <typename... T>
+constexpr bool cylinders_valid(uint8_t n, uint8_t first, T... rest)
+{
+    return first >= 1 && first <= n && cylinders_valid(n, rest...);
+}
+
+inline cylinder_mask_t bit_or()
+{
+    return 0;
+}
+
+template <typename... T>
+inline cylinder_mask_t bit_or(cylinder_mask_t first, T... rest)
+{
+    return (cylinder_mask_t)(first | bit_or(rest...));
+}
+
+/**
+ * @brief Same window test as get_injectors_to_fire()
+ */
+inline bool in_window(float crank_angle, float event_angle)
+{
+    float diff = crank_angle - event_angle;
+    if (diff > 360.0f) diff -= 720.0f;
+    if (diff < -360.0f) diff += 720.0f;
+    return diff >= 0.0f && diff < ENGINE_LAYOUT_FIRE_WINDOW_DEG;
+}
+
+/**
+ * @brief Compile-time layout arithmetic
+ *
+ * Kept apart from EngineLayout so the constexpr functions are complete
+ * before the tables that use them are initialized (C++11).
+ */
+template <uint16_t CrankTeeth, uint16_t MissingTeeth, uint8_t... FiringOrder>
+struct LayoutMath {
+    static constexpr uint8_t num_cylinders = sizeof...(FiringOrder);
+    static constexpr uint16_t real_teeth = CrankTeeth - MissingTeeth;
+    static constexpr uint8_t num_batch_pairs = sizeof...(FiringOrder) / 2;
+
+    static constexpr float degrees_per_cylinder()
+    {
+        return 720.0f / num_cylinders;
+    }
+
+    static constexpr float degrees_per_tooth()
+    {
+        return 360.0f / CrankTeeth;
+    }
+
+    static constexpr uint8_t order_at(uint8_t slot)
+    {
+        return order_list(slot, FiringOrder...);
+    }
+
+    static constexpr uint8_t order_list(uint8_t)
+    {
+        return 1;
+    }
+
+    template <typename... T>
+    static constexpr uint8_t order_list(uint8_t slot, uint8_t first, T... rest)
+    {
+        return (slot == 0) ? first : order_list((uint8_t)(slot - 1), rest...);
+    }
+
+    /**
+     * @brief Injection angle of a slot, as calculate_injection_timing()
+     */
+    static constexpr float injection_angle(uint8_t slot)
+    {
+        return (slot * degrees_per_cylinder() - 180.0f < 0.0f) ?
+               slot * degrees_per_cylinder() - 180.0f + 720.0f :
+               slot * degrees_per_cylinder() - 180.0f;
+    }
+
+    static constexpr float tdc_angle(uint8_t slot)
+    {
+        return slot * degrees_per_cylinder();
+    }
+
+    /**
+     * @brief Last real tooth at or before an angle within one turn
+     */
+    static constexpr uint8_t anchor_tooth(float rev_angle)
+    {
+        return ((uint16_t)(rev_angle / degrees_per_tooth()) >= real_teeth) ?
+               (uint8_t)(real_teeth - 1) :
+               (uint8_t)(rev_angle / degrees_per_tooth());
+    }
+
+    static constexpr float rev_angle(float angle)
+    {
+        return (angle >= 360.0f) ? angle - 360.0f : angle;
+    }
+
+    static constexpr layout_event_t make_event(float angle, uint8_t slot)
+    {
+        return layout_event_t{
+            angle, slot, order_at(slot),
+            (uint8_t)(angle >= 360.0f ? 1 : 0),
+            anchor_tooth(rev_angle(angle)),
+            rev_angle(angle) - anchor_tooth(rev_angle(angle)) * degrees_per_tooth()
+        };
+    }
+
+    static constexpr cylinder_mask_t cop_mask(uint8_t slot)
+    {
+        return CYLINDER_BIT(order_at(slot) - 1);
+    }
+
+    /**
+     * @brief Wasted spark on COP coils, as ignition_coils.c (odd: COP)
+     */
+    static constexpr cylinder_mask_t wasted_spark_mask(uint8_t slot)
+    {
+        return (num_cylinders % 2 == 0) ?
+               (cylinder_mask_t)(cop_mask((uint8_t)(slot % num_batch_pairs)) |
+                                 cop_mask((uint8_t)(slot % num_batch_pairs + num_batch_pairs))) :
+               cop_mask(slot);
+    }
+
+    static constexpr cylinder_mask_t batch_mask(uint8_t pair)
+    {
+        return (cylinder_mask_t)(CYLINDER_BIT(pair) | CYLINDER_BIT(pair + num_batch_pairs));
+    }
+
+    static constexpr float batch_angle(uint8_t pair)
+    {
+        return pair * (360.0f / num_batch_pairs);
+    }
+};
+
+template <class Slots, uint16_t CrankTeeth, uint16_t MissingTeeth, uint8_t... FiringOrder>
+class LayoutImpl;
+
+template <uint8_t... S, uint16_t CrankTeeth, uint16_t MissingTeeth, uint8_t... FiringOrder>
+class LayoutImpl<Indices<S...>, CrankTeeth, MissingTeeth, FiringOrder...> {
+    typedef LayoutMath<CrankTeeth, MissingTeeth, FiringOrder...> M;
+    typedef typename MakeIndices<M::num_batch_pairs>::type Pairs;
+
+public:
+    static constexpr uint8_t num_cylinders = M::num_cylinders;
+    static constexpr uint16_t crank_teeth = CrankTeeth;
+    static constexpr uint16_t real_teeth = M::real_teeth;
+    static constexpr uint8_t num_batch_pairs = M::num_batch_pairs;
+    static constexpr cylinder_mask_t all_injectors = CYLINDER_MASK_ALL(M::num_cylinders);
+
+    static_assert(sizeof...(FiringOrder) >= 1 &&
+                  sizeof...(FiringOrder) <= ENGINE_MAX_CYLINDERS,
+                  "1 to ENGINE_MAX_CYLINDERS cylinders (mask width, fuel_control_t arrays)");
+    static_assert(CrankTeeth > MissingTeeth, "Crank wheel needs real teeth");
+    static_assert(cylinders_valid(sizeof...(FiringOrder), FiringOrder...),
+                  "Firing order entries must be 1..num_cylinders");
+
+    // Per-slot tables, resolved at compile time
+    static constexpr uint8_t firing_order[sizeof...(S)] = { FiringOrder... };
+    static constexpr float injection_angles[sizeof...(S)] = { M::injection_angle(S)... };
+    static constexpr layout_event_t injection_events[sizeof...(S)] = {
+        M::make_event(M::injection_angle(S), S)... };
+    static constexpr layout_event_t tdc_events[sizeof...(S)] = {
+        M::make_event(M::tdc_angle(S), S)... };
+    static constexpr cylinder_mask_t cop_masks[sizeof...(S)] = { M::cop_mask(S)... };
+    static constexpr cylinder_mask_t wasted_spark_masks[sizeof...(S)] = { M::wasted_spark_mask(S)... };
+
+    //=========================================================================
+    // Drop-in replacements for the runtime functions
+    //=========================================================================
+
+    /**
+     * @brief calculate_injection_timing() for this layout
+     */
+    static float calculate_injection_timing(uint8_t slot)
+    {
+        return (slot < num_cylinders) ? injection_angles[slot] : 0.0f;
+    }
+
+    /**
+     * @brief init_batch_injection_pairs() for this layout
+     */
+    static void init_batch_injection_pairs(ecu_state_t* ecu)
+    {
+        if (ecu == NULL) {
+            return;
+        }
+
+        ecu->fuel.num_batch_pairs = num_batch_pairs;
+        write_pairs(ecu, Pairs());
+    }
+
+    /**
+     * @brief get_injectors_to_fire() for this layout (batch pairs as set
+     * by init_batch_injection_pairs())
+     */
+    static cylinder_mask_t get_injectors_to_fire(const ecu_state_t* ecu, float crank_angle)
+    {
+        if (ecu == NULL) {
+            return 0;
+        }
+
+        switch (ecu->fuel.injection_mode) {
+            case INJECTION_MODE_SEQUENTIAL:
+                return bit_or((cylinder_mask_t)(in_window(crank_angle, M::injection_angle(S)) ?
+                                                CYLINDER_BIT(S) : 0)...);
+
+            case INJECTION_MODE_BATCH:
+                return batch_fire_mask(crank_angle, Pairs());
+
+            case INJECTION_MODE_SIMULTANEOUS:
+                return (crank_angle < ENGINE_LAYOUT_FIRE_WINDOW_DEG) ? all_injectors : 0;
+
+            case INJECTION_MODE_SINGLE_POINT:
+                return (crank_angle < ENGINE_LAYOUT_FIRE_WINDOW_DEG) ? 0x01 : 0;
+
+            default:
+                return 0;
+        }
+    }
+
+private:
+    template <uint8_t... P>
+    static void write_pairs(ecu_state_t* ecu, Indices<P...>)
+    {
+        int expand[] = { 0, ((ecu->fuel.batch_pairs[P][0] = P),
+                             (ecu->fuel.batch_pairs[P][1] = (uint8_t)(P + num_batch_pairs)), 0)... };
+        (void)expand;
+    }
+
+    template <uint8_t... P>
+    static cylinder_mask_t batch_fire_mask(float crank_angle, Indices<P...>)
+    {
+        return bit_or((cylinder_mask_t)((pair_due(crank_angle, M::batch_angle(P)) ||
+                                         pair_due(crank_angle, M::batch_angle(P) + 360.0f)) ?
+                                        M::batch_mask(P) : 0)...);
+    }
+
+    static bool pair_due(float crank_angle, float pair_angle)
+    {
+        float diff = crank_angle - pair_angle;
+        return diff >= 0.0f && diff < ENGINE_LAYOUT_FIRE_WINDOW_DEG;
+    }
+};
+
+// Out-of-class definitions (tables indexed at run time are odr-used)
+template <uint8_t... S, uint16_t T, uint16_t N, uint8_t... F>
+constexpr uint8_t LayoutImpl<Indices<S...>, T, N, F...>::firing_order[];
+template <uint8_t... S, uint16_t T, uint16_t N, uint8_t... F>
+constexpr float LayoutImpl<Indices<S...>, T, N, F...>::injection_angles[];
+template <uint8_t... S, uint16_t T, uint16_t N, uint8_t... F>
+constexpr layout_event_t LayoutImpl<Indices<S...>, T, N, F...>::injection_events[];
+template <uint8_t... S, uint16_t T, uint16_t N, uint8_t... F>
+constexpr layout_event_t LayoutImpl<Indices<S...>, T, N, F...>::tdc_events[];
+template <uint8_t... S, uint16_t T, uint16_t N, uint8_t... F>
+constexpr cylinder_mask_t LayoutImpl<Indices<S...>, T, N, F...>::cop_masks[];
+template <uint8_t... S, uint16_t T, uint16_t N, uint8_t... F>
+constexpr cylinder_mask_t LayoutImpl<Indices<S...>, T, N, F...>::wasted_spark_masks[];
+
+} // namespace engine_layout_detail
+
+/**
+ * @brief Engine layout fixed at compile time
+ *
+ * @tparam CrankTeeth Crank wheel tooth positions (e.g. 36 for 36-1)
+ * @tparam MissingTeeth Missing teeth at the end of the wheel
+ * @tparam FiringOrder Physical cylinder (1-based) of each slot
+ */
+template <uint16_t CrankTeeth, uint16_t MissingTeeth, uint8_t... FiringOrder>
+class EngineLayout : public engine_layout_detail::LayoutImpl<
+    typename engine_layout_detail::MakeIndices<sizeof...(FiringOrder)>::type,
+    CrankTeeth, MissingTeeth, FiringOrder...> {
+};
+
+//=============================================================================
+// Benchmark
+//=============================================================================
+
+/**
+ * @brief Measure the runtime and specialized paths for one layout
+ *
+ * ecu->config must describe the same engine (num_cylinders). Cycle counts
+ * are per call, averaged over a sweep of cylinders / crank angles and
+ * including call overhead. The ECU injection mode and batch pairs are
+ * restored afterwards.
+ *
+ * @param ecu ECU state
+ * @param bench Receives the cycle counts
+ * @return true on success, false without a cycle counter (host build)
+ */
+template <class Layout>
+bool engine_layout_benchmark(ecu_state_t* ecu, engine_layout_bench_t* bench)
+{
+    if (ecu == NULL || bench == NULL || ecu->config.num_cylinders != Layout::num_cylinders) {
+        return false;
+    }
+
+    memset(bench, 0, sizeof(engine_layout_bench_t));
+
+#if CYCLE_COUNTER_AVAILABLE
+    const uint16_t sweep = 720;
+    const injection_mode_t mode = ecu->fuel.injection_mode;
+    volatile uint32_t sink = 0;
+    uint32_t start;
+
+    cycle_counter_enable();
+
+    start = cycle_counter_read();
+    for (uint16_t i = 0; i < sweep; i++) {
+        sink += (uint32_t)calculate_injection_timing(ecu, (uint8_t)(i % Layout::num_cylinders));
+    }
+    bench->injection_timing_runtime = (cycle_counter_read() - start) / sweep;
+
+    start = cycle_counter_read();
+    for (uint16_t i = 0; i < sweep; i++) {
+        sink += (uint32_t)Layout::calculate_injection_timing((uint8_t)(i % Layout::num_cylinders));
+    }
+    bench->injection_timing_static = (cycle_counter_read() - start) / sweep;
+
+    ecu->fuel.injection_mode = INJECTION_MODE_SEQUENTIAL;
+    start = cycle_counter_read();
+    for (uint16_t i = 0; i < sweep; i++) {
+        sink += get_injectors_to_fire(ecu, (float)i);
+    }
+    bench->injectors_to_fire_runtime = (cycle_counter_read() - start) / sweep;
+
+    start = cycle_counter_read();
+    for (uint16_t i = 0; i < sweep; i++) {
+        sink += Layout::get_injectors_to_fire(ecu, (float)i);
+    }
+    bench->injectors_to_fire_static = (cycle_counter_read() - start) / sweep;
+    ecu->fuel.injection_mode = mode;
+
+    start = cycle_counter_read();
+    for (uint16_t i = 0; i < sweep; i++) {
+        init_batch_injection_pairs(ecu);
+    }
+    bench->batch_pairs_runtime = (cycle_counter_read() - start) / sweep;
+
+    start = cycle_counter_read();
+    for (uint16_t i = 0; i < sweep; i++) {
+        Layout::init_batch_injection_pairs(ecu);
+    }
+    bench->batch_pairs_static = (cycle_counter_read() - start) / sweep;
+
+    (void)sink;
+    return true;
+#else
+    return false;
+#endif
+}
+
+#endif // ENGINE_LAYOUT_H
@@ -13,10 +13,12 @@
 
 #include "event_scheduler.h"
 #include "hardware_scheduler_k64.h"
+#include "compiler_k64.h"
+#include "event_trace.h"
 #include <string.h>
 
 // Global hardware scheduler instance
-static hw_scheduler_t hw_sched;
+FAST_DATA static hw_scheduler_t hw_sched;
 
 // Minimum RPM for scheduling (prevents overflow)
 #define MIN_RPM_FOR_SCHEDULING   100
@@ -27,7 +29,7 @@ static hw_scheduler_t hw_sched;
  * Called by hardware scheduler interrupt when event fires.
  * Executes the actual event action.
  */
-static void hw_event_callback(void* context)
+FAST_CODE static void hw_event_callback(void* context)
 {
     scheduled_event_t* event = (scheduled_event_t*)context;
 
@@ -35,6 +37,10 @@ static void hw_event_callback(void* context)
         // Fire the actual event action
         event->action(event->cylinder);
 
+        int32_t late_us = (int32_t)(hw_scheduler_micros() - event->scheduled_time_us);
+        event_trace_record(EVENT_TRACE_FIRED, event->cylinder,
+                           (late_us < 0) ? 0 : (late_us > 0xFFFF) ? 0xFFFF : (uint16_t)late_us);
+
         // Mark event as no longer active
         event->active = false;
         event->hw_event_id = -1;
@@ -178,6 +184,7 @@ bool scheduler_add_event(event_scheduler_t* sched,
                 // Update statistics
                 sched->num_active_events++;
                 sched->events_scheduled++;
+                event_trace_record(EVENT_TRACE_ARMED, cylinder, angle);
 
                 return true;
             } else {
@@ -321,3 +328,11 @@ uint32_t scheduler_get_us_per_degree(const event_scheduler_t* sched)
 
     return sched->us_per_degree;
 }
+
+/**
+ * @brief Get the hardware scheduler behind the angle scheduler
+ */
+hw_scheduler_t* scheduler_get_hw_scheduler(void)
+{
+    return &hw_sched;
+}
@@ -23,6 +23,8 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "hardware_scheduler_k64.h"
+#include "engine_capacity.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -31,12 +33,19 @@ extern "C" {
 /**
  * @brief Maximum number of scheduled events
  *
- * Typical usage:
- * - 4 cylinders: 4 injection + 4 ignition = 8 events
- * - 6 cylinders: 6 injection + 6 ignition = 12 events
- * - 8 cylinders: 8 injection + 8 ignition = 16 events
+ * Two-stage injection (open + close) and ignition (dwell + spark) per
+ * cylinder, sized from the build capacity (engine_capacity.h):
+ * - 8 cylinders: 32 events
+ * - 12 cylinders: 48 events
+ * - 16 cylinders: 64 events
+ *
+ * Each armed event also holds a hardware timer channel until it fires,
+ * and scheduler_add_event() fails when none is free: no more than
+ * HW_SCHEDULER_MAX_EVENTS events can be pending at once, whatever the
+ * size of this queue. The host simulations (test/sim/engine_sim.c) cap
+ * their queue at that limit.
  */
-#define MAX_SCHEDULED_EVENTS  16
+#define MAX_SCHEDULED_EVENTS  ENGINE_MAX_SCHEDULED_EVENTS
 
 /**
  * @brief Full crank rotation angle (720° for 4-stroke)
@@ -50,7 +59,7 @@ extern "C" {
  */
 typedef struct {
     uint16_t trigger_angle;           ///< Crank angle to trigger (0-720°)
-    uint8_t cylinder;                 ///< Cylinder number (0-7)
+    uint8_t cylinder;                 ///< Cylinder number (0-based)
     void (*action)(uint8_t cyl);      ///< Action callback to execute
     bool active;                      ///< Event is currently scheduled
     uint32_t scheduled_time_us;       ///< Calculated execution time (µs)
@@ -129,7 +138,7 @@ void scheduler_update_angle(event_scheduler_t* sched,
  *
  * @param sched Pointer to scheduler structure
  * @param angle Target crank angle (0-720°)
- * @param cylinder Cylinder number (0-7)
+ * @param cylinder Cylinder number (0-based)
  * @param action Callback function to execute
  * @param current_time_us Current timestamp in microseconds
  * @return true if scheduled successfully, false if queue full
@@ -168,7 +177,7 @@ void scheduler_clear_events(event_scheduler_t* sched);
  * Useful when disabling a cylinder or changing timing.
  *
  * @param sched Pointer to scheduler structure
- * @param cylinder Cylinder number (0-7)
+ * @param cylinder Cylinder number (0-based)
  */
 void scheduler_remove_cylinder_events(event_scheduler_t* sched,
                                      uint8_t cylinder);
@@ -226,6 +235,16 @@ uint16_t scheduler_get_current_angle(const event_scheduler_t* sched);
  */
 uint32_t scheduler_get_us_per_degree(const event_scheduler_t* sched);
 
+/**
+ * @brief Get the hardware scheduler behind the angle scheduler
+ *
+ * For time-based sequences that must share the same FTM channels and
+ * ISR (e.g. multi-spark bursts).
+ *
+ * @return Hardware scheduler instance
+ */
+hw_scheduler_t* scheduler_get_hw_scheduler(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,431 @@
+/**
+ * @file ext_sensors.c
+ * @brief SPI thermocouple converters and external ADC implementation
+ * @version 1.1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "ext_sensors.h"
+#include "hardware_scheduler_k64.h"
+#include "compiler_k64.h"
+#include <string.h>
+
+//=============================================================================
+// Device Definitions
+//=============================================================================
+
+#define MAX31855_FRAME_SIZE       4
+#define MAX31855_FAULT            0x00010000
+#define MAX31855_FAULT_OC         0x00000001
+#define MAX31855_FAULT_SCG        0x00000002
+#define MAX31855_FAULT_SCV        0x00000004
+
+#define MAX31856_FRAME_SIZE       5       ///< Address + LTCBH, LTCBM, LTCBL, SR
+#define MAX31856_REG_CR0          0x00
+#define MAX31856_REG_LTCBH        0x0C
+#define MAX31856_WRITE            0x80
+#define MAX31856_CR0_AUTO         0x80    ///< Continuous conversion
+#define MAX31856_CR0_OC_DETECT    0x10    ///< Open circuit detection (< 5 kOhm)
+#define MAX31856_SR_OPEN          0x01
+#define MAX31856_SR_OVUV          0x02
+
+#define MCP3208_FRAME_SIZE        3
+#define MCP3208_START_SINGLE      0x06    ///< Start bit + single-ended
+
+// Every slot could be its own device; the decoder must be able to select
+// them all, and a full EGT set still leaves a slot for the ADC
+_Static_assert(EXT_SENSORS_MAX_SLOTS <= SPI_NUM_DECODED_PCS,
+               "more slots than decoded chip selects");
+_Static_assert(EXT_SENSORS_MAX_EGT < EXT_SENSORS_MAX_SLOTS,
+               "no slot left for the ADC with every EGT fitted");
+
+//=============================================================================
+// Private Helper Functions
+//=============================================================================
+
+/**
+ * @brief CTAR of a device in the chain, allocating CTAR1 for a second setting
+ *
+ * @return 0 or 1, or -1 if the device cannot join the chain
+ */
+static int8_t assign_ctar(ext_sensors_t* es, const spi_device_t* device)
+{
+    if (device->pcs == SPI_PCS_NONE) {
+        return -1;
+    }
+    if (es->num_ctars > 0 && device->port != es->ctar_devices[0]->port) {
+        return -1;
+    }
+
+    // One chip select per device: a second device on it would be read twice
+    for (uint8_t i = 0; i < es->num_slots; i++) {
+        if (es->slots[i].device != device && es->slots[i].device->pcs == device->pcs) {
+            return -1;
+        }
+    }
+
+    for (uint8_t i = 0; i < es->num_ctars; i++) {
+        if (es->ctar_devices[i]->ctar == device->ctar) {
+            return (int8_t)i;
+        }
+    }
+
+    if (es->num_ctars >= EXT_SENSORS_MAX_CTARS) {
+        return -1;
+    }
+    es->ctar_devices[es->num_ctars] = device;
+    return (int8_t)es->num_ctars++;
+}
+
+/**
+ * @brief Rebuild the sweep chain: every slot's frame, EOQ on the last byte
+ */
+static void build_sweep(ext_sensors_t* es)
+{
+    uint16_t n = 0;
+
+    for (uint8_t i = 0; i < es->num_slots; i++) {
+        ext_sensor_slot_t* slot = &es->slots[i];
+        slot->frame_offset = (uint8_t)n;
+
+        for (uint8_t b = 0; b < slot->frame_length; b++) {
+            bool frame_end = (b == slot->frame_length - 1);
+            bool chain_end = frame_end && (i == es->num_slots - 1);
+            es->sweep_cmd[n++] = spi_pushr_command(slot->device, slot->ctas, slot->tx[b],
+                                                   !frame_end, chain_end);
+        }
+    }
+
+    es->sweep.device = es->ctar_devices[0];
+    es->sweep.ctar1 = (es->num_ctars > 1) ? es->ctar_devices[1]->ctar : 0;
+    es->sweep.cmd = es->sweep_cmd;
+    es->sweep.rx = es->sweep_rx;
+    es->sweep.length = n;
+}
+
+/**
+ * @brief Build the MAX31856 configuration chain (CR0, CR1 per converter)
+ *
+ * @return false if there is nothing to configure
+ */
+static bool build_config(ext_sensors_t* es)
+{
+    uint8_t converters = 0;
+    for (uint8_t i = 0; i < es->num_slots; i++) {
+        if (es->slots[i].type == EXT_DEVICE_MAX31856) {
+            converters++;
+        }
+    }
+    if (converters == 0) {
+        return false;
+    }
+
+    uint16_t n = 0;
+    for (uint8_t i = 0; i < es->num_slots; i++) {
+        const ext_sensor_slot_t* slot = &es->slots[i];
+        if (slot->type != EXT_DEVICE_MAX31856) {
+            continue;
+        }
+
+        // One auto-increment write from CR0, EOQ after the last converter
+        const uint8_t frame[3] = {
+            MAX31856_WRITE | MAX31856_REG_CR0,
+            MAX31856_CR0_AUTO | MAX31856_CR0_OC_DETECT,
+            (uint8_t)(slot->tc_type & 0x0F),
+        };
+        converters--;
+        for (uint8_t b = 0; b < sizeof(frame); b++) {
+            bool frame_end = (b == sizeof(frame) - 1);
+            es->config_cmd[n++] = spi_pushr_command(slot->device, slot->ctas, frame[b],
+                                                    !frame_end, frame_end && converters == 0);
+        }
+    }
+
+    es->config.device = es->ctar_devices[0];
+    es->config.ctar1 = (es->num_ctars > 1) ? es->ctar_devices[1]->ctar : 0;
+    es->config.cmd = es->config_cmd;
+    es->config.rx = NULL;
+    es->config.length = n;
+    return true;
+}
+
+static bool xfer_busy(const spi_transaction_t* xfer)
+{
+    return xfer->status == SPI_XFER_QUEUED || xfer->status == SPI_XFER_ACTIVE;
+}
+
+static int8_t add_slot(ext_sensors_t* es, const spi_device_t* device,
+                       ext_device_type_t type, uint8_t frame_length)
+{
+    if (es == NULL || device == NULL || es->num_slots >= EXT_SENSORS_MAX_SLOTS ||
+        xfer_busy(&es->sweep) || xfer_busy(&es->config)) {
+        return -1;
+    }
+
+    int8_t ctas = assign_ctar(es, device);
+    if (ctas < 0) {
+        return -1;
+    }
+
+    uint8_t index = es->num_slots;
+    ext_sensor_slot_t* slot = &es->slots[index];
+
+    memset(slot, 0, sizeof(ext_sensor_slot_t));
+    slot->type = type;
+    slot->device = device;
+    slot->ctas = (uint8_t)ctas;
+    slot->ts_channel = TS_CHANNEL_COUNT;
+    slot->frame_length = frame_length;
+
+    memset(&es->channels[index], 0, sizeof(ext_sensor_channel_t));
+    es->num_slots++;
+    return (int8_t)index;
+}
+/**
+ * @brief Decode every slot into the channel store (SPI completion ISR)
+ */
+FAST_CODE static void sweep_done(spi_transaction_t* xfer, void* context)
+{
+    (void)xfer;
+    ext_sensors_t* es = (ext_sensors_t*)context;
+    uint32_t now_us = hw_scheduler_micros();
+
+    for (uint8_t i = 0; i < es->num_slots; i++) {
+        const ext_sensor_slot_t* slot = &es->slots[i];
+        const uint8_t* rx = &es->sweep_rx[slot->frame_offset];
+        ext_sensor_channel_t* ch = &es->channels[i];
+        float value = 0.0f;
+        uint8_t fault;
+
+        switch (slot->type) {
+            case EXT_DEVICE_MAX31855:
+                fault = max31855_decode(rx, &value, &ch->cold_junction);
+                break;
+
+            case EXT_DEVICE_MAX31856:
+                fault = max31856_decode(rx, &value);
+                break;
+
+            case EXT_DEVICE_MCP3208:
+            default:
+                fault = 0;
+                value = (float)mcp3208_decode(rx) * slot->scale + slot->offset;
+                break;
+        }
+
+        // A faulted reading keeps the last good value and its timestamp
+        ch->fault = fault;
+        if (fault == 0) {
+            ch->value = value;
+            ch->timestamp_us = now_us;
+            ch->valid = true;
+        }
+    }
+
+    es->sweeps++;
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+bool ext_sensors_init(ext_sensors_t* es)
+{
+    if (es == NULL) {
+        return false;
+    }
+
+    memset(es, 0, sizeof(ext_sensors_t));
+    es->sweep.priority = SPI_PRIORITY_NORMAL;
+    es->sweep.callback = sweep_done;
+    es->sweep.context = es;
+    es->config.priority = SPI_PRIORITY_NORMAL;
+    return true;
+}
+
+int8_t ext_sensors_add_thermocouple(ext_sensors_t* es, const spi_device_t* device,
+                                    ext_device_type_t type, uint8_t tc_type,
+                                    uint8_t cylinder)
+{
+    if ((type != EXT_DEVICE_MAX31855 && type != EXT_DEVICE_MAX31856) ||
+        cylinder > EXT_SENSORS_MAX_EGT) {
+        return -1;
+    }
+
+    int8_t index = add_slot(es, device, type,
+                            (type == EXT_DEVICE_MAX31855) ? MAX31855_FRAME_SIZE : MAX31856_FRAME_SIZE);
+    if (index < 0) {
+        return -1;
+    }
+
+    ext_sensor_slot_t* slot = &es->slots[index];
+    slot->cylinder = cylinder;
+
+    if (type == EXT_DEVICE_MAX31856) {
+        // LTCBH..SR read; the configuration goes out with the next sweep
+        slot->tx[0] = MAX31856_REG_LTCBH;
+        slot->tc_type = tc_type;
+        es->config_pending = true;
+    }
+
+    build_sweep(es);
+    return index;
+}
+
+int8_t ext_sensors_add_adc(ext_sensors_t* es, const spi_device_t* device,
+                           uint8_t input, float scale, float offset,
+                           ts_channel_e ts_channel)
+{
+    if (input > 7) {
+        return -1;
+    }
+
+    int8_t index = add_slot(es, device, EXT_DEVICE_MCP3208, MCP3208_FRAME_SIZE);
+    if (index < 0) {
+        return -1;
+    }
+
+    ext_sensor_slot_t* slot = &es->slots[index];
+    slot->input = input;
+    slot->scale = scale;
+    slot->offset = offset;
+    slot->ts_channel = ts_channel;
+
+    // Fixed command: start, single-ended, input D2 / D1 D0
+    slot->tx[0] = (uint8_t)(MCP3208_START_SINGLE | ((input >> 2) & 0x01));
+    slot->tx[1] = (uint8_t)((input & 0x03) << 6);
+    slot->tx[2] = 0x00;
+
+    build_sweep(es);
+    return index;
+}
+
+bool ext_sensors_sweep(ext_sensors_t* es)
+{
+    if (es == NULL || es->num_slots == 0) {
+        return false;
+    }
+
+    if (xfer_busy(&es->sweep) || xfer_busy(&es->config)) {
+        es->overruns++;
+        return false;
+    }
+
+    // Same priority runs FIFO: the configuration precedes the reads
+    if (es->config_pending) {
+        if (build_config(es) && !spi_bus_submit(&es->config)) {
+            es->submit_errors++;
+            return false;
+        }
+        es->config_pending = false;
+    }
+
+    // One transaction: queued whole or not at all
+    if (!spi_bus_submit(&es->sweep)) {
+        es->submit_errors++;
+        return false;
+    }
+
+    return true;
+}
+
+void ext_sensors_publish(const ext_sensors_t* es)
+{
+    if (es == NULL) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < es->num_slots; i++) {
+        const ext_sensor_slot_t* slot = &es->slots[i];
+        const ext_sensor_channel_t* ch = &es->channels[i];
+
+        ts_channel_e target = (slot->cylinder != 0) ?
+                              (ts_channel_e)(TS_CHANNEL_EGT_1 + slot->cylinder - 1) :
+                              slot->ts_channel;
+        if (target < TS_CHANNEL_COUNT) {
+            tunerstudio_set_channel(target, (ch->fault == 0 && ch->valid) ? ch->value : 0.0f);
+        }
+    }
+}
+
+const ext_sensor_channel_t* ext_sensors_egt(const ext_sensors_t* es, uint8_t cylinder)
+{
+    if (es == NULL || cylinder == 0) {
+        return NULL;
+    }
+
+    for (uint8_t i = 0; i < es->num_slots; i++) {
+        if (es->slots[i].cylinder == cylinder) {
+            return &es->channels[i];
+        }
+    }
+
+    return NULL;
+}
+
+//=============================================================================
+// Frame Decoders
+//=============================================================================
+
+uint8_t max31855_decode(const uint8_t rx[4], float* celsius, float* cold_junction)
+{
+    uint32_t raw = ((uint32_t)rx[0] << 24) | ((uint32_t)rx[1] << 16) |
+                   ((uint32_t)rx[2] << 8) | rx[3];
+
+    if (raw == 0xFFFFFFFF) {
+        return EXT_FAULT_NO_DEVICE;
+    }
+
+    // D31..D18: thermocouple, D15..D4: cold junction (signed, left-aligned)
+    *celsius = (float)((int32_t)raw >> 18) * 0.25f;
+    *cold_junction = (float)((int32_t)(raw << 16) >> 20) * 0.0625f;
+
+    if (!(raw & MAX31855_FAULT)) {
+        return 0;
+    }
+
+    uint8_t fault = 0;
+    if (raw & MAX31855_FAULT_OC) {
+        fault |= EXT_FAULT_OPEN;
+    }
+    if (raw & MAX31855_FAULT_SCG) {
+        fault |= EXT_FAULT_SHORT_GND;
+    }
+    if (raw & MAX31855_FAULT_SCV) {
+        fault |= EXT_FAULT_SHORT_VCC;
+    }
+    return fault ? fault : EXT_FAULT_RANGE;
+}
+
+uint8_t max31856_decode(const uint8_t rx[5], float* celsius)
+{
+    if (rx[1] == 0xFF && rx[2] == 0xFF && rx[3] == 0xFF && rx[4] == 0xFF) {
+        return EXT_FAULT_NO_DEVICE;
+    }
+
+    // 19-bit signed, left-aligned in LTCBH..LTCBL, 2^-7 °C per LSB
+    uint32_t raw = ((uint32_t)rx[1] << 24) | ((uint32_t)rx[2] << 16) | ((uint32_t)rx[3] << 8);
+    *celsius = (float)((int32_t)raw >> 13) * 0.0078125f;
+
+    uint8_t sr = rx[4];
+    uint8_t fault = 0;
+    if (sr & MAX31856_SR_OPEN) {
+        fault |= EXT_FAULT_OPEN;
+    }
+    if (sr & MAX31856_SR_OVUV) {
+        fault |= EXT_FAULT_SHORT_VCC;
+    }
+    if (sr & ~(MAX31856_SR_OPEN | MAX31856_SR_OVUV)) {
+        fault |= EXT_FAULT_RANGE;
+    }
+    return fault;
+}
+
+uint16_t mcp3208_decode(const uint8_t rx[3])
+{
+    // Null bit and B11..B8 in the second byte, B7..B0 in the third
+    return (uint16_t)(((rx[1] & 0x0F) << 8) | rx[2]);
+}
@@ -0,0 +1,245 @@
+/**
+ * @file ext_sensors.h
+ * @brief SPI thermocouple converters and external ADC (EGT, fuel pressure)
+ *
+ * Supported devices, all on the shared SPI bus (spi_bus_submit()):
+ * - MAX31855: read-only, 32-bit frame, 14-bit thermocouple (0.25°C)
+ * - MAX31856: configured once (auto conversion, thermocouple type), then
+ *   LTCBH..SR read in one 5-byte frame, 19-bit (0.0078°C)
+ * - MCP3208: 12-bit ADC; one 3-byte frame per input (the conversion
+ *   starts on chip select), scaled to engineering units
+ *
+ * Each slot is one device frame. All devices sit on DSPI hardware chip
+ * selects of one port, and the frames of all slots
+ * form a single command chain: PUSHR words carrying chip select, CTAR and
+ * CONT per byte, EOQ on the last. ext_sensors_sweep() queues that one
+ * transaction at SPI_PRIORITY_NORMAL, so a sweep is either queued whole
+ * or not at all, runs as one DMA transfer and costs one completion
+ * interrupt. Its callback decodes all slots and stores value, fault and
+ * a common timestamp in the channel store. A sweep still running at the
+ * next tick is skipped (overruns), so the tick rate adapts to a slow bus.
+ *
+ * SPI0 has six PCS pins (spi_device_use_pcs()), enough for five
+ * thermocouples and the ADC. A full EGT set (8 thermocouples + MCP3208)
+ * needs an external decoder on PCS0-4 strobed by PCS5
+ * (spi_bus_use_pcs_decoder(), spi_device_use_decoded_pcs()), e.g. a
+ * 74HC154 for 16 devices. The chain is the same either way.
+ *
+ * The DSPI has two CTARs, so the devices of a chain may use at most two
+ * distinct clock/mode settings (e.g. MAX31856 in mode 1 and MAX31855 and
+ * MCP3208 in mode 0 at a common clock).
+ *
+ * Thermocouple slots may carry a cylinder number; ext_sensors_publish()
+ * copies those to TS_CHANNEL_EGT_1.. and other slots to their own
+ * TunerStudio channel.
+ *
+ * @version 1.1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef EXT_SENSORS_H
+#define EXT_SENSORS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "spi_k64.h"
+#include "communication/tunerstudio/tunerstudio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EXT_SENSORS_MAX_SLOTS     12
+#define EXT_SENSORS_FRAME_SIZE    5       ///< Longest device frame (MAX31856)
+#define EXT_SENSORS_CHAIN_SIZE    (EXT_SENSORS_MAX_SLOTS * EXT_SENSORS_FRAME_SIZE)
+#define EXT_SENSORS_MAX_CTARS     2       ///< DSPI CTAR0/CTAR1
+#define EXT_SENSORS_MAX_EGT       8       ///< TS_CHANNEL_EGT_1..8 (> 5 needs a PCS decoder)
+
+// MAX31856 thermocouple types (CR1 TC_TYPE)
+#define MAX31856_TC_TYPE_B        0
+#define MAX31856_TC_TYPE_E        1
+#define MAX31856_TC_TYPE_J        2
+#define MAX31856_TC_TYPE_K        3
+#define MAX31856_TC_TYPE_N        4
+#define MAX31856_TC_TYPE_R        5
+#define MAX31856_TC_TYPE_S        6
+#define MAX31856_TC_TYPE_T        7
+
+// Fault bits (ext_sensor_channel_t.fault)
+#define EXT_FAULT_OPEN            0x01    ///< Thermocouple open circuit
+#define EXT_FAULT_SHORT_GND       0x02    ///< Short to GND
+#define EXT_FAULT_SHORT_VCC       0x04    ///< Short to VCC
+#define EXT_FAULT_RANGE           0x08    ///< Out of range / other converter fault
+#define EXT_FAULT_NO_DEVICE       0x10    ///< Bus stuck high or low (no device)
+
+/**
+ * @brief Device type of a slot
+ */
+typedef enum {
+    EXT_DEVICE_MAX31855 = 0,
+    EXT_DEVICE_MAX31856,
+    EXT_DEVICE_MCP3208,
+} ext_device_type_t;
+
+/**
+ * @brief Channel store entry (written from the SPI completion ISR)
+ */
+typedef struct {
+    float value;                      ///< °C for thermocouples, scaled units for ADC
+    float cold_junction;              ///< Converter die temperature (°C), thermocouples only
+    uint32_t timestamp_us;            ///< End of the sweep that produced value
+    uint8_t fault;                    ///< EXT_FAULT_* (0 = valid)
+    bool valid;                       ///< At least one good reading
+} ext_sensor_channel_t;
+
+/**
+ * @brief One device read per sweep
+ */
+typedef struct {
+    ext_device_type_t type;
+    const spi_device_t* device;
+    uint8_t ctas;                     ///< CTAR of the device in the chain
+    uint8_t input;                    ///< MCP3208 input (0-7)
+    uint8_t tc_type;                  ///< MAX31856 thermocouple type
+    uint8_t cylinder;                 ///< EGT cylinder (1-based, 0 = none)
+    ts_channel_e ts_channel;          ///< Published channel (TS_CHANNEL_COUNT = none)
+    float scale;                      ///< MCP3208: units per count
+    float offset;                     ///< MCP3208: units at 0 counts
+    uint8_t frame_offset;             ///< First byte of the frame in the chain
+    uint8_t frame_length;
+    uint8_t tx[EXT_SENSORS_FRAME_SIZE];
+} ext_sensor_slot_t;
+
+/**
+ * @brief External sensor state
+ */
+typedef struct {
+    ext_sensor_slot_t slots[EXT_SENSORS_MAX_SLOTS];
+    ext_sensor_channel_t channels[EXT_SENSORS_MAX_SLOTS];  ///< Same index as slots
+    uint8_t num_slots;
+
+    // Command chains: the sweep, and the MAX31856 configuration writes
+    const spi_device_t* ctar_devices[EXT_SENSORS_MAX_CTARS];
+    uint8_t num_ctars;
+    spi_transaction_t sweep;
+    uint32_t sweep_cmd[EXT_SENSORS_CHAIN_SIZE];
+    uint8_t sweep_rx[EXT_SENSORS_CHAIN_SIZE];
+    spi_transaction_t config;
+    uint32_t config_cmd[EXT_SENSORS_CHAIN_SIZE];
+    bool config_pending;              ///< MAX31856 added, configuration not queued yet
+
+    // Statistics
+    uint32_t sweeps;                  ///< Completed sweeps
+    uint32_t overruns;                ///< Ticks skipped (previous sweep still running)
+    uint32_t submit_errors;           ///< Sweeps not queued (bus queue full)
+} ext_sensors_t;
+
+/**
+ * @brief Initialize with no slots
+ *
+ * @param es External sensor state
+ * @return true on success
+ */
+bool ext_sensors_init(ext_sensors_t* es);
+
+/**
+ * @brief Add a thermocouple converter
+ *
+ * For a MAX31856 the configuration write (automatic conversion, tc_type)
+ * is queued by the next ext_sensors_sweep(), ahead of its reads.
+ *
+ * @param es External sensor state
+ * @param device SPI device on a hardware chip select (spi_device_init(),
+ *               spi_device_use_pcs() or spi_device_use_decoded_pcs();
+ *               mode 1 for MAX31856, mode 0 for MAX31855, <= 5 MHz)
+ * @param type EXT_DEVICE_MAX31855 or EXT_DEVICE_MAX31856
+ * @param tc_type MAX31856_TC_TYPE_* (ignored for MAX31855, fixed by part)
+ * @param cylinder EGT cylinder (1-based, 0 = not an EGT)
+ * @return Slot index, or -1 if full, invalid, on another port than the
+ *         other slots, on another device's chip select or needing a
+ *         third CTAR
+ */
+int8_t ext_sensors_add_thermocouple(ext_sensors_t* es, const spi_device_t* device,
+                                    ext_device_type_t type, uint8_t tc_type,
+                                    uint8_t cylinder);
+
+/**
+ * @brief Add one MCP3208 input
+ *
+ * @param es External sensor state
+ * @param device SPI device on a hardware chip select (mode 0, <= 2 MHz
+ *               at 5 V)
+ * @param input Single-ended input (0-7)
+ * @param scale Units per count (e.g. kPa per count for fuel pressure)
+ * @param offset Units at 0 counts
+ * @param ts_channel TunerStudio channel (TS_CHANNEL_COUNT = none)
+ * @return Slot index, or -1 if full, invalid, on another port than the
+ *         other slots, on another device's chip select or needing a
+ *         third CTAR
+ */
+int8_t ext_sensors_add_adc(ext_sensors_t* es, const spi_device_t* device,
+                           uint8_t input, float scale, float offset,
+                           ts_channel_e ts_channel);
+
+/**
+ * @brief Queue one read of every slot (call once per tick)
+ *
+ * @param es External sensor state
+ * @return true if a sweep was queued, false if the previous one is
+ *         still running, the bus queue is full or nothing is configured
+ */
+bool ext_sensors_sweep(ext_sensors_t* es);
+
+/**
+ * @brief Copy the channel store to TunerStudio (main loop)
+ *
+ * Channels with a fault publish 0.
+ *
+ * @param es External sensor state
+ */
+void ext_sensors_publish(const ext_sensors_t* es);
+
+/**
+ * @brief Latest EGT of a cylinder
+ *
+ * @param es External sensor state
+ * @param cylinder Cylinder (1-based)
+ * @return Channel, or NULL if no thermocouple is assigned to it
+ */
+const ext_sensor_channel_t* ext_sensors_egt(const ext_sensors_t* es, uint8_t cylinder);
+
+/**
+ * @brief Decode a MAX31855 frame
+ *
+ * @param rx 4 bytes as received
+ * @param celsius Thermocouple temperature
+ * @param cold_junction Internal temperature
+ * @return EXT_FAULT_* bits (0 = valid)
+ */
+uint8_t max31855_decode(const uint8_t rx[4], float* celsius, float* cold_junction);
+
+/**
+ * @brief Decode a MAX31856 LTCBH..SR read
+ *
+ * @param rx 5 bytes as received (rx[0] is the address phase)
+ * @param celsius Thermocouple temperature
+ * @return EXT_FAULT_* bits (0 = valid)
+ */
+uint8_t max31856_decode(const uint8_t rx[5], float* celsius);
+
+/**
+ * @brief Decode an MCP3208 single-ended conversion
+ *
+ * @param rx 3 bytes as received
+ * @return Conversion result (0-4095)
+ */
+uint16_t mcp3208_decode(const uint8_t rx[3]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EXT_SENSORS_H
@@ -0,0 +1,275 @@
+/**
+ * @file flex_fuel.c
+ * @brief Flex-fuel sensor decoding and blending implementation
+ *
+ * @version 1.1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "flex_fuel.h"
+#include "input_capture_k64.h"
+#include "compiler_k64.h"
+#include <string.h>
+
+// Fuel properties
+#define GASOLINE_STOICH_AFR     14.7f
+#define ETHANOL_STOICH_AFR      9.0f
+#define GASOLINE_DENSITY_G_CC   0.745f
+#define ETHANOL_DENSITY_G_CC    0.789f
+
+// Continental sensor fuel temperature: 1 ms = -40°C, 5 ms = 125°C
+#define FLEX_TEMP_MIN_US        1000.0f
+#define FLEX_TEMP_MAX_US        5000.0f
+#define FLEX_TEMP_MIN_C         -40.0f
+#define FLEX_TEMP_MAX_C         125.0f
+
+// Decoder state is dropped after this long without edges (16-bit wrap)
+#define FLEX_EDGE_STALE_MS      50
+
+// Sensor state for the capture callback (flex_fuel_attach())
+FAST_DATA static flex_fuel_t* g_flex = NULL;
+
+//=============================================================================
+// Private Helper Functions
+//=============================================================================
+
+static float clampf(float x, float lo, float hi)
+{
+    return (x < lo) ? lo : (x > hi) ? hi : x;
+}
+
+/**
+ * @brief Median of the filled part of a window
+ */
+static float median(const float* window, uint8_t count)
+{
+    float sorted[FLEX_MEDIAN_SIZE];
+    memcpy(sorted, window, count * sizeof(float));
+
+    for (uint8_t i = 1; i < count; i++) {
+        float v = sorted[i];
+        int8_t j = (int8_t)(i - 1);
+        while (j >= 0 && sorted[j] > v) {
+            sorted[j + 1] = sorted[j];
+            j--;
+        }
+        sorted[j + 1] = v;
+    }
+
+    return sorted[count / 2];
+}
+
+/**
+ * @brief Turn one edge into period / low time readings
+ *
+ * @return true if a valid reading was added
+ */
+static bool decode_edge(flex_fuel_t* ff, const flex_edge_t* edge)
+{
+    const flex_config_t* cfg = &ff->config;
+
+    if (edge->level == 0) {
+        ff->last_fall = edge->ticks;
+        ff->have_fall = true;
+        return false;
+    }
+
+    bool valid = false;
+
+    if (ff->have_rise) {
+        uint16_t period = (uint16_t)(edge->ticks - ff->last_rise);
+        float period_us = (float)period / cfg->ticks_per_us;
+        float hz = (period_us > 0.0f) ? 1000000.0f / period_us : 0.0f;
+
+        if (hz >= cfg->min_hz * 0.9f && hz <= cfg->max_hz * 1.1f && ff->have_fall) {
+            uint16_t low = (uint16_t)(edge->ticks - ff->last_fall);
+            ff->hz_window[ff->window_index] = hz;
+            ff->low_us_window[ff->window_index] = (float)low / cfg->ticks_per_us;
+            ff->window_index = (uint8_t)((ff->window_index + 1) % FLEX_MEDIAN_SIZE);
+            if (ff->window_count < FLEX_MEDIAN_SIZE) {
+                ff->window_count++;
+            }
+            valid = true;
+        } else {
+            ff->invalid_periods++;
+        }
+    }
+
+    ff->last_rise = edge->ticks;
+    ff->have_rise = true;
+    ff->have_fall = false;
+
+    return valid;
+}
+
+/**
+ * @brief Input capture callback: sample the pin level for the edge
+ */
+FAST_CODE static void flex_capture_callback(uint32_t timestamp)
+{
+    flex_fuel_t* ff = g_flex;
+    if (ff == NULL) {
+        return;
+    }
+
+    flex_fuel_edge(ff, timestamp, (gpio_read(ff->port, ff->pin) == GPIO_STATE_HIGH) ? 1 : 0);
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+bool flex_fuel_init(flex_fuel_t* ff, const ecu_state_t* ecu, float ticks_per_us)
+{
+    if (ff == NULL || ecu == NULL || ticks_per_us <= 0.0f) {
+        return false;
+    }
+
+    memset(ff, 0, sizeof(flex_fuel_t));
+
+    flex_config_t* cfg = &ff->config;
+    cfg->ticks_per_us = ticks_per_us;
+    cfg->min_hz = 50.0f;
+    cfg->max_hz = 150.0f;
+    cfg->signal_timeout_ms = 500;
+    cfg->fallback_percent = 30.0f;  // Matches the default E30 calibration
+    cfg->high_percent = 85.0f;
+
+    memcpy(ff->ethanol_ve, ecu->fuel.ve_table, sizeof(ff->ethanol_ve));
+    for (uint8_t y = 0; y < 16; y++) {
+        for (uint8_t x = 0; x < 16; x++) {
+            ff->ethanol_timing[y][x] = ecu->ignition.timing_table[y][x] + 5.0f;
+        }
+    }
+
+    ff->ethanol_percent = cfg->fallback_percent;
+    ff->fuel_temp_celsius = 25.0f;
+
+    return true;
+}
+
+bool flex_fuel_attach(flex_fuel_t* ff, pwm_ftm_t ftm, pwm_channel_t channel,
+                      gpio_port_t port, gpio_pin_t pin)
+{
+    if (ff == NULL) {
+        return false;
+    }
+
+    ic_config_t ic_cfg = {
+        .edge = IC_EDGE_BOTH,
+        .enable_interrupt = true,
+        .enable_filter = true,
+    };
+
+    ff->port = port;
+    ff->pin = pin;
+    gpio_config(port, pin, GPIO_DIR_INPUT);
+
+    if (!ic_init(ftm, channel, &ic_cfg)) {
+        return false;
+    }
+
+    g_flex = ff;
+    ic_register_callback(ftm, channel, flex_capture_callback);
+    ic_enable(ftm, channel);
+
+    return true;
+}
+
+FAST_CODE void flex_fuel_edge(flex_fuel_t* ff, uint32_t ticks, uint8_t level)
+{
+    uint8_t head = ff->head;
+    uint8_t next = (uint8_t)((head + 1) & (FLEX_EDGE_BUFFER - 1));
+
+    if (next == ff->tail) {
+        ff->edges_dropped++;
+        return;
+    }
+
+    ff->edges[head].ticks = (uint16_t)ticks;
+    ff->edges[head].level = level;
+    ff->head = next;
+}
+
+void flex_fuel_update(flex_fuel_t* ff, ecu_state_t* ecu, uint32_t now_ms)
+{
+    if (ff == NULL || ecu == NULL) {
+        return;
+    }
+
+    const flex_config_t* cfg = &ff->config;
+
+    // Drain edges captured since the last tick
+    bool any_edge = false;
+    bool any_valid = false;
+    while (ff->tail != ff->head) {
+        any_valid |= decode_edge(ff, &ff->edges[ff->tail]);
+        ff->tail = (uint8_t)((ff->tail + 1) & (FLEX_EDGE_BUFFER - 1));
+        any_edge = true;
+    }
+
+    if (any_edge) {
+        ff->last_edge_ms = now_ms;
+    } else if ((now_ms - ff->last_edge_ms) > FLEX_EDGE_STALE_MS) {
+        ff->have_rise = false;
+        ff->have_fall = false;
+    }
+
+    if (any_valid) {
+        ff->last_valid_ms = now_ms;
+    }
+
+    ff->signal_ok = ff->window_count > 0 &&
+                    (now_ms - ff->last_valid_ms) <= cfg->signal_timeout_ms;
+
+    if (ff->signal_ok) {
+        float hz = median(ff->hz_window, ff->window_count);
+        float low_us = median(ff->low_us_window, ff->window_count);
+
+        ff->frequency_hz = hz;
+        ff->ethanol_percent = clampf((hz - cfg->min_hz) * 100.0f / (cfg->max_hz - cfg->min_hz),
+                                     0.0f, 100.0f);
+        ff->fuel_temp_celsius = FLEX_TEMP_MIN_C +
+                                (clampf(low_us, FLEX_TEMP_MIN_US, FLEX_TEMP_MAX_US) - FLEX_TEMP_MIN_US) *
+                                (FLEX_TEMP_MAX_C - FLEX_TEMP_MIN_C) / (FLEX_TEMP_MAX_US - FLEX_TEMP_MIN_US);
+    } else {
+        ff->window_count = 0;
+        ff->window_index = 0;
+        ff->ethanol_percent = cfg->fallback_percent;
+    }
+
+    // Stoich and density; rescale the AFR target so lambda is kept
+    float stoich = flex_fuel_stoich_afr(ff->ethanol_percent);
+    if (ecu->fuel.stoich_afr > 0.0f) {
+        ecu->fuel.afr_target *= stoich / ecu->fuel.stoich_afr;
+    }
+    ecu->fuel.stoich_afr = stoich;
+    ecu->fuel.fuel_density_g_cc = flex_fuel_density(ff->ethanol_percent);
+
+    // Tables are blended at lookup (calculate_fuel_pulse(),
+    // calculate_ignition_timing()), so tuning either set takes effect
+    float high = cfg->high_percent;
+    ecu->fuel.ethanol_ve_table = ff->ethanol_ve;
+    ecu->ignition.ethanol_timing_table = ff->ethanol_timing;
+    ecu->fuel.ethanol_blend = (high > 0.0f) ? clampf(ff->ethanol_percent / high, 0.0f, 1.0f) : 0.0f;
+}
+
+float flex_fuel_stoich_afr(float ethanol_percent)
+{
+    float e = clampf(ethanol_percent, 0.0f, 100.0f) / 100.0f;
+
+    // Air demand is additive by mass: convert volume fraction to mass fraction
+    float ethanol_mass = e * ETHANOL_DENSITY_G_CC;
+    float mass_fraction = ethanol_mass / (ethanol_mass + (1.0f - e) * GASOLINE_DENSITY_G_CC);
+
+    return GASOLINE_STOICH_AFR + (ETHANOL_STOICH_AFR - GASOLINE_STOICH_AFR) * mass_fraction;
+}
+
+float flex_fuel_density(float ethanol_percent)
+{
+    float e = clampf(ethanol_percent, 0.0f, 100.0f) / 100.0f;
+    return GASOLINE_DENSITY_G_CC + (ETHANOL_DENSITY_G_CC - GASOLINE_DENSITY_G_CC) * e;
+}
@@ -0,0 +1,191 @@
+/**
+ * @file flex_fuel.h
+ * @brief Flex-fuel (ethanol content) sensor and fuel/timing blending
+ *
+ * GM/Continental flex sensor: square wave, 50 Hz = E0 to 150 Hz = E100;
+ * the low pulse width encodes fuel temperature (1 ms = -40°C to
+ * 5 ms = 125°C). 200 Hz and above means contaminated fuel or a fault.
+ *
+ * Capture is split:
+ * - ISR: flex_fuel_attach() sets up the input capture channel on both
+ *   edges and registers a callback that reads the pin level and passes
+ *   it with the FTM capture value to flex_fuel_edge(), which stores both
+ *   in a small ring buffer. No math.
+ * - Deferred: flex_fuel_update() from the main loop turns 16-bit
+ *   timestamp deltas (wrap-safe) into period and low time, median-filters
+ *   the last FLEX_MEDIAN_SIZE readings and derives ethanol % and fuel
+ *   temperature.
+ *
+ * The sensor goes on a channel of the capture FTM (FTM0, whose interrupt
+ * dispatches the ic_register_callback() callbacks). Its prescaler must
+ * keep the longest period (20 ms) below the 16-bit counter wrap;
+ * ticks_per_us gives the capture clock.
+ *
+ * Ethanol content then sets, in ecu->fuel:
+ * - stoich_afr: mass-weighted blend of E0 14.7 and E100 9.0; afr_target
+ *   is rescaled with it so any lambda offset is kept
+ * - fuel_density_g_cc: volume-weighted blend used for injector mass
+ * - ethanol_blend: share of the ethanol tables (at high_percent) blended
+ *   into the VE and timing lookups. The ECU tables stay the E0 tables and
+ *   the ethanol tables live here; both can be tuned at any time, neither
+ *   is rewritten by the blend.
+ *
+ * Without a valid signal for signal_timeout_ms, fallback_percent is used.
+ *
+ * @version 1.1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef FLEX_FUEL_H
+#define FLEX_FUEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "engine_control.h"
+#include "pwm_k64.h"
+#include "gpio_k64.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FLEX_EDGE_BUFFER      16      ///< Power of two
+#define FLEX_MEDIAN_SIZE      5
+
+/**
+ * @brief Captured edge
+ */
+typedef struct {
+    uint16_t ticks;                   ///< FTM capture value
+    uint8_t level;                    ///< Pin level after the edge
+} flex_edge_t;
+
+/**
+ * @brief Flex-fuel configuration
+ */
+typedef struct {
+    float ticks_per_us;               ///< Capture clock (bus / prescaler)
+    float min_hz;                     ///< Valid range (E0 = 50 Hz)
+    float max_hz;                     ///< Valid range (E100 = 150 Hz)
+    uint16_t signal_timeout_ms;
+    float fallback_percent;           ///< Ethanol used without a signal
+
+    float high_percent;               ///< Ethanol content of the ethanol tables
+} flex_config_t;
+
+/**
+ * @brief Flex-fuel state
+ */
+typedef struct {
+    flex_config_t config;
+
+    // Sensor input (flex_fuel_attach())
+    gpio_port_t port;
+    gpio_pin_t pin;
+
+    // ISR ring buffer
+    flex_edge_t edges[FLEX_EDGE_BUFFER];
+    volatile uint8_t head;            ///< Written by ISR
+    uint8_t tail;                     ///< Read by flex_fuel_update()
+
+    // Deferred decoding
+    bool have_rise;
+    bool have_fall;
+    uint16_t last_rise;
+    uint16_t last_fall;
+    float hz_window[FLEX_MEDIAN_SIZE];
+    float low_us_window[FLEX_MEDIAN_SIZE];
+    uint8_t window_count;
+    uint8_t window_index;
+    uint32_t last_valid_ms;
+    uint32_t last_edge_ms;
+
+    // Outputs
+    bool signal_ok;
+    float frequency_hz;
+    float ethanol_percent;
+    float fuel_temp_celsius;
+
+    // Ethanol tables (at high_percent); the E0 tables are the ECU tables
+    float ethanol_ve[16][16];
+    float ethanol_timing[16][16];
+
+    // Statistics
+    uint32_t edges_dropped;           ///< Ring buffer overruns
+    uint32_t invalid_periods;
+} flex_fuel_t;
+
+/**
+ * @brief Initialize
+ *
+ * The ethanol tables start as a copy of the ECU tables with +5° timing;
+ * tune them after init.
+ *
+ * @param ff Flex-fuel state
+ * @param ecu ECU state (tables already loaded)
+ * @param ticks_per_us Capture clock of the sensor FTM
+ * @return true on success
+ */
+bool flex_fuel_init(flex_fuel_t* ff, const ecu_state_t* ecu, float ticks_per_us);
+
+/**
+ * @brief Capture the sensor on an input capture channel
+ *
+ * Configures the channel for both edges with interrupt, registers the
+ * edge callback and enables the channel. One sensor is supported.
+ *
+ * @param ff Flex-fuel state
+ * @param ftm Capture FTM (FTM0)
+ * @param channel FTM channel the sensor is routed to
+ * @param port GPIO port of the sensor pin (level read at each edge)
+ * @param pin GPIO pin of the sensor
+ * @return true on success
+ */
+bool flex_fuel_attach(flex_fuel_t* ff, pwm_ftm_t ftm, pwm_channel_t channel,
+                      gpio_port_t port, gpio_pin_t pin);
+
+/**
+ * @brief Record one sensor edge (ISR context)
+ *
+ * @param ff Flex-fuel state
+ * @param ticks FTM capture value (ic_callback_t timestamp)
+ * @param level Pin level after the edge (1 = high)
+ */
+void flex_fuel_edge(flex_fuel_t* ff, uint32_t ticks, uint8_t level);
+
+/**
+ * @brief Decode buffered edges and apply ethanol content (main loop)
+ *
+ * Points ecu->fuel.ethanol_ve_table / ecu->ignition.ethanol_timing_table
+ * at the ethanol tables and sets ecu->fuel.ethanol_blend.
+ *
+ * @param ff Flex-fuel state
+ * @param ecu ECU state
+ * @param now_ms Current time (ms)
+ */
+void flex_fuel_update(flex_fuel_t* ff, ecu_state_t* ecu, uint32_t now_ms);
+
+/**
+ * @brief Stoichiometric AFR for an ethanol blend
+ *
+ * @param ethanol_percent Ethanol content by volume (0-100)
+ * @return Stoichiometric AFR
+ */
+float flex_fuel_stoich_afr(float ethanol_percent);
+
+/**
+ * @brief Fuel density for an ethanol blend
+ *
+ * @param ethanol_percent Ethanol content by volume (0-100)
+ * @return Density (g/cc)
+ */
+float flex_fuel_density(float ethanol_percent);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLEX_FUEL_H
@@ -0,0 +1,246 @@
+/**
+ * @file idle_control.c
+ * @brief Closed-loop idle air control implementation
+ *
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "idle_control.h"
+#include "compiler_k64.h"
+#include <string.h>
+
+// Full-step sequence for a bipolar stepper (A+, A-, B+, B-)
+static const uint8_t STEPPER_PHASES[4] = {
+    0x05,   // A+ B+
+    0x06,   // A- B+
+    0x0A,   // A- B-
+    0x09,   // A+ B-
+};
+
+//=============================================================================
+// Private Helper Functions
+//=============================================================================
+
+/**
+ * @brief 1D table interpolation, clamped at the ends
+ */
+static float interp_1d(const float bins[IDLE_TABLE_SIZE],
+                       const float values[IDLE_TABLE_SIZE], float x)
+{
+    if (x <= bins[0]) {
+        return values[0];
+    }
+    for (uint8_t i = 1; i < IDLE_TABLE_SIZE; i++) {
+        if (x < bins[i]) {
+            float t = (x - bins[i - 1]) / (bins[i] - bins[i - 1]);
+            return values[i - 1] + t * (values[i] - values[i - 1]);
+        }
+    }
+    return values[IDLE_TABLE_SIZE - 1];
+}
+
+static float clampf(float x, float lo, float hi)
+{
+    return (x < lo) ? lo : (x > hi) ? hi : x;
+}
+
+/**
+ * @brief Move the stepper up to steps_per_tick toward step_target
+ */
+static void stepper_run(idle_control_t* idle)
+{
+    uint8_t steps = idle->config.stepper_steps_per_tick;
+
+    while (steps-- > 0 && idle->step_position != idle->step_target) {
+        if (idle->step_target > idle->step_position) {
+            idle->step_position++;
+            idle->step_phase = (uint8_t)((idle->step_phase + 1) & 3);
+        } else {
+            idle->step_position--;
+            idle->step_phase = (uint8_t)((idle->step_phase + 3) & 3);
+        }
+        idle->stepper_out(STEPPER_PHASES[idle->step_phase]);
+    }
+
+    if (idle->homing && idle->step_position == 0) {
+        idle->homing = false;
+    }
+}
+
+/**
+ * @brief Drive the valve to position_pct
+ */
+static void output_valve(idle_control_t* idle)
+{
+    const idle_config_t* cfg = &idle->config;
+
+    switch (cfg->valve) {
+        case IDLE_VALVE_PWM: {
+            float duty = cfg->pwm_min_pct +
+                         (cfg->pwm_max_pct - cfg->pwm_min_pct) * idle->position_pct / 100.0f;
+            uint16_t ticks = pwm_duty_ticks(cfg->pwm_ftm,
+                                            (uint16_t)(clampf(duty, 0.0f, 100.0f) * 100.0f));
+            if (idle->pwm_batch != NULL) {
+                pwm_batch_set(idle->pwm_batch, cfg->pwm_ftm, cfg->pwm_channel, ticks);
+            } else {
+                pwm_set_duty_value(cfg->pwm_ftm, cfg->pwm_channel, ticks);
+            }
+            break;
+        }
+
+        case IDLE_VALVE_STEPPER:
+            if (!idle->homing) {
+                idle->step_target = (uint16_t)(idle->position_pct *
+                                               (float)cfg->stepper_max_steps / 100.0f + 0.5f);
+            }
+            stepper_run(idle);
+            break;
+
+        default:
+            break;
+    }
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+bool idle_control_init(idle_control_t* idle, idle_valve_t valve,
+                       idle_stepper_out_t stepper_out)
+{
+    if (idle == NULL || (valve == IDLE_VALVE_STEPPER && stepper_out == NULL)) {
+        return false;
+    }
+
+    memset(idle, 0, sizeof(idle_control_t));
+    idle->stepper_out = stepper_out;
+
+    idle_config_t* cfg = &idle->config;
+    float clts[] = {-20.0f, 0.0f, 20.0f, 40.0f, 60.0f, 70.0f, 80.0f, 90.0f};
+    float positions[] = {55.0f, 48.0f, 42.0f, 36.0f, 30.0f, 28.0f, 26.0f, 25.0f};
+    float targets[] = {1400.0f, 1300.0f, 1200.0f, 1100.0f, 950.0f, 900.0f, 850.0f, 850.0f};
+    memcpy(cfg->clt_bins, clts, sizeof(clts));
+    memcpy(cfg->open_loop_pct, positions, sizeof(positions));
+    memcpy(cfg->target_rpm, targets, sizeof(targets));
+
+    cfg->tps_max = 2.0f;
+    cfg->idle_window_rpm = 400;
+
+    cfg->kp = 0.02f;                  // 2% per 100 RPM
+    cfg->ki = 0.01f;                  // %/s per RPM
+    cfg->kd = 0.0f;
+    cfg->i_limit_pct = 20.0f;
+
+    cfg->spark_kp = 0.05f;            // 5° per 100 RPM
+    cfg->spark_kd = 0.02f;
+    cfg->spark_max_deg = 10;
+
+    cfg->ac_adder_pct = 8.0f;
+    cfg->fan_adder_pct = 3.0f;
+    cfg->alternator_adder_pct = 5.0f;
+
+    cfg->valve = valve;
+    cfg->pwm_ftm = PWM_FTM3;          // PIN_IDLE_VALVE (FTM0 is the capture timebase)
+    cfg->pwm_channel = PWM_CHANNEL_0;
+    cfg->pwm_min_pct = 20.0f;
+    cfg->pwm_max_pct = 80.0f;
+    cfg->stepper_max_steps = 200;
+    cfg->stepper_steps_per_tick = 4;
+
+    // Home: assume fully open and drive closed over the full range
+    if (valve == IDLE_VALVE_STEPPER) {
+        idle->step_position = cfg->stepper_max_steps;
+        idle->step_target = 0;
+        idle->homing = true;
+    }
+
+    return true;
+}
+
+void idle_control_set_pwm_batch(idle_control_t* idle, pwm_batch_t* batch)
+{
+    if (idle == NULL) {
+        return;
+    }
+
+    idle->pwm_batch = batch;
+}
+
+void idle_control_update(idle_control_t* idle, const ecu_state_t* ecu, uint32_t now_ms)
+{
+    if (idle == NULL || ecu == NULL) {
+        return;
+    }
+
+    const idle_config_t* cfg = &idle->config;
+    const sensor_data_t* s = &ecu->sensors;
+
+    float dt = (idle->last_ms != 0) ? (float)(now_ms - idle->last_ms) / 1000.0f : 0.0f;
+    idle->last_ms = now_ms;
+
+    idle->target = interp_1d(cfg->clt_bins, cfg->target_rpm, s->clt_celsius);
+    float base = interp_1d(cfg->clt_bins, cfg->open_loop_pct, s->clt_celsius);
+
+    // Feed-forward for known loads
+    float ff = 0.0f;
+    if (idle->loads.ac_on) {
+        ff += cfg->ac_adder_pct;
+    }
+    if (idle->loads.fan_on) {
+        ff += cfg->fan_adder_pct;
+    }
+    ff += cfg->alternator_adder_pct * clampf(idle->loads.alternator_duty, 0.0f, 100.0f) / 100.0f;
+    idle->feed_forward_pct = ff;
+
+    idle->active = s->engine_running &&
+                   s->tps_percent < cfg->tps_max &&
+                   (float)s->rpm < idle->target + (float)cfg->idle_window_rpm;
+
+    float pid = 0.0f;
+    if (idle->active) {
+        float error = idle->target - (float)s->rpm;
+
+        idle->integral = clampf(idle->integral + cfg->ki * error * dt,
+                                -cfg->i_limit_pct, cfg->i_limit_pct);
+        float derivative = (dt > 0.0f) ? (error - idle->prev_error) / dt : 0.0f;
+        idle->prev_error = error;
+
+        pid = cfg->kp * error + idle->integral + cfg->kd * derivative;
+    } else {
+        // Off idle: hold the learned integral, drop the rest
+        idle->prev_error = 0.0f;
+        pid = idle->integral;
+    }
+
+    idle->position_pct = clampf(base + ff + pid, 0.0f, 100.0f);
+    output_valve(idle);
+}
+
+FAST_CODE int8_t idle_control_spark_correction(idle_control_t* idle, uint16_t rpm)
+{
+    if (idle == NULL) {
+        return 0;
+    }
+
+    uint16_t prev = idle->prev_cycle_rpm;
+    idle->prev_cycle_rpm = rpm;
+
+    if (!idle->active || prev == 0) {
+        idle->spark_deg = 0;
+        return 0;
+    }
+
+    // Below target / falling -> advance, above target / rising -> retard
+    const idle_config_t* cfg = &idle->config;
+    float error = idle->target - (float)rpm;
+    float falling = (float)prev - (float)rpm;
+    float deg = cfg->spark_kp * error + cfg->spark_kd * falling;
+    deg = clampf(deg, -(float)cfg->spark_max_deg, (float)cfg->spark_max_deg);
+
+    idle->spark_deg = (int8_t)deg;
+    return idle->spark_deg;
+}
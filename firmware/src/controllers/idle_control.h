@@ -0,0 +1,188 @@
+/**
+ * @file idle_control.h
+ * @brief Closed-loop idle air control with spark correction
+ *
+ * Valve position (0-100%) is built from:
+ * - Open-loop position from a CLT table
+ * - Feed-forward adders for A/C, cooling fan and alternator load, applied
+ *   as soon as the load switches so the PID does not have to catch the drop
+ * - RPM-targeting PID (target RPM from a CLT table), active only in idle
+ *   (throttle closed, RPM below target + idle_window_rpm)
+ *
+ * Air is slow (manifold fill), so timing is used as the fast actuator:
+ * idle_control_spark_correction() returns a P/D advance correction from
+ * the RPM error. The dispatcher calls it once per cycle while building
+ * the spark angles, so it reacts to ecu->sensors.rpm on the next cycle
+ * instead of waiting for the air loop.
+ *
+ * Valves:
+ * - PWM solenoid on an FTM channel (pwm_k64), default FTM3 CH0
+ *   (PIN_IDLE_VALVE)
+ * - 4-wire bipolar stepper, full-step, phases driven through a board
+ *   callback; homed closed at init by over-driving max_steps
+ *
+ * idle_control_update() runs once per control tick from ecu->sensors.
+ *
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef IDLE_CONTROL_H
+#define IDLE_CONTROL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "engine_control.h"
+#include "pwm_k64.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define IDLE_TABLE_SIZE       8
+
+/**
+ * @brief Idle valve type
+ */
+typedef enum {
+    IDLE_VALVE_NONE = 0,
+    IDLE_VALVE_PWM,                   ///< PWM solenoid (pwm_k64)
+    IDLE_VALVE_STEPPER                ///< 4-wire stepper
+} idle_valve_t;
+
+/**
+ * @brief Stepper phase output callback
+ *
+ * Bits 0-3 = A+, A-, B+, B- (PIN_IAC_STEP_A1..B2).
+ */
+typedef void (*idle_stepper_out_t)(uint8_t phases);
+
+/**
+ * @brief Load inputs for feed-forward (set by the application)
+ */
+typedef struct {
+    bool ac_on;                       ///< A/C compressor clutch engaged
+    bool fan_on;                      ///< Cooling fan running
+    float alternator_duty;            ///< Alternator field duty (0-100%)
+} idle_loads_t;
+
+/**
+ * @brief Idle configuration
+ */
+typedef struct {
+    float clt_bins[IDLE_TABLE_SIZE];
+    float open_loop_pct[IDLE_TABLE_SIZE];   ///< Valve position vs CLT (%)
+    float target_rpm[IDLE_TABLE_SIZE];      ///< Idle target vs CLT
+
+    float tps_max;                    ///< Throttle closed below this (%)
+    uint16_t idle_window_rpm;         ///< Closed loop below target + window
+
+    // Air PID (output in % valve)
+    float kp;
+    float ki;
+    float kd;
+    float i_limit_pct;                ///< Integral clamp (±%)
+
+    // Spark PD (output in degrees)
+    float spark_kp;                   ///< deg per RPM of error
+    float spark_kd;                   ///< deg per RPM change per cycle
+    int8_t spark_max_deg;             ///< Correction clamp (±deg)
+
+    // Feed-forward adders (% valve)
+    float ac_adder_pct;
+    float fan_adder_pct;
+    float alternator_adder_pct;       ///< At 100% field duty
+
+    // Valve
+    idle_valve_t valve;
+    pwm_ftm_t pwm_ftm;
+    pwm_channel_t pwm_channel;
+    float pwm_min_pct;                ///< Duty at 0% position
+    float pwm_max_pct;                ///< Duty at 100% position
+    uint16_t stepper_max_steps;       ///< Steps for 0-100%
+    uint8_t stepper_steps_per_tick;   ///< Maximum steps per update
+} idle_config_t;
+
+/**
+ * @brief Idle control state
+ */
+typedef struct {
+    idle_config_t config;
+    idle_loads_t loads;
+    idle_stepper_out_t stepper_out;
+    pwm_batch_t* pwm_batch;           ///< Stage PWM duty here (NULL = write at once)
+
+    bool active;                      ///< Closed loop active
+    float target;                     ///< Current target RPM
+    float position_pct;               ///< Commanded valve position
+    float feed_forward_pct;           ///< Load adders in position_pct
+
+    // Air PID
+    float integral;
+    float prev_error;
+    uint32_t last_ms;
+
+    // Spark PD (updated once per cycle)
+    uint16_t prev_cycle_rpm;
+    int8_t spark_deg;                 ///< Last spark correction
+
+    // Stepper
+    uint16_t step_position;           ///< Current step (0 = closed)
+    uint16_t step_target;
+    uint8_t step_phase;               ///< Full-step phase index (0-3)
+    bool homing;                      ///< Driving closed after init
+} idle_control_t;
+
+/**
+ * @brief Initialize with defaults and home the valve
+ *
+ * For IDLE_VALVE_PWM the FTM must already be set up with pwm_init() and
+ * pwm_channel_init(). For IDLE_VALVE_STEPPER, stepper_out must be given.
+ *
+ * @param idle Idle state
+ * @param valve Valve type
+ * @param stepper_out Stepper phase callback (NULL for PWM)
+ * @return true on success, false if parameters are invalid
+ */
+bool idle_control_init(idle_control_t* idle, idle_valve_t valve,
+                       idle_stepper_out_t stepper_out);
+
+/**
+ * @brief Stage the PWM valve duty in a PWM batch
+ *
+ * The control loop latches all staged outputs with pwm_batch_commit().
+ *
+ * @param idle Idle state
+ * @param batch PWM batch (NULL = write the duty immediately)
+ */
+void idle_control_set_pwm_batch(idle_control_t* idle, pwm_batch_t* batch);
+
+/**
+ * @brief Update target, PID and valve output (once per control tick)
+ *
+ * @param idle Idle state
+ * @param ecu ECU state (sensors already updated)
+ * @param now_ms Current time (ms)
+ */
+void idle_control_update(idle_control_t* idle, const ecu_state_t* ecu, uint32_t now_ms);
+
+/**
+ * @brief Spark advance correction for the next cycle
+ *
+ * Called by the dispatcher once per cycle while building spark angles
+ * (main loop), with ecu->sensors.rpm.
+ *
+ * @param idle Idle state
+ * @param rpm Current engine speed
+ * @return Correction in degrees (positive = more advance), 0 if not idling
+ */
+int8_t idle_control_spark_correction(idle_control_t* idle, uint16_t rpm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IDLE_CONTROL_H
@@ -0,0 +1,147 @@
+/**
+ * @file ignition_coils.c
+ * @brief Ignition coil mode implementation
+ *
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "ignition_coils.h"
+#include "compiler_k64.h"
+#include <string.h>
+
+#define IGN_CYCLE_DEGREES   720
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+bool ignition_coils_init(ignition_coils_t* coils,
+                         const ecu_state_t* ecu,
+                         const cam_sync_state_t* cam)
+{
+    if (coils == NULL || ecu == NULL) {
+        return false;
+    }
+
+    memset(coils, 0, sizeof(ignition_coils_t));
+
+    uint8_t n = ecu->config.num_cylinders;
+    if (n == 0 || n > IGN_COILS_MAX_CYLINDERS ||
+        ecu->ignition.ignition_mode >= IGNITION_MODE_COUNT) {
+        return false;
+    }
+
+    coils->num_cylinders = n;
+    coils->configured_mode = ecu->ignition.ignition_mode;
+    coils->active_mode = coils->configured_mode;
+    coils->cam = cam;
+
+    bool even = (n % 2) == 0;
+    uint8_t half = n / 2;
+
+    if (coils->configured_mode == IGNITION_MODE_WASTED_SPARK && !even) {
+        return false;
+    }
+
+    for (uint8_t slot = 0; slot < n; slot++) {
+        // COP: coil of the physical cylinder in this firing slot
+        uint8_t cyl = ecu->config.firing_order[slot];
+        cylinder_mask_t cop = (cyl >= 1 && cyl <= n) ? CYLINDER_BIT(cyl - 1) :
+                                                       CYLINDER_BIT(slot);
+        coils->coil_mask[IGNITION_MODE_COP][slot] = cop;
+
+        // Distributor: single coil on output 0
+        coils->coil_mask[IGNITION_MODE_DISTRIBUTOR][slot] = 0x01;
+    }
+
+    if (even) {
+        for (uint8_t slot = 0; slot < n; slot++) {
+            uint8_t pair = slot % half;
+            if (coils->configured_mode == IGNITION_MODE_COP) {
+                // COP coils: fire both cylinders 360° apart together
+                coils->coil_mask[IGNITION_MODE_WASTED_SPARK][slot] =
+                    coils->coil_mask[IGNITION_MODE_COP][pair] |
+                    coils->coil_mask[IGNITION_MODE_COP][pair + half];
+            } else {
+                // Wasted spark coil pack: one output per pair
+                coils->coil_mask[IGNITION_MODE_WASTED_SPARK][slot] = CYLINDER_BIT(pair);
+            }
+        }
+    }
+
+    ignition_coils_update(coils);
+    coils->fallbacks = 0;  // Starting without phase is not a cam loss
+    return true;
+}
+
+void ignition_coils_update(ignition_coils_t* coils)
+{
+    if (coils == NULL || coils->configured_mode != IGNITION_MODE_COP ||
+        (coils->num_cylinders % 2) != 0) {
+        return;
+    }
+
+    bool phase_known = (coils->cam != NULL) && cam_sync_is_synced(coils->cam);
+    ignition_mode_t mode = phase_known ? IGNITION_MODE_COP : IGNITION_MODE_WASTED_SPARK;
+
+    if (mode != coils->active_mode) {
+        if (mode == IGNITION_MODE_WASTED_SPARK) {
+            coils->fallbacks++;
+        } else {
+            coils->recoveries++;
+        }
+        coils->active_mode = mode;
+    }
+}
+
+uint16_t ignition_coils_period_deg(const ignition_coils_t* coils)
+{
+    if (coils == NULL || coils->num_cylinders == 0) {
+        return IGN_CYCLE_DEGREES;
+    }
+
+    switch (coils->active_mode) {
+        case IGNITION_MODE_WASTED_SPARK:
+            return IGN_CYCLE_DEGREES / 2;
+        case IGNITION_MODE_DISTRIBUTOR:
+            return IGN_CYCLE_DEGREES / coils->num_cylinders;
+        case IGNITION_MODE_COP:
+        default:
+            return IGN_CYCLE_DEGREES;
+    }
+}
+
+FAST_CODE cylinder_mask_t ignition_coils_arm(ignition_coils_t* coils, uint8_t slot)
+{
+    if (coils == NULL || slot >= coils->num_cylinders) {
+        return 0;
+    }
+
+    cylinder_mask_t mask = coils->coil_mask[coils->active_mode][slot];
+    coils->armed_mask[slot] = mask;
+    return mask;
+}
+
+cylinder_mask_t ignition_coils_get_mask(const ignition_coils_t* coils, uint8_t slot)
+{
+    if (coils == NULL || slot >= IGN_COILS_MAX_CYLINDERS) {
+        return 0;
+    }
+
+    return coils->armed_mask[slot];
+}
+
+FAST_CODE cylinder_mask_t ignition_coils_release(ignition_coils_t* coils, uint8_t slot)
+{
+    if (coils == NULL || slot >= IGN_COILS_MAX_CYLINDERS) {
+        return 0;
+    }
+
+    cylinder_mask_t mask = coils->armed_mask[slot];
+    coils->armed_mask[slot] = 0;
+    return mask;
+}
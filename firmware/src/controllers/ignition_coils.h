@@ -0,0 +1,137 @@
+/**
+ * @file ignition_coils.h
+ * @brief Ignition coil modes (COP / wasted spark / distributor)
+ *
+ * Maps each firing-order slot to the coil outputs it fires, for every
+ * ignition_mode_t. The maps are built once from the firing order, so the
+ * per-cycle spark event list is the same for all modes (one event per
+ * cylinder TDC) and only the coil mask looked up at arm time changes.
+ *
+ * Slot n is the cylinder whose TDC is at n * 720 / num_cylinders, i.e.
+ * firing_order[n]. Coil outputs are numbered by physical cylinder
+ * (PIN_IGNITION_1 = bit 0).
+ *
+ * Mode selection for each event list the dispatcher builds:
+ * - COP wiring with cam phase known: coil on plug.
+ * - COP wiring without cam phase: wasted spark, firing the coils of both
+ *   cylinders 360° apart, so the engine keeps running on crank only.
+ *   COP resumes once phase returns.
+ * - Wasted spark / distributor wiring: fixed, phase not required.
+ *
+ * Wasted spark needs an even cylinder count. Odd engines stay in COP.
+ *
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef IGNITION_COILS_H
+#define IGNITION_COILS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "engine_control.h"
+#include "cam_sync_k64.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Cylinders / coil outputs supported
+ */
+#define IGN_COILS_MAX_CYLINDERS   ENGINE_MAX_CYLINDERS
+
+/**
+ * @brief Ignition coil state
+ */
+typedef struct {
+    ignition_mode_t configured_mode;  ///< Coil wiring
+    ignition_mode_t active_mode;      ///< Mode used for the current cycle
+    const cam_sync_state_t* cam;      ///< Cam sync state (NULL = no cam)
+    uint8_t num_cylinders;
+
+    // Coil output bitmask per firing slot, precomputed for each mode
+    cylinder_mask_t coil_mask[IGNITION_MODE_COUNT][IGN_COILS_MAX_CYLINDERS];
+
+    // Mask latched when the dwell (or spark) event was armed, cleared
+    // when the spark fires
+    cylinder_mask_t armed_mask[IGN_COILS_MAX_CYLINDERS];
+
+    // Statistics
+    uint32_t fallbacks;               ///< Switches to wasted spark (cam lost)
+    uint32_t recoveries;              ///< Switches back to COP (cam regained)
+} ignition_coils_t;
+
+/**
+ * @brief Build coil maps from the firing order
+ *
+ * @param coils Coil state
+ * @param ecu ECU state (num_cylinders, firing_order, ignition_mode)
+ * @param cam Cam sync state (may be NULL: COP wiring runs wasted spark)
+ * @return true on success, false if the configuration is invalid
+ */
+bool ignition_coils_init(ignition_coils_t* coils,
+                         const ecu_state_t* ecu,
+                         const cam_sync_state_t* cam);
+
+/**
+ * @brief Select the mode for the next cycle from cam phase
+ *
+ * Called by the dispatcher when it builds an event list (main loop).
+ *
+ * @param coils Coil state
+ */
+void ignition_coils_update(ignition_coils_t* coils);
+
+/**
+ * @brief Crank degrees between two sparks on the same coil
+ *
+ * Used for the per-coil dwell duty limit: 720° COP, 360° wasted spark,
+ * 720°/cylinders distributor.
+ *
+ * @param coils Coil state
+ * @return Coil period in degrees (720 if invalid)
+ */
+uint16_t ignition_coils_period_deg(const ignition_coils_t* coils);
+
+/**
+ * @brief Latch the coil mask for a dwell (or spark) event being armed
+ *
+ * The spark of the same slot must fire the mask latched at dwell start,
+ * even if the mode changed in between, so no charged coil is left on.
+ *
+ * @param coils Coil state
+ * @param slot Firing slot (dispatcher cylinder number)
+ * @return Coil output bitmask, 0 = nothing to fire
+ */
+cylinder_mask_t ignition_coils_arm(ignition_coils_t* coils, uint8_t slot);
+
+/**
+ * @brief Coil mask latched for a slot (for the spark action)
+ *
+ * @param coils Coil state
+ * @param slot Firing slot
+ * @return Coil output bitmask (0 if invalid)
+ */
+cylinder_mask_t ignition_coils_get_mask(const ignition_coils_t* coils, uint8_t slot);
+
+/**
+ * @brief Take the latched coil mask of a slot for its spark
+ *
+ * Clears the latch, so a slot whose next dwell is cut has nothing armed.
+ * Call from the spark action.
+ *
+ * @param coils Coil state
+ * @param slot Firing slot
+ * @return Coil output bitmask to fire (0 if invalid or nothing latched)
+ */
+cylinder_mask_t ignition_coils_release(ignition_coils_t* coils, uint8_t slot);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IGNITION_COILS_H
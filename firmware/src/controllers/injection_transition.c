@@ -0,0 +1,239 @@
+/**
+ * @file injection_transition.c
+ * @brief Injection mode transition implementation
+ *
+ * @version 1.1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "injection_transition.h"
+#include "compiler_k64.h"
+#include <string.h>
+
+//=============================================================================
+// Private Helper Functions
+//=============================================================================
+
+static uint8_t clamp_cylinders(uint8_t num_cylinders)
+{
+    return (num_cylinders > INJ_TRANSITION_MAX_CYLINDERS) ?
+           INJ_TRANSITION_MAX_CYLINDERS : num_cylinders;
+}
+
+/**
+ * @brief Fuel (µs of open time, without latency) one cylinder needs per cycle
+ */
+static uint32_t cylinder_fuel_us(const injection_transition_t* t,
+                                 const ecu_state_t* ecu, uint8_t cylinder)
+{
+    uint32_t pulse = ecu->fuel.cylinder_pulse_us[cylinder];
+    if (pulse == 0) {
+        pulse = ecu->fuel.base_pulse_us;
+    }
+
+    return (pulse > t->latency_us) ? (pulse - t->latency_us) : 0;
+}
+
+/**
+ * @brief Fuel the injector feeding a cylinder must deliver per cycle
+ *
+ * Single point: injector 0 supplies every cylinder.
+ */
+static uint32_t injector_fuel_us(const injection_transition_t* t,
+                                 const ecu_state_t* ecu, uint8_t cylinder)
+{
+    if (t->active_mode != INJECTION_MODE_SINGLE_POINT) {
+        return cylinder_fuel_us(t, ecu, cylinder);
+    }
+
+    if (cylinder != 0) {
+        return 0;
+    }
+
+    uint32_t total = 0;
+    for (uint8_t cyl = 0; cyl < t->num_cylinders; cyl++) {
+        total += cylinder_fuel_us(t, ecu, cyl);
+    }
+    return total;
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+void injection_transition_init(injection_transition_t* t,
+                               const ecu_state_t* ecu,
+                               const cam_sync_state_t* cam)
+{
+    if (t == NULL || ecu == NULL) {
+        return;
+    }
+
+    memset(t, 0, sizeof(injection_transition_t));
+    t->active_mode = ecu->fuel.injection_mode;
+    t->requested_mode = ecu->fuel.injection_mode;
+    t->cam = cam;
+    t->num_cylinders = clamp_cylinders(ecu->config.num_cylinders);
+}
+
+void injection_transition_request(injection_transition_t* t, injection_mode_t mode)
+{
+    if (t == NULL) {
+        return;
+    }
+
+    t->requested_mode = mode;
+    t->auto_mode = false;
+}
+
+void injection_transition_set_auto(injection_transition_t* t, bool enable)
+{
+    if (t == NULL) {
+        return;
+    }
+
+    t->auto_mode = enable;
+}
+
+injection_mode_t injection_transition_next_mode(const injection_transition_t* t,
+                                                const ecu_state_t* ecu)
+{
+    if (t == NULL || ecu == NULL) {
+        return INJECTION_MODE_SEQUENTIAL;
+    }
+
+    if (!t->auto_mode) {
+        return t->requested_mode;
+    }
+
+    // Cranking: fire everything, phase unknown
+    if (!ecu->sensors.engine_running) {
+        return INJECTION_MODE_SIMULTANEOUS;
+    }
+
+    // Running: sequential needs cam phase, batch is phase-independent
+    if (t->cam != NULL && cam_sync_is_synced(t->cam)) {
+        return INJECTION_MODE_SEQUENTIAL;
+    }
+
+    return INJECTION_MODE_BATCH;
+}
+
+void injection_transition_end_cycle(injection_transition_t* t, ecu_state_t* ecu,
+                                    injection_mode_t mode)
+{
+    if (t == NULL || ecu == NULL) {
+        return;
+    }
+
+    // Per-cylinder error of the finished cycle (skipped after a reset)
+    bool error = false;
+    for (uint8_t cyl = 0; cyl < INJ_TRANSITION_MAX_CYLINDERS; cyl++) {
+        int32_t diff = 0;
+        if (t->primed && cyl < t->num_cylinders) {
+            diff = (int32_t)t->target_us[cyl] - (int32_t)t->delivered_us[cyl];
+        }
+        t->last_error_us[cyl] = diff;
+        if (diff != 0) {
+            error = true;
+        }
+    }
+    if (error) {
+        t->error_cycles++;
+    }
+    t->primed = true;
+
+    if (mode != t->active_mode) {
+        t->active_mode = mode;
+        t->transitions++;
+    }
+    ecu->fuel.injection_mode = t->active_mode;
+}
+
+void injection_transition_begin_cycle(injection_transition_t* t,
+                                      const ecu_state_t* ecu,
+                                      const uint8_t squirts[INJ_TRANSITION_MAX_CYLINDERS])
+{
+    if (t == NULL || ecu == NULL || squirts == NULL) {
+        return;
+    }
+
+    t->num_cylinders = clamp_cylinders(ecu->config.num_cylinders);
+    t->latency_us = (uint32_t)calculate_injector_latency(&ecu->fuel.latency_table,
+                                                         ecu->sensors.battery_voltage);
+
+    for (uint8_t cyl = 0; cyl < INJ_TRANSITION_MAX_CYLINDERS; cyl++) {
+        t->squirts_per_cycle[cyl] = squirts[cyl];
+        t->squirts_done[cyl] = 0;
+        t->delivered_us[cyl] = 0;
+        // Refreshed at the first squirt; kept so a missed cylinder shows up
+        t->target_us[cyl] = (cyl < t->num_cylinders && squirts[cyl] > 0) ?
+                            injector_fuel_us(t, ecu, cyl) : 0;
+    }
+}
+
+FAST_CODE uint32_t injection_transition_arm_squirt(injection_transition_t* t,
+                                                   const ecu_state_t* ecu,
+                                                   uint8_t cylinder)
+{
+    if (t == NULL || ecu == NULL || cylinder >= t->num_cylinders) {
+        return 0;
+    }
+
+    uint8_t done = t->squirts_done[cylinder];
+    if (done >= t->squirts_per_cycle[cylinder]) {
+        // Cylinder already received its fuel for this cycle
+        t->extra_squirts++;
+        t->pulse_us[cylinder] = 0;
+        return 0;
+    }
+
+    // Latch fuel at the first squirt so the cycle total cannot change
+    // between the squirts of a batch pair
+    if (done == 0) {
+        t->target_us[cylinder] = injector_fuel_us(t, ecu, cylinder);
+    }
+
+    uint32_t remaining = t->target_us[cylinder] - t->delivered_us[cylinder];
+    uint32_t share = remaining / (uint32_t)(t->squirts_per_cycle[cylinder] - done);
+
+    uint32_t pulse = (share > 0) ? share + t->latency_us : 0;
+    t->share_us[cylinder] = share;
+    t->pulse_us[cylinder] = pulse;
+    return pulse;
+}
+
+FAST_CODE void injection_transition_commit_squirt(injection_transition_t* t, uint8_t cylinder)
+{
+    if (t == NULL || cylinder >= t->num_cylinders ||
+        t->squirts_done[cylinder] >= t->squirts_per_cycle[cylinder]) {
+        return;
+    }
+
+    t->delivered_us[cylinder] += t->share_us[cylinder];
+    t->share_us[cylinder] = 0;
+    t->squirts_done[cylinder]++;
+}
+
+uint32_t injection_transition_get_pulse(const injection_transition_t* t, uint8_t cylinder)
+{
+    if (t == NULL || cylinder >= INJ_TRANSITION_MAX_CYLINDERS) {
+        return 0;
+    }
+
+    return t->pulse_us[cylinder];
+}
+
+void injection_transition_reset(injection_transition_t* t)
+{
+    if (t == NULL) {
+        return;
+    }
+
+    t->primed = false;
+    memset(t->squirts_done, 0, sizeof(t->squirts_done));
+    memset(t->delivered_us, 0, sizeof(t->delivered_us));
+}
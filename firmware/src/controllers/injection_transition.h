@@ -0,0 +1,199 @@
+/**
+ * @file injection_transition.h
+ * @brief Injection mode transitions without fuel steps
+ *
+ * Switching injection_mode_t in the middle of an engine cycle double-fuels
+ * or skips cylinders, because the old and new event lists overlap. This
+ * module owns the mode and only changes it at cycle boundaries: the angle
+ * dispatcher builds each list for the mode returned by
+ * injection_transition_next_mode(), and applies that mode when the list's
+ * cycle starts.
+ *
+ * Per cylinder it tracks the fuel delivered in the current cycle:
+ * - The cycle fuel (pulse minus injector latency) is latched at the first
+ *   squirt of the cycle.
+ * - Each squirt delivers remaining fuel / remaining squirts, plus latency,
+ *   so batch (2 squirts) and sequential (1 squirt) deliver the same fuel.
+ * - The last squirt delivers the exact remainder, so integer rounding
+ *   never accumulates.
+ * - A squirt is only booked once it is scheduled, so a squirt cut by the
+ *   rev limiter or DFCO (or refused by a full queue) does not count as
+ *   delivered.
+ *
+ * In automatic mode the sequence is simultaneous while cranking, batch
+ * once running, and sequential as soon as cam phase is known. On cam loss
+ * it falls back to batch at the next boundary.
+ *
+ * @version 1.1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef INJECTION_TRANSITION_H
+#define INJECTION_TRANSITION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "engine_control.h"
+#include "cam_sync_k64.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Cylinders tracked (matches fuel_control_t::cylinder_pulse_us)
+ */
+#define INJ_TRANSITION_MAX_CYLINDERS   ENGINE_MAX_CYLINDERS
+
+/**
+ * @brief Injection mode transition state
+ */
+typedef struct {
+    // Mode selection
+    injection_mode_t active_mode;     ///< Mode of the current cycle
+    injection_mode_t requested_mode;  ///< Mode applied at next boundary (manual)
+    bool auto_mode;                   ///< Simultaneous -> batch -> sequential
+    const cam_sync_state_t* cam;      ///< Cam sync state (NULL = no cam)
+
+    // Per-cylinder accounting for the current cycle
+    uint8_t num_cylinders;
+    uint8_t squirts_per_cycle[INJ_TRANSITION_MAX_CYLINDERS];
+    uint8_t squirts_done[INJ_TRANSITION_MAX_CYLINDERS];
+    uint32_t target_us[INJ_TRANSITION_MAX_CYLINDERS];     ///< Cycle fuel (no latency)
+    uint32_t delivered_us[INJ_TRANSITION_MAX_CYLINDERS];  ///< Fuel delivered so far
+    uint32_t pulse_us[INJ_TRANSITION_MAX_CYLINDERS];      ///< Last armed pulse (with latency)
+    uint32_t share_us[INJ_TRANSITION_MAX_CYLINDERS];      ///< Fuel of that pulse, booked on commit
+    uint32_t latency_us;              ///< Injector latency latched for this cycle
+    bool primed;                      ///< Current cycle started at a boundary
+
+    // Result of the last completed cycle (target - delivered)
+    int32_t last_error_us[INJ_TRANSITION_MAX_CYLINDERS];
+
+    // Statistics
+    uint32_t transitions;             ///< Mode changes applied
+    uint32_t error_cycles;            ///< Cycles with a per-cylinder fuel error
+    uint32_t extra_squirts;           ///< Squirts refused (cylinder already fuelled)
+} injection_transition_t;
+
+/**
+ * @brief Initialize transition state
+ *
+ * The initial mode is taken from ecu->fuel.injection_mode.
+ *
+ * @param t Transition state
+ * @param ecu ECU state
+ * @param cam Cam sync state used for promotion to sequential (may be NULL)
+ */
+void injection_transition_init(injection_transition_t* t,
+                               const ecu_state_t* ecu,
+                               const cam_sync_state_t* cam);
+
+/**
+ * @brief Request a mode change at the next cycle boundary
+ *
+ * Disables automatic mode selection.
+ *
+ * @param t Transition state
+ * @param mode Requested injection mode
+ */
+void injection_transition_request(injection_transition_t* t, injection_mode_t mode);
+
+/**
+ * @brief Enable/disable automatic mode selection
+ *
+ * @param t Transition state
+ * @param enable true = simultaneous -> batch -> sequential from engine state
+ */
+void injection_transition_set_auto(injection_transition_t* t, bool enable);
+
+/**
+ * @brief Mode for the next event list
+ *
+ * Requested mode, or the automatic selection from engine state. Called
+ * by the dispatcher when it builds a list.
+ *
+ * @param t Transition state
+ * @param ecu ECU state
+ * @return Injection mode to build the list for
+ */
+injection_mode_t injection_transition_next_mode(const injection_transition_t* t,
+                                                const ecu_state_t* ecu);
+
+/**
+ * @brief Close the current cycle and apply the mode of the next one
+ *
+ * Records the per-cylinder fuel error of the finished cycle and writes
+ * the mode of the list that starts to ecu->fuel.injection_mode. Called by
+ * the dispatcher at the cycle start.
+ *
+ * @param t Transition state
+ * @param ecu ECU state
+ * @param mode Mode the starting list was built for
+ */
+void injection_transition_end_cycle(injection_transition_t* t, ecu_state_t* ecu,
+                                    injection_mode_t mode);
+
+/**
+ * @brief Start accounting for a new cycle
+ *
+ * @param t Transition state
+ * @param ecu ECU state
+ * @param squirts Injection events per cylinder in the new event list
+ */
+void injection_transition_begin_cycle(injection_transition_t* t,
+                                      const ecu_state_t* ecu,
+                                      const uint8_t squirts[INJ_TRANSITION_MAX_CYLINDERS]);
+
+/**
+ * @brief Compute the pulse for the next squirt of a cylinder
+ *
+ * Called when an injection event is about to be armed, after the cut
+ * checks. The result is also kept in pulse_us[cylinder] for the injector
+ * action callback. Nothing is booked until
+ * injection_transition_commit_squirt().
+ *
+ * @param t Transition state
+ * @param ecu ECU state
+ * @param cylinder Cylinder number (0-based)
+ * @return Pulse width in microseconds including latency, 0 = do not fire
+ */
+uint32_t injection_transition_arm_squirt(injection_transition_t* t,
+                                         const ecu_state_t* ecu,
+                                         uint8_t cylinder);
+
+/**
+ * @brief Book the squirt last armed for a cylinder as delivered
+ *
+ * Called once the injection event was accepted by the scheduler.
+ *
+ * @param t Transition state
+ * @param cylinder Cylinder number (0-based)
+ */
+void injection_transition_commit_squirt(injection_transition_t* t, uint8_t cylinder);
+
+/**
+ * @brief Pulse width of the squirt last armed for a cylinder
+ *
+ * @param t Transition state
+ * @param cylinder Cylinder number (0-based)
+ * @return Pulse width in microseconds (0 if invalid)
+ */
+uint32_t injection_transition_get_pulse(const injection_transition_t* t, uint8_t cylinder);
+
+/**
+ * @brief Drop the current cycle after loss of sync
+ *
+ * The partial cycle is not counted as a fuel error.
+ *
+ * @param t Transition state
+ */
+void injection_transition_reset(injection_transition_t* t);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // INJECTION_TRANSITION_H
@@ -0,0 +1,158 @@
+/**
+ * @file multi_spark.c
+ * @brief Multi-spark ignition implementation
+ *
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "multi_spark.h"
+#include "compiler_k64.h"
+#include <string.h>
+
+//=============================================================================
+// Private Helper Functions
+//=============================================================================
+
+/**
+ * @brief Nearest table bin (spark count is not interpolated)
+ */
+static uint8_t nearest_bin(const float bins[MULTISPARK_TABLE_SIZE], float x)
+{
+    uint8_t best = 0;
+    for (uint8_t i = 1; i < MULTISPARK_TABLE_SIZE; i++) {
+        if (x >= (bins[i - 1] + bins[i]) * 0.5f) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Burst edge: even edges re-dwell, odd edges fire
+ */
+FAST_CODE static void burst_edge(void* context, uint8_t edge)
+{
+    multispark_burst_t* burst = (multispark_burst_t*)context;
+    multispark_t* ms = (multispark_t*)burst->owner;
+
+    if ((edge & 1) == 0) {
+        ms->coil_on(burst->mask);
+    } else {
+        ms->coil_off(burst->mask);
+        if (edge + 1 >= burst->edges) {
+            burst->hw_id = -1;
+        }
+    }
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+void multispark_init(multispark_t* ms,
+                     hw_scheduler_t* hw,
+                     multispark_coil_t coil_on,
+                     multispark_coil_t coil_off)
+{
+    if (ms == NULL) {
+        return;
+    }
+
+    memset(ms, 0, sizeof(multispark_t));
+    ms->hw = hw;
+    ms->coil_on = coil_on;
+    ms->coil_off = coil_off;
+
+    for (uint8_t i = 0; i < MULTISPARK_MAX_SLOTS; i++) {
+        ms->bursts[i].owner = ms;
+        ms->bursts[i].hw_id = -1;
+    }
+
+    // Defaults (rusEFI-like): 1 ms arc, 1 ms re-dwell, within 30°
+    multispark_config_t* cfg = &ms->config;
+    cfg->enabled = false;
+    cfg->max_rpm = 1500;
+    cfg->spark_duration_us = 1000;
+    cfg->redwell_us = 1000;
+    cfg->max_angle_deg = 30;
+
+    float rpms[] = {300.0f, 600.0f, 900.0f, 1200.0f};
+    float clts[] = {-20.0f, 0.0f, 40.0f, 80.0f};
+    uint8_t counts[MULTISPARK_TABLE_SIZE][MULTISPARK_TABLE_SIZE] = {
+        {5, 4, 3, 2},   // -20°C
+        {4, 3, 2, 2},   //   0°C
+        {3, 2, 2, 1},   //  40°C
+        {2, 2, 1, 1},   //  80°C
+    };
+    memcpy(cfg->rpm_bins, rpms, sizeof(rpms));
+    memcpy(cfg->clt_bins, clts, sizeof(clts));
+    memcpy(cfg->spark_count, counts, sizeof(counts));
+}
+
+void multispark_update(multispark_t* ms, uint16_t rpm, float clt_celsius)
+{
+    if (ms == NULL) {
+        return;
+    }
+
+    const multispark_config_t* cfg = &ms->config;
+    if (!cfg->enabled || rpm == 0 || rpm >= cfg->max_rpm) {
+        ms->extra_sparks = 0;
+        return;
+    }
+
+    uint8_t r = nearest_bin(cfg->rpm_bins, (float)rpm);
+    uint8_t c = nearest_bin(cfg->clt_bins, clt_celsius);
+    uint8_t count = cfg->spark_count[c][r];
+    if (count > MULTISPARK_MAX_SPARKS) {
+        count = MULTISPARK_MAX_SPARKS;
+    }
+    uint8_t extra = (count > 1) ? (uint8_t)(count - 1) : 0;
+
+    // Burst must end within max_angle_deg after the main spark
+    uint32_t per_spark_us = (uint32_t)cfg->spark_duration_us + cfg->redwell_us;
+    uint32_t window_us = (uint32_t)cfg->max_angle_deg * 1000000UL / ((uint32_t)rpm * 6UL);
+    uint32_t fit = (per_spark_us > 0) ? window_us / per_spark_us : 0;
+    if (extra > fit) {
+        extra = (uint8_t)fit;
+    }
+
+    ms->extra_sparks = extra;
+}
+
+FAST_CODE bool multispark_fire(multispark_t* ms, uint8_t slot, cylinder_mask_t mask, uint32_t now_us)
+{
+    if (ms == NULL || ms->extra_sparks == 0 || ms->hw == NULL ||
+        ms->coil_on == NULL || ms->coil_off == NULL ||
+        slot >= MULTISPARK_MAX_SLOTS || mask == 0) {
+        return false;
+    }
+
+    multispark_burst_t* burst = &ms->bursts[slot];
+    if (burst->hw_id >= 0 && hw_scheduler_is_scheduled(ms->hw, burst->hw_id)) {
+        ms->bursts_failed++;  // Previous burst on this slot still running
+        return false;
+    }
+
+    // Edge 0 re-dwells after the arc, then alternate re-dwell / arc
+    burst->mask = mask;
+    burst->edges = (uint8_t)(2 * ms->extra_sparks);
+    burst->hw_id = hw_scheduler_schedule_burst(ms->hw,
+                                               now_us + ms->config.spark_duration_us,
+                                               ms->config.redwell_us,
+                                               ms->config.spark_duration_us,
+                                               burst->edges,
+                                               burst_edge,
+                                               burst);
+    if (burst->hw_id < 0) {
+        ms->bursts_failed++;
+        return false;
+    }
+
+    ms->bursts_started++;
+    return true;
+}
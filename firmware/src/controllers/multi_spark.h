@@ -0,0 +1,137 @@
+/**
+ * @file multi_spark.h
+ * @brief Multi-spark ignition for cold start and idle
+ *
+ * Below a configurable RPM each spark is followed by extra sparks on the
+ * same coil: arc for spark_duration_us, re-dwell for redwell_us, fire,
+ * and so on. The spark count comes from an RPM x CLT table.
+ *
+ * The extra sparks are not angle events. After the main spark, the whole
+ * burst is handed to the hardware scheduler as one chained sequence
+ * (hw_scheduler_schedule_burst()), which re-arms a single FTM channel from
+ * its own ISR. The burst uses one scheduler slot regardless of the spark
+ * count, and the angle scheduler queue is unchanged.
+ *
+ * Usage from the dispatcher spark action:
+ *   void fire_spark(uint8_t slot) {
+ *       cylinder_mask_t mask = ignition_coils_release(&coils, slot);
+ *       coils_off(mask);
+ *       multispark_fire(&ms, slot, mask, hw_scheduler_micros());
+ *   }
+ *
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef MULTI_SPARK_H
+#define MULTI_SPARK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hardware_scheduler_k64.h"
+#include "engine_capacity.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Table size and limits
+ */
+#define MULTISPARK_TABLE_SIZE     4
+#define MULTISPARK_MAX_SPARKS     5     ///< Total sparks per event (main + 4)
+#define MULTISPARK_MAX_SLOTS      ENGINE_MAX_CYLINDERS
+
+/**
+ * @brief Coil output callback (bitmask of coil outputs)
+ */
+typedef void (*multispark_coil_t)(cylinder_mask_t mask);
+
+/**
+ * @brief Multi-spark configuration
+ */
+typedef struct {
+    bool enabled;
+    uint16_t max_rpm;                 ///< No extra sparks at or above this RPM
+    uint16_t spark_duration_us;       ///< Arc time before re-dwell
+    uint16_t redwell_us;              ///< Re-dwell time between sparks
+    uint8_t max_angle_deg;            ///< Burst must end within this angle
+
+    float rpm_bins[MULTISPARK_TABLE_SIZE];
+    float clt_bins[MULTISPARK_TABLE_SIZE];
+    uint8_t spark_count[MULTISPARK_TABLE_SIZE][MULTISPARK_TABLE_SIZE];  ///< [clt][rpm], 1 = single spark
+} multispark_config_t;
+
+/**
+ * @brief Burst context for one firing slot
+ */
+typedef struct {
+    void* owner;                      ///< multispark_t
+    cylinder_mask_t mask;             ///< Coils in this burst
+    uint8_t edges;                    ///< Edges in this burst (2 per extra spark)
+    int8_t hw_id;                     ///< Hardware scheduler event (-1 = idle)
+} multispark_burst_t;
+
+/**
+ * @brief Multi-spark state
+ */
+typedef struct {
+    multispark_config_t config;
+    hw_scheduler_t* hw;               ///< Hardware scheduler for bursts
+    multispark_coil_t coil_on;        ///< Start charging coils
+    multispark_coil_t coil_off;       ///< Fire coils
+
+    uint8_t extra_sparks;             ///< Extra sparks per event (from update)
+    multispark_burst_t bursts[MULTISPARK_MAX_SLOTS];
+
+    // Statistics
+    uint32_t bursts_started;
+    uint32_t bursts_failed;           ///< Hardware scheduler full / burst still running
+} multispark_t;
+
+/**
+ * @brief Initialize with default configuration (disabled)
+ *
+ * @param ms Multi-spark state
+ * @param hw Hardware scheduler (scheduler_get_hw_scheduler())
+ * @param coil_on Callback to start charging coils
+ * @param coil_off Callback to fire coils
+ */
+void multispark_init(multispark_t* ms,
+                     hw_scheduler_t* hw,
+                     multispark_coil_t coil_on,
+                     multispark_coil_t coil_off);
+
+/**
+ * @brief Update the extra spark count from engine state
+ *
+ * Call from the main loop (sensor rate). The count is limited so the
+ * burst ends within max_angle_deg at the current RPM.
+ *
+ * @param ms Multi-spark state
+ * @param rpm Engine speed
+ * @param clt_celsius Coolant temperature
+ */
+void multispark_update(multispark_t* ms, uint16_t rpm, float clt_celsius);
+
+/**
+ * @brief Start the extra sparks after the main spark
+ *
+ * Call from the spark action right after the coils were fired.
+ *
+ * @param ms Multi-spark state
+ * @param slot Firing slot
+ * @param mask Coils that just fired
+ * @param now_us Current time (hw_scheduler_micros())
+ * @return true if a burst was scheduled
+ */
+bool multispark_fire(multispark_t* ms, uint8_t slot, cylinder_mask_t mask, uint32_t now_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MULTI_SPARK_H
@@ -26,7 +26,7 @@ void multistage_scheduler_init(multistage_scheduler_t* ms_sched,
     ms_sched->angle_scheduler = angle_sched;
 
     // Clear all events
-    for (uint8_t i = 0; i < 8; i++) {
+    for (uint8_t i = 0; i < MULTISTAGE_MAX_EVENTS; i++) {
         ms_sched->events[i].active = false;
     }
 }
@@ -68,7 +68,7 @@ int8_t multistage_schedule_injection(multistage_scheduler_t* ms_sched,
 
     // Find free event slot
     int8_t event_id = -1;
-    for (uint8_t i = 0; i < 8; i++) {
+    for (uint8_t i = 0; i < MULTISTAGE_MAX_EVENTS; i++) {
         if (!ms_sched->events[i].active) {
             event_id = i;
             break;
@@ -161,7 +161,7 @@ int8_t multistage_schedule_ignition(multistage_scheduler_t* ms_sched,
 
     // Find free event slot
     int8_t event_id = -1;
-    for (uint8_t i = 0; i < 8; i++) {
+    for (uint8_t i = 0; i < MULTISTAGE_MAX_EVENTS; i++) {
         if (!ms_sched->events[i].active) {
             event_id = i;
             break;
@@ -241,7 +241,7 @@ int8_t multistage_schedule_custom(multistage_scheduler_t* ms_sched,
 bool multistage_cancel_event(multistage_scheduler_t* ms_sched,
                              int8_t event_id)
 {
-    if (ms_sched == NULL || event_id < 0 || event_id >= 8) {
+    if (ms_sched == NULL || event_id < 0 || event_id >= MULTISTAGE_MAX_EVENTS) {
         return false;
     }
 
@@ -270,7 +270,7 @@ void multistage_cancel_cylinder(multistage_scheduler_t* ms_sched,
         return;
     }
 
-    for (uint8_t i = 0; i < 8; i++) {
+    for (uint8_t i = 0; i < MULTISTAGE_MAX_EVENTS; i++) {
         if (ms_sched->events[i].active &&
             ms_sched->events[i].cylinder == cylinder) {
             multistage_cancel_event(ms_sched, i);
@@ -24,11 +24,17 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "event_scheduler.h"
+#include "engine_capacity.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief Maximum multi-stage events (one injection + one ignition per cylinder)
+ */
+#define MULTISTAGE_MAX_EVENTS   ENGINE_MAX_MULTISTAGE
+
 /**
  * @brief Multi-stage event type
  */
@@ -78,7 +84,7 @@ typedef struct {
  * @brief Multi-stage scheduler structure
  */
 typedef struct {
-    multistage_event_t events[8];            ///< Max 8 multi-stage events
+    multistage_event_t events[MULTISTAGE_MAX_EVENTS];  ///< Multi-stage events
     event_scheduler_t* angle_scheduler;      ///< Reference to angle scheduler
     uint8_t num_active;                      ///< Number of active events
 
@@ -110,14 +116,14 @@ void multistage_scheduler_init(multistage_scheduler_t* ms_sched,
  *                                rpm, current_time);
  *
  * @param ms_sched Pointer to multi-stage scheduler
- * @param cylinder Cylinder number (0-7)
+ * @param cylinder Cylinder number (0-based)
  * @param start_angle Start angle in degrees (0-720°)
  * @param duration_us Duration in microseconds
  * @param start_action Callback to open injector
  * @param end_action Callback to close injector
  * @param rpm Current engine RPM (for angle-to-time conversion)
  * @param current_time_us Current time in microseconds
- * @return Event ID (0-7) if scheduled, -1 if queue full
+ * @return Event ID (0 to MULTISTAGE_MAX_EVENTS - 1) if scheduled, -1 if queue full
  */
 int8_t multistage_schedule_injection(multistage_scheduler_t* ms_sched,
                                     uint8_t cylinder,
@@ -140,14 +146,14 @@ int8_t multistage_schedule_injection(multistage_scheduler_t* ms_sched,
  *                               6000, current_time);
  *
  * @param ms_sched Pointer to multi-stage scheduler
- * @param cylinder Cylinder number (0-7)
+ * @param cylinder Cylinder number (0-based)
  * @param dwell_angle Angle to start charging coil (0-720°)
  * @param fire_angle Angle to fire spark (0-720°)
  * @param start_action Callback to start charging coil
  * @param end_action Callback to fire spark
  * @param rpm Current engine RPM
  * @param current_time_us Current time in microseconds
- * @return Event ID (0-7) if scheduled, -1 if queue full
+ * @return Event ID (0 to MULTISTAGE_MAX_EVENTS - 1) if scheduled, -1 if queue full
  */
 int8_t multistage_schedule_ignition(multistage_scheduler_t* ms_sched,
                                    uint8_t cylinder,
@@ -0,0 +1,208 @@
+/**
+ * @file rev_limiter.c
+ * @brief Rev limiter, launch control and flat-shift implementation
+ *
+ * @version 1.1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "rev_limiter.h"
+#include "compiler_k64.h"
+#include <string.h>
+
+//=============================================================================
+// Private Helper Functions
+//=============================================================================
+
+/**
+ * @brief Build cut masks: k cylinders spread evenly, rotated by r
+ */
+static void build_cut_sequence(rev_limiter_t* rl)
+{
+    uint8_t n = rl->num_cylinders;
+
+    for (uint8_t k = 0; k <= n; k++) {
+        for (uint8_t r = 0; r < n; r++) {
+            cylinder_mask_t mask = 0;
+            for (uint8_t i = 0; i < k; i++) {
+                uint8_t pos = (uint8_t)(((uint16_t)i * n / k + r) % n);
+                mask |= CYLINDER_BIT(pos);
+            }
+            rl->cut_sequence[k][r] = mask;
+        }
+    }
+}
+
+static void refresh_masks(rev_limiter_t* rl)
+{
+    rl->spark_cut_mask = rl->cut_sequence[rl->spark_cut_level][rl->rotation];
+    rl->fuel_cut_mask = rl->cut_sequence[rl->fuel_cut_level][rl->rotation];
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+bool rev_limiter_init(rev_limiter_t* rl, uint8_t num_cylinders, uint16_t rpm_limit)
+{
+    if (rl == NULL || num_cylinders == 0 || num_cylinders > REV_LIMIT_MAX_CYLINDERS) {
+        return false;
+    }
+
+    memset(rl, 0, sizeof(rev_limiter_t));
+    rl->num_cylinders = num_cylinders;
+
+    rev_limit_config_t* cfg = &rl->config;
+    cfg->rpm_limit = rpm_limit;
+    cfg->soft_window_rpm = 300;
+    cfg->spark_cut_window_rpm = 150;
+    cfg->hysteresis_rpm = 100;
+    cfg->max_retard_deg = 10;
+
+    cfg->launch_enabled = false;
+    cfg->launch_rpm = 4000;
+    cfg->launch_tps = 80;
+
+    cfg->flat_shift_enabled = false;
+    cfg->flat_shift_min_rpm = 5000;
+    cfg->flat_shift_tps = 80;
+
+    rl->active_limit = rpm_limit;
+    build_cut_sequence(rl);
+    refresh_masks(rl);
+
+    return true;
+}
+
+void rev_limiter_set_clutch(rev_limiter_t* rl, bool pressed, uint16_t rpm, float tps_percent)
+{
+    if (rl == NULL || pressed == rl->clutch) {
+        return;
+    }
+
+    rl->clutch = pressed;
+
+    if (!pressed) {
+        rl->mode = REV_LIMIT_MODE_NORMAL;
+        return;
+    }
+
+    // Clutch pressed at speed with throttle held = shift,
+    // from low RPM = launch (throttle checked continuously in update)
+    const rev_limit_config_t* cfg = &rl->config;
+    if (cfg->flat_shift_enabled && rpm >= cfg->flat_shift_min_rpm &&
+        tps_percent >= (float)cfg->flat_shift_tps) {
+        rl->mode = REV_LIMIT_MODE_FLAT_SHIFT;
+        rl->shift_rpm = rpm;
+    } else if (cfg->launch_enabled && rpm < cfg->launch_rpm) {
+        rl->mode = REV_LIMIT_MODE_LAUNCH;
+    }
+}
+
+void rev_limiter_set_overboost(rev_limiter_t* rl, bool active)
+{
+    if (rl == NULL) {
+        return;
+    }
+
+    rl->overboost = active;
+}
+
+FAST_CODE void rev_limiter_update(rev_limiter_t* rl, uint16_t rpm, float tps_percent)
+{
+    if (rl == NULL) {
+        return;
+    }
+
+    const rev_limit_config_t* cfg = &rl->config;
+    uint8_t n = rl->num_cylinders;
+
+    // Active limit
+    uint16_t limit = cfg->rpm_limit;
+    bool spark_hard_cut = false;
+    if (rl->mode == REV_LIMIT_MODE_LAUNCH && tps_percent >= (float)cfg->launch_tps) {
+        limit = cfg->launch_rpm;
+        spark_hard_cut = true;
+    } else if (rl->mode == REV_LIMIT_MODE_FLAT_SHIFT && tps_percent >= (float)cfg->flat_shift_tps) {
+        limit = rl->shift_rpm;
+        spark_hard_cut = true;
+    }
+    rl->active_limit = limit;
+
+    uint16_t soft_start = (limit > cfg->soft_window_rpm) ? limit - cfg->soft_window_rpm : 0;
+    uint16_t cut_start = (limit > cfg->spark_cut_window_rpm) ? limit - cfg->spark_cut_window_rpm : 0;
+    uint16_t release = (limit > cfg->hysteresis_rpm) ? limit - cfg->hysteresis_rpm : 0;
+
+    // Hard stage latches until RPM falls below limit - hysteresis
+    bool hard = (rpm >= limit) || (rl->stage == REV_LIMIT_STAGE_HARD && rpm >= release);
+
+    uint8_t retard = 0;
+    uint8_t spark_level = 0;
+    uint8_t fuel_level = 0;
+
+    if (rl->overboost) {
+        rl->stage = REV_LIMIT_STAGE_OVERBOOST;
+        fuel_level = n;
+    } else if (hard) {
+        rl->stage = REV_LIMIT_STAGE_HARD;
+        retard = cfg->max_retard_deg;
+        if (spark_hard_cut) {
+            spark_level = n;
+        } else {
+            fuel_level = n;
+        }
+    } else if (rpm >= cut_start && n > 1) {
+        rl->stage = REV_LIMIT_STAGE_SPARK_CUT;
+        retard = cfg->max_retard_deg;
+        // 1 .. n-1 cylinders as RPM approaches the limit
+        uint16_t span = limit - cut_start;
+        spark_level = (uint8_t)(1 + (uint32_t)(n - 2) * (rpm - cut_start) / (span ? span : 1));
+    } else if (rpm >= soft_start && limit > soft_start) {
+        rl->stage = REV_LIMIT_STAGE_SOFT;
+        retard = (uint8_t)((uint32_t)cfg->max_retard_deg * (rpm - soft_start) / (limit - soft_start));
+    } else {
+        rl->stage = REV_LIMIT_STAGE_NONE;
+    }
+
+    rl->retard_deg = retard;
+    rl->spark_cut_level = spark_level;
+    rl->fuel_cut_level = fuel_level;
+    refresh_masks(rl);
+}
+
+void rev_limiter_begin_cycle(rev_limiter_t* rl)
+{
+    if (rl == NULL) {
+        return;
+    }
+
+    rl->rotation++;
+    if (rl->rotation >= rl->num_cylinders) {
+        rl->rotation = 0;
+    }
+    refresh_masks(rl);
+}
+
+FAST_CODE bool rev_limiter_allow(rev_limiter_t* rl, rev_limit_cut_t cut, uint8_t cylinder)
+{
+    if (rl == NULL || cylinder >= REV_LIMIT_MAX_CYLINDERS) {
+        return true;
+    }
+
+    if (cut == REV_LIMIT_CUT_SPARK) {
+        if (rl->spark_cut_mask & CYLINDER_BIT(cylinder)) {
+            rl->sparks_cut++;
+            return false;
+        }
+    } else {
+        if (rl->fuel_cut_mask & CYLINDER_BIT(cylinder)) {
+            rl->injections_cut++;
+            return false;
+        }
+    }
+
+    return true;
+}
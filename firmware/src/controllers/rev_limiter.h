@@ -0,0 +1,185 @@
+/**
+ * @file rev_limiter.h
+ * @brief Rev limiter, launch control and flat-shift with cut patterns
+ *
+ * Three stages below/at the active RPM limit:
+ * - Soft:   timing retard, ramping up to max_retard_deg at the limit
+ * - Medium: spark cut, 1 to (n-1) cylinders per cycle as RPM rises
+ * - Hard:   above the limit, cut everything (fuel for the main limiter,
+ *           spark for launch/flat-shift to keep the exhaust hot), held
+ *           until RPM drops below limit - hysteresis_rpm
+ *
+ * Overboost (set by boost control) forces a full fuel cut regardless of
+ * RPM until it is cleared.
+ *
+ * The active limit is the main limit (config_engine_t.rpm_limit), the
+ * launch RPM (clutch pressed from low RPM, throttle above launch_tps), or
+ * the RPM captured when the clutch was pressed at speed (flat-shift).
+ *
+ * Cut patterns are precomputed per cut level as n rotations of an evenly
+ * spread cylinder bitmask. The rotation advances each cycle, so the same
+ * cylinders are not cut every cycle. At arm time the dispatcher only
+ * tests one bit (O(1) per event), and level changes take effect on the
+ * next armed event.
+ *
+ * @version 1.1.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef REV_LIMITER_H
+#define REV_LIMITER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "engine_capacity.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define REV_LIMIT_MAX_CYLINDERS   ENGINE_MAX_CYLINDERS
+
+/**
+ * @brief Limiter stage
+ */
+typedef enum {
+    REV_LIMIT_STAGE_NONE = 0,
+    REV_LIMIT_STAGE_SOFT,             ///< Timing retard
+    REV_LIMIT_STAGE_SPARK_CUT,        ///< Partial spark cut
+    REV_LIMIT_STAGE_HARD,             ///< Full cut
+    REV_LIMIT_STAGE_OVERBOOST         ///< Full fuel cut (boost control)
+} rev_limit_stage_t;
+
+/**
+ * @brief Active limit source
+ */
+typedef enum {
+    REV_LIMIT_MODE_NORMAL = 0,
+    REV_LIMIT_MODE_LAUNCH,
+    REV_LIMIT_MODE_FLAT_SHIFT
+} rev_limit_mode_t;
+
+/**
+ * @brief Cut type tested at arm time
+ */
+typedef enum {
+    REV_LIMIT_CUT_FUEL = 0,
+    REV_LIMIT_CUT_SPARK
+} rev_limit_cut_t;
+
+/**
+ * @brief Rev limiter configuration
+ */
+typedef struct {
+    uint16_t rpm_limit;               ///< Main limit (hard cut above)
+    uint16_t soft_window_rpm;         ///< Retard starts this far below the limit
+    uint16_t spark_cut_window_rpm;    ///< Spark cut starts this far below the limit
+    uint16_t hysteresis_rpm;          ///< Hard cut released below limit - hysteresis
+    uint8_t max_retard_deg;           ///< Retard at the limit
+
+    bool launch_enabled;
+    uint16_t launch_rpm;              ///< Launch limit
+    uint8_t launch_tps;               ///< Minimum throttle (%) for launch
+
+    bool flat_shift_enabled;
+    uint16_t flat_shift_min_rpm;      ///< Clutch press above this RPM = shift
+    uint8_t flat_shift_tps;           ///< Minimum throttle (%) for flat-shift
+} rev_limit_config_t;
+
+/**
+ * @brief Rev limiter state
+ */
+typedef struct {
+    rev_limit_config_t config;
+    uint8_t num_cylinders;
+
+    // Inputs
+    bool clutch;                      ///< Clutch switch (pressed = true)
+    bool overboost;                   ///< Overboost cut requested
+
+    // State
+    rev_limit_mode_t mode;
+    rev_limit_stage_t stage;
+    uint16_t active_limit;            ///< Limit currently enforced
+    uint16_t shift_rpm;               ///< RPM captured at clutch press (flat-shift)
+    uint8_t retard_deg;               ///< Timing retard for the next cycle
+    uint8_t spark_cut_level;          ///< Cylinders cut per cycle (spark)
+    uint8_t fuel_cut_level;           ///< Cylinders cut per cycle (fuel)
+    uint8_t rotation;                 ///< Pattern rotation (advances per cycle)
+
+    // Precomputed cut masks [cylinders cut][rotation]
+    cylinder_mask_t cut_sequence[REV_LIMIT_MAX_CYLINDERS + 1][REV_LIMIT_MAX_CYLINDERS];
+    cylinder_mask_t spark_cut_mask;   ///< Current spark cut bitmask
+    cylinder_mask_t fuel_cut_mask;    ///< Current fuel cut bitmask
+
+    // Statistics
+    uint32_t sparks_cut;
+    uint32_t injections_cut;
+} rev_limiter_t;
+
+/**
+ * @brief Initialize with defaults and precompute cut patterns
+ *
+ * @param rl Rev limiter state
+ * @param num_cylinders Cylinder count (1-REV_LIMIT_MAX_CYLINDERS)
+ * @param rpm_limit Main RPM limit (config_engine_t.rpm_limit)
+ * @return true on success, false if parameters are invalid
+ */
+bool rev_limiter_init(rev_limiter_t* rl, uint8_t num_cylinders, uint16_t rpm_limit);
+
+/**
+ * @brief Set clutch switch state (launch/flat-shift input)
+ *
+ * @param rl Rev limiter state
+ * @param pressed true = clutch pressed
+ * @param rpm Engine speed at the time of the change
+ * @param tps_percent Throttle position (0-100%)
+ */
+void rev_limiter_set_clutch(rev_limiter_t* rl, bool pressed, uint16_t rpm, float tps_percent);
+
+/**
+ * @brief Request or release the overboost fuel cut
+ *
+ * Takes effect on the next rev_limiter_update().
+ *
+ * @param rl Rev limiter state
+ * @param active true = cut all fuel
+ */
+void rev_limiter_set_overboost(rev_limiter_t* rl, bool active);
+
+/**
+ * @brief Re-evaluate stage and cut levels
+ *
+ * Integer only; the dispatcher calls it on every tooth.
+ *
+ * @param rl Rev limiter state
+ * @param rpm Engine speed
+ * @param tps_percent Throttle position (0-100%)
+ */
+void rev_limiter_update(rev_limiter_t* rl, uint16_t rpm, float tps_percent);
+
+/**
+ * @brief Advance the cut pattern rotation (once per cycle)
+ *
+ * @param rl Rev limiter state
+ */
+void rev_limiter_begin_cycle(rev_limiter_t* rl);
+
+/**
+ * @brief Check whether an event may be armed
+ *
+ * @param rl Rev limiter state
+ * @param cut Fuel or spark
+ * @param cylinder Firing slot (0-based)
+ * @return true if the event is allowed, false if cut
+ */
+bool rev_limiter_allow(rev_limiter_t* rl, rev_limit_cut_t cut, uint8_t cylinder);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REV_LIMITER_H
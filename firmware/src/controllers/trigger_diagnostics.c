@@ -7,6 +7,7 @@
  */
 
 #include "trigger_diagnostics.h"
+#include "trace_log.h"
 #include <string.h>
 #include <stdlib.h>
 
@@ -202,19 +203,16 @@ void trigger_diag_print_report(const trigger_diagnostics_t* diag)
         return;
     }
 
-    // Note: This function would use Serial.print() in Arduino environment
-    // Commented out for portability
-
-    /*
-    Serial.println("=== Trigger Diagnostics ===");
-    Serial.printf("Total errors: %lu\n", diag->total_errors);
-    Serial.printf("  Jitter:     %lu\n", diag->jitter_events);
-    Serial.printf("  Noise:      %lu\n", diag->noise_events);
-    Serial.printf("  Sync loss:  %lu\n", diag->sync_loss_events);
-    Serial.printf("  RPM jump:   %lu\n", diag->rpm_jump_events);
-    Serial.printf("\nPeriod range: %u - %u µs\n",
-                 diag->min_period_seen_us,
-                 diag->max_period_seen_us);
-    Serial.printf("Logging: %s\n", diag->logging_enabled ? "ON" : "OFF");
-    */
+    TRACE0("=== Trigger Diagnostics ===");
+    TRACE1("Total errors: %u", diag->total_errors);
+    TRACE3("  Jitter: %u  Noise: %u  Sync loss: %u",
+           diag->jitter_events, diag->noise_events, diag->sync_loss_events);
+    TRACE1("  RPM jump: %u", diag->rpm_jump_events);
+    TRACE2("Period range: %u - %u us",
+           diag->min_period_seen_us, diag->max_period_seen_us);
+    if (diag->logging_enabled) {
+        TRACE0("Logging: ON");
+    } else {
+        TRACE0("Logging: OFF");
+    }
 }
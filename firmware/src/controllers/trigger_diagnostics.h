@@ -166,7 +166,8 @@ void trigger_diag_set_noise_threshold(trigger_diagnostics_t* diag,
 /**
  * @brief Print diagnostics report
  *
- * Outputs diagnostic information to Serial.
+ * Logs the counters to the trace log (trace_log.h); rendered on the
+ * host by tools/trace_decode.py.
  *
  * @param diag Pointer to diagnostics structure
  */
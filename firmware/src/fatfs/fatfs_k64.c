@@ -15,6 +15,7 @@
 #include "fatfs_k64.h"
 #include "../hal/spi_k64.h"
 #include "../hal/gpio_k64.h"
+#include "../memory/mem_pool.h"
 #include <string.h>
 
 //=============================================================================
@@ -89,14 +90,35 @@ static uint8_t sd_spi_write(uint8_t data) {
 }
 
 static void sd_spi_write_block(const uint8_t* data, uint16_t length) {
-    uint8_t dummy[length];
+    uint8_t* dummy = (uint8_t*)mem_pool_alloc(MEM_POOL_SECTOR);
+
+    if (dummy == NULL || length > MEM_POOL_SECTOR_SIZE) {
+        // No sector buffer available - fall back to byte transfers
+        mem_pool_free(MEM_POOL_SECTOR, dummy);
+        for (uint16_t i = 0; i < length; i++) {
+            sd_spi_write(data[i]);
+        }
+        return;
+    }
+
     spi_transmit_receive(SD_SPI_PORT, data, dummy, length);
+    mem_pool_free(MEM_POOL_SECTOR, dummy);
 }
 
 static void sd_spi_read_block(uint8_t* data, uint16_t length) {
-    uint8_t dummy[length];
+    uint8_t* dummy = (uint8_t*)mem_pool_alloc(MEM_POOL_SECTOR);
+
+    if (dummy == NULL || length > MEM_POOL_SECTOR_SIZE) {
+        mem_pool_free(MEM_POOL_SECTOR, dummy);
+        for (uint16_t i = 0; i < length; i++) {
+            data[i] = sd_spi_write(0xFF);
+        }
+        return;
+    }
+
     memset(dummy, 0xFF, length);
     spi_transmit_receive(SD_SPI_PORT, dummy, data, length);
+    mem_pool_free(MEM_POOL_SECTOR, dummy);
 }
 
 //=============================================================================
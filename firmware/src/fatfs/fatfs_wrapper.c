@@ -14,6 +14,7 @@
 #include "fatfs_wrapper.h"
 #include "ff.h"
 #include "fatfs_k64.h"
+#include "../memory/mem_pool.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -306,16 +307,25 @@ fatfs_result_t fatfs_save_config(const char* config_name, const void* config_dat
     fatfs_file_t file;
     fatfs_result_t res;
     uint32_t bytes_written;
-    char filename[256];
+    char* filename = (char*)mem_pool_alloc(MEM_POOL_FRAME);
+    
+    if (filename == NULL) {
+        return FATFS_ERROR_NO_BUFFER;
+    }
     
     // Create config directory if it doesn't exist
     fatfs_create_directory("/config");
     
     // Build filename
-    snprintf(filename, sizeof(filename), "/config/%s.bin", config_name);
+    int len = snprintf(filename, MEM_POOL_FRAME_SIZE, "/config/%s.bin", config_name);
+    if (len < 0 || len >= MEM_POOL_FRAME_SIZE) {
+        mem_pool_free(MEM_POOL_FRAME, filename);
+        return FATFS_ERROR_INVALID_PARAM;
+    }
     
     // Save config file
     res = fatfs_open_file(filename, FATFS_MODE_WRITE, &file);
+    mem_pool_free(MEM_POOL_FRAME, filename);
     if (res != FATFS_OK) {
         return res;
     }
@@ -329,13 +339,22 @@ fatfs_result_t fatfs_save_config(const char* config_name, const void* config_dat
 fatfs_result_t fatfs_load_config(const char* config_name, void* config_data, uint32_t size, uint32_t* bytes_read) {
     fatfs_file_t file;
     fatfs_result_t res;
-    char filename[256];
+    char* filename = (char*)mem_pool_alloc(MEM_POOL_FRAME);
+    
+    if (filename == NULL) {
+        return FATFS_ERROR_NO_BUFFER;
+    }
     
     // Build filename
-    snprintf(filename, sizeof(filename), "/config/%s.bin", config_name);
+    int len = snprintf(filename, MEM_POOL_FRAME_SIZE, "/config/%s.bin", config_name);
+    if (len < 0 || len >= MEM_POOL_FRAME_SIZE) {
+        mem_pool_free(MEM_POOL_FRAME, filename);
+        return FATFS_ERROR_INVALID_PARAM;
+    }
     
     // Load config file
     res = fatfs_open_file(filename, FATFS_MODE_READ, &file);
+    mem_pool_free(MEM_POOL_FRAME, filename);
     if (res != FATFS_OK) {
         return res;
     }
@@ -385,6 +404,7 @@ const char* fatfs_error_string(fatfs_result_t result) {
         case FATFS_ERROR_GET_INFO: return "Get info failed";
         case FATFS_ERROR_UNMOUNT: return "Unmount failed";
         case FATFS_ERROR_INVALID_PARAM: return "Invalid parameter";
+        case FATFS_ERROR_NO_BUFFER: return "No buffer available";
         default: return "Unknown error";
     }
 }
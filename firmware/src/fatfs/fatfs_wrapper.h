@@ -37,7 +37,8 @@ typedef enum {
     FATFS_ERROR_DELETE,
     FATFS_ERROR_GET_INFO,
     FATFS_ERROR_UNMOUNT,
-    FATFS_ERROR_INVALID_PARAM
+    FATFS_ERROR_INVALID_PARAM,
+    FATFS_ERROR_NO_BUFFER           // Buffer pool exhausted
 } fatfs_result_t;
 
 //=============================================================================
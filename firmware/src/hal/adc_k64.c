@@ -11,6 +11,7 @@
 #include <stddef.h>
 #include "adc_k64.h"
 #include "clock_k64.h"
+#include "event_trace.h"
 
 //=============================================================================
 // SIM Register Access (for clock gating)
@@ -186,7 +187,9 @@ uint16_t adc_read(adc_instance_t instance, adc_channel_t channel) {
     }
 
     // Read and return result
-    return (uint16_t)(adc->R[0] & 0xFFFF);
+    uint16_t result = (uint16_t)(adc->R[0] & 0xFFFF);
+    event_trace_record(EVENT_TRACE_ADC, (uint8_t)channel, result);
+    return result;
 }
 
 float adc_read_voltage(adc_instance_t instance, adc_channel_t channel) {
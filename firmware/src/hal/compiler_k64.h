@@ -0,0 +1,56 @@
+/**
+ * @file compiler_k64.h
+ * @brief Code placement attributes for Kinetis K64 (Teensy 3.5)
+ * @version 1.1.0
+ * @date 2026-10-18
+ *
+ * Attribute macros that tell the compiler and linker where hot and cold
+ * code should live:
+ *
+ * - FAST_CODE: ISR-critical functions. Placed in .ramfunc in SRAM_L
+ *   (copied by Reset_Handler, executed from the code bus with zero wait
+ *   states) when ENABLE_RAMFUNC is defined, otherwise grouped in .text.hot.
+ * - FAST_DATA: state owned by FAST_CODE ISRs, placed next to them in SRAM_L.
+ * - DMA_BUFFER: DMA source/destination buffers, placed in SRAM_U so DMA
+ *   traffic stays on the system bus.
+ * - HOT_FUNC:  frequently called helpers, grouped in .text.hot.
+ * - COLD_FUNC: init/banner/debug code, grouped in .text.unlikely and
+ *   optimized for size.
+ * - ISR_USED:  keeps interrupt handlers that override weak vector aliases
+ *   alive under -flto.
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef COMPILER_K64_H
+#define COMPILER_K64_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=============================================================================
+// Placement Attributes
+//=============================================================================
+
+#define HOT_FUNC        __attribute__((hot))
+#define COLD_FUNC       __attribute__((cold, noinline))
+#define ISR_USED        __attribute__((used))
+
+#ifdef ENABLE_RAMFUNC
+// RAM is >16 MB away from flash, so calls into RAM need long_call
+#define FAST_CODE       __attribute__((section(".ramfunc"), long_call, noinline, used))
+#define FAST_DATA       __attribute__((section(".fastdata")))
+#else
+#define FAST_CODE       __attribute__((hot, used))
+#define FAST_DATA
+#endif
+
+#define DMA_BUFFER      __attribute__((section(".dmabuf"), aligned(4)))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COMPILER_K64_H
@@ -0,0 +1,66 @@
+/**
+ * @file cycle_counter_k64.h
+ * @brief Cortex-M4 DWT cycle counter for code benchmarks
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * The DWT cycle counter runs at the core clock (120 MHz on Teensy 3.5)
+ * and wraps every ~35 s; differences of two reads are wrap-safe.
+ * CYCLE_COUNTER_AVAILABLE is 0 outside an ARM build (host syntax checks),
+ * where benchmarks should report no result.
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef CYCLE_COUNTER_K64_H
+#define CYCLE_COUNTER_K64_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__arm__)
+#define CYCLE_COUNTER_AVAILABLE     1
+#else
+#define CYCLE_COUNTER_AVAILABLE     0
+#endif
+
+//=============================================================================
+// DWT Register Definitions
+//=============================================================================
+
+#define DEMCR                       (*(volatile uint32_t*)0xE000EDFC)
+#define DEMCR_TRCENA                0x01000000
+#define DWT_CTRL                    (*(volatile uint32_t*)0xE0001000)
+#define DWT_CTRL_CYCCNTENA          0x00000001
+#define DWT_CYCCNT                  (*(volatile uint32_t*)0xE0001004)
+
+//=============================================================================
+// Cycle Counter
+//=============================================================================
+
+/**
+ * @brief Enable the cycle counter (idempotent)
+ */
+static inline void cycle_counter_enable(void)
+{
+    DEMCR |= DEMCR_TRCENA;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+}
+
+/**
+ * @brief Current cycle count
+ */
+static inline uint32_t cycle_counter_read(void)
+{
+    return DWT_CYCCNT;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CYCLE_COUNTER_K64_H
@@ -0,0 +1,186 @@
+/**
+ * @file dma_k64.c
+ * @brief eDMA / DMAMUX driver implementation for Kinetis K64
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include <stddef.h>
+#include "dma_k64.h"
+#include "clock_k64.h"
+#include "compiler_k64.h"
+
+//=============================================================================
+// Private Definitions
+//=============================================================================
+
+#define SIM_SCGC6_DMAMUX            0x00000002
+#define SIM_SCGC7_DMA               0x00000002
+
+// NVIC: DMA channel n is IRQ n
+#define NVIC_ISER0                  (*(volatile uint32_t*)0xE000E100)
+#define NVIC_ICER0                  (*(volatile uint32_t*)0xE000E180)
+
+//=============================================================================
+// Private Variables
+//=============================================================================
+
+FAST_DATA static dma_callback_t dma_callbacks[DMA_NUM_CHANNELS] = {NULL};
+FAST_DATA static void* dma_contexts[DMA_NUM_CHANNELS] = {NULL};
+
+//=============================================================================
+// Private Helper Functions
+//=============================================================================
+
+/**
+ * @brief Common channel interrupt handler
+ */
+FAST_CODE static void dma_irq(uint8_t channel)
+{
+    DMA->CINT = channel;
+
+    if (dma_callbacks[channel] != NULL) {
+        dma_callbacks[channel](channel, dma_contexts[channel]);
+    }
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+void dma_init(void)
+{
+    SIM->SCGC6 |= SIM_SCGC6_DMAMUX;
+    SIM->SCGC7 |= SIM_SCGC7_DMA;
+}
+
+bool dma_start_periph_to_ring(uint8_t channel, uint8_t source,
+                              volatile const void* src_reg,
+                              void* ring, uint16_t entries,
+                              dma_size_t size, bool irq_half_full)
+{
+    if (channel >= DMA_NUM_CHANNELS || src_reg == NULL || ring == NULL ||
+        entries < 2 || entries > 0x7FFF || size > DMA_SIZE_32BIT) {
+        return false;
+    }
+
+    dma_init();
+
+    uint32_t elem = 1U << size;
+    DMA_TCD_Type* tcd = DMA_TCD(channel);
+
+    DMA->CERQ = channel;
+    DMAMUX0->CHCFG[channel] = 0;
+
+    tcd->SADDR = (uint32_t)src_reg;
+    tcd->SOFF = 0;
+    tcd->ATTR = DMA_ATTR_SSIZE(size) | DMA_ATTR_DSIZE(size);
+    tcd->NBYTES = elem;
+    tcd->SLAST = 0;
+    tcd->DADDR = (uint32_t)ring;
+    tcd->DOFF = (int16_t)elem;
+    tcd->CITER = entries;
+    tcd->BITER = entries;
+    tcd->DLASTSGA = -(int32_t)(entries * elem);  // Wrap to the ring start
+    tcd->CSR = irq_half_full ? (DMA_CSR_INTHALF | DMA_CSR_INTMAJOR) : 0;
+
+    if (irq_half_full) {
+        NVIC_ISER0 = 1U << channel;
+    }
+
+    DMAMUX0->CHCFG[channel] = DMAMUX_CHCFG_ENBL | DMAMUX_CHCFG_SOURCE(source);
+    DMA->SERQ = channel;
+
+    return true;
+}
+
+bool dma_start_transfer(uint8_t channel, uint8_t source,
+                        volatile const void* src, int16_t src_offset,
+                        volatile void* dst, int16_t dst_offset,
+                        uint16_t count, dma_size_t size, bool irq_done)
+{
+    if (channel >= DMA_NUM_CHANNELS || src == NULL || dst == NULL ||
+        count == 0 || count > 0x7FFF || size > DMA_SIZE_32BIT) {
+        return false;
+    }
+
+    dma_init();
+
+    DMA_TCD_Type* tcd = DMA_TCD(channel);
+
+    DMA->CERQ = channel;
+    DMA->CDNE = channel;
+    DMAMUX0->CHCFG[channel] = 0;
+
+    tcd->SADDR = (uint32_t)src;
+    tcd->SOFF = src_offset;
+    tcd->ATTR = DMA_ATTR_SSIZE(size) | DMA_ATTR_DSIZE(size);
+    tcd->NBYTES = 1U << size;
+    tcd->SLAST = 0;
+    tcd->DADDR = (uint32_t)dst;
+    tcd->DOFF = dst_offset;
+    tcd->CITER = count;
+    tcd->BITER = count;
+    tcd->DLASTSGA = 0;
+    tcd->CSR = DMA_CSR_DREQ | (irq_done ? DMA_CSR_INTMAJOR : 0);
+
+    if (irq_done) {
+        NVIC_ISER0 = 1U << channel;
+    }
+
+    DMAMUX0->CHCFG[channel] = DMAMUX_CHCFG_ENBL | DMAMUX_CHCFG_SOURCE(source);
+    DMA->SERQ = channel;
+
+    return true;
+}
+
+void dma_stop(uint8_t channel)
+{
+    if (channel >= DMA_NUM_CHANNELS) {
+        return;
+    }
+
+    DMA->CERQ = channel;
+    DMAMUX0->CHCFG[channel] = 0;
+    NVIC_ICER0 = 1U << channel;
+    DMA->CINT = channel;
+}
+
+void dma_register_callback(uint8_t channel, dma_callback_t callback, void* context)
+{
+    if (channel >= DMA_NUM_CHANNELS) {
+        return;
+    }
+
+    dma_contexts[channel] = context;
+    dma_callbacks[channel] = callback;
+}
+
+FAST_CODE uint32_t dma_get_dest_address(uint8_t channel)
+{
+    return DMA_TCD(channel)->DADDR;
+}
+
+//=============================================================================
+// Interrupt Handlers
+//=============================================================================
+
+ISR_USED FAST_CODE void DMA0_IRQHandler(void)  { dma_irq(0); }
+ISR_USED FAST_CODE void DMA1_IRQHandler(void)  { dma_irq(1); }
+ISR_USED FAST_CODE void DMA2_IRQHandler(void)  { dma_irq(2); }
+ISR_USED FAST_CODE void DMA3_IRQHandler(void)  { dma_irq(3); }
+ISR_USED FAST_CODE void DMA4_IRQHandler(void)  { dma_irq(4); }
+ISR_USED FAST_CODE void DMA5_IRQHandler(void)  { dma_irq(5); }
+ISR_USED FAST_CODE void DMA6_IRQHandler(void)  { dma_irq(6); }
+ISR_USED FAST_CODE void DMA7_IRQHandler(void)  { dma_irq(7); }
+ISR_USED FAST_CODE void DMA8_IRQHandler(void)  { dma_irq(8); }
+ISR_USED FAST_CODE void DMA9_IRQHandler(void)  { dma_irq(9); }
+ISR_USED FAST_CODE void DMA10_IRQHandler(void) { dma_irq(10); }
+ISR_USED FAST_CODE void DMA11_IRQHandler(void) { dma_irq(11); }
+ISR_USED FAST_CODE void DMA12_IRQHandler(void) { dma_irq(12); }
+ISR_USED FAST_CODE void DMA13_IRQHandler(void) { dma_irq(13); }
+ISR_USED FAST_CODE void DMA14_IRQHandler(void) { dma_irq(14); }
+ISR_USED FAST_CODE void DMA15_IRQHandler(void) { dma_irq(15); }
@@ -0,0 +1,222 @@
+/**
+ * @file dma_k64.h
+ * @brief eDMA / DMAMUX driver for Kinetis K64 (Teensy 3.5)
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * Minimal eDMA support for peripheral-triggered transfers:
+ * - DMAMUX routing of a peripheral request to one of 16 DMA channels
+ * - Peripheral-to-ring transfers: each request copies one element from a
+ *   fixed register into a circular buffer, the destination wraps at the
+ *   end of the major loop, and the channel keeps running without CPU help
+ * - One-shot memory <-> peripheral transfers (e.g. SPI FIFOs) that stop
+ *   and interrupt at the end of the major loop
+ * - Optional half / full major loop interrupts, dispatched to a callback
+ *
+ * Buffers written by DMA should be declared with DMA_BUFFER
+ * (compiler_k64.h) so DMA traffic stays on the system bus.
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef DMA_K64_H
+#define DMA_K64_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=============================================================================
+// Channels and Request Sources
+//=============================================================================
+
+#define DMA_NUM_CHANNELS            16
+
+// DMAMUX request sources (K64 reference manual, DMA request sources)
+// SPI1 and SPI2 share one request for transmit and receive
+#define DMA_SOURCE_SPI0_RX          14
+#define DMA_SOURCE_SPI0_TX          15
+#define DMA_SOURCE_SPI1             16
+#define DMA_SOURCE_SPI2             17
+#define DMA_SOURCE_FTM0_CH(n)       (20 + (n))      // n = 0-7
+#define DMA_SOURCE_FTM1_CH(n)       (28 + (n))      // n = 0-1
+#define DMA_SOURCE_FTM2_CH(n)       (30 + (n))      // n = 0-1
+#define DMA_SOURCE_FTM3_CH(n)       (32 + (n))      // n = 0-7
+#define DMA_SOURCE_ALWAYS_ON        60
+
+//=============================================================================
+// Transfer Element Size
+//=============================================================================
+
+typedef enum {
+    DMA_SIZE_8BIT = 0,
+    DMA_SIZE_16BIT = 1,
+    DMA_SIZE_32BIT = 2,
+} dma_size_t;
+
+//=============================================================================
+// Interrupt Callback
+//=============================================================================
+
+/**
+ * @brief Channel interrupt callback
+ * @param channel DMA channel that raised the interrupt
+ * @param context User context given at registration
+ */
+typedef void (*dma_callback_t)(uint8_t channel, void* context);
+
+//=============================================================================
+// eDMA / DMAMUX Register Definitions
+//=============================================================================
+
+#define DMA_BASE                    0x40008000
+#define DMA_TCD_BASE                0x40009000
+#define DMAMUX0_BASE                0x40021000
+
+typedef struct {
+    volatile uint32_t CR;           // Control
+    volatile uint32_t ES;           // Error Status
+    uint32_t RESERVED0;
+    volatile uint32_t ERQ;          // Enable Request
+    uint32_t RESERVED1;
+    volatile uint32_t EEI;          // Enable Error Interrupt
+    volatile uint8_t CEEI;          // Clear Enable Error Interrupt
+    volatile uint8_t SEEI;          // Set Enable Error Interrupt
+    volatile uint8_t CERQ;          // Clear Enable Request
+    volatile uint8_t SERQ;          // Set Enable Request
+    volatile uint8_t CDNE;          // Clear DONE Status Bit
+    volatile uint8_t SSRT;          // Set START Bit
+    volatile uint8_t CERR;          // Clear Error
+    volatile uint8_t CINT;          // Clear Interrupt Request
+    uint32_t RESERVED2;
+    volatile uint32_t INT;          // Interrupt Request
+    uint32_t RESERVED3;
+    volatile uint32_t ERR;          // Error
+    uint32_t RESERVED4;
+    volatile uint32_t HRS;          // Hardware Request Status
+} DMA_Type;
+
+typedef struct {
+    volatile uint32_t SADDR;        // Source Address
+    volatile int16_t SOFF;          // Signed Source Address Offset
+    volatile uint16_t ATTR;         // Transfer Attributes
+    volatile uint32_t NBYTES;       // Minor Byte Count
+    volatile int32_t SLAST;         // Last Source Address Adjustment
+    volatile uint32_t DADDR;        // Destination Address
+    volatile int16_t DOFF;          // Signed Destination Address Offset
+    volatile uint16_t CITER;        // Current Major Iteration Count
+    volatile int32_t DLASTSGA;      // Last Destination Address Adjustment
+    volatile uint16_t CSR;          // Control and Status
+    volatile uint16_t BITER;        // Beginning Major Iteration Count
+} DMA_TCD_Type;
+
+typedef struct {
+    volatile uint8_t CHCFG[DMA_NUM_CHANNELS];
+} DMAMUX_Type;
+
+#define DMA                         ((DMA_Type*)DMA_BASE)
+#define DMA_TCD(n)                  ((DMA_TCD_Type*)(DMA_TCD_BASE + 0x20 * (n)))
+#define DMAMUX0                     ((DMAMUX_Type*)DMAMUX0_BASE)
+
+// TCD ATTR
+#define DMA_ATTR_SSIZE(x)           (((x) & 0x07) << 8)
+#define DMA_ATTR_DSIZE(x)           ((x) & 0x07)
+
+// TCD CSR
+#define DMA_CSR_START               0x0001
+#define DMA_CSR_INTMAJOR            0x0002
+#define DMA_CSR_INTHALF             0x0004
+#define DMA_CSR_DREQ                0x0008
+#define DMA_CSR_DONE                0x0080
+
+// DMAMUX CHCFG
+#define DMAMUX_CHCFG_ENBL           0x80
+#define DMAMUX_CHCFG_SOURCE(x)      ((x) & 0x3F)
+
+//=============================================================================
+// Function Prototypes
+//=============================================================================
+
+/**
+ * @brief Enable eDMA and DMAMUX clocks (idempotent)
+ */
+void dma_init(void);
+
+/**
+ * @brief Start a continuous peripheral-to-ring transfer
+ *
+ * Each request from source copies one element from src_reg to the next
+ * slot of ring. The destination wraps after entries elements and the
+ * channel keeps running until dma_stop().
+ *
+ * @param channel DMA channel (0-15)
+ * @param source DMAMUX request source (DMA_SOURCE_*)
+ * @param src_reg Peripheral register address
+ * @param ring Destination ring buffer (DMA_BUFFER)
+ * @param entries Ring length in elements (2-32767)
+ * @param size Element size
+ * @param irq_half_full Interrupt at half and end of the ring
+ * @return true on success
+ */
+bool dma_start_periph_to_ring(uint8_t channel, uint8_t source,
+                              volatile const void* src_reg,
+                              void* ring, uint16_t entries,
+                              dma_size_t size, bool irq_half_full);
+
+/**
+ * @brief Start a one-shot transfer of count elements
+ *
+ * Each request from source moves one element. Source and destination
+ * advance by their offset after every element (0 keeps a peripheral
+ * register or a fill byte fixed). The request is disabled at the end of
+ * the major loop, which raises the channel interrupt if irq_done is set.
+ *
+ * @param channel DMA channel (0-15)
+ * @param source DMAMUX request source (DMA_SOURCE_*)
+ * @param src Source address
+ * @param src_offset Bytes added to the source after each element
+ * @param dst Destination address
+ * @param dst_offset Bytes added to the destination after each element
+ * @param count Elements to move (1-32767)
+ * @param size Element size
+ * @param irq_done Interrupt when the transfer is complete
+ * @return true on success
+ */
+bool dma_start_transfer(uint8_t channel, uint8_t source,
+                        volatile const void* src, int16_t src_offset,
+                        volatile void* dst, int16_t dst_offset,
+                        uint16_t count, dma_size_t size, bool irq_done);
+
+/**
+ * @brief Stop a channel and release its DMAMUX slot
+ *
+ * @param channel DMA channel (0-15)
+ */
+void dma_stop(uint8_t channel);
+
+/**
+ * @brief Register the interrupt callback of a channel
+ *
+ * @param channel DMA channel (0-15)
+ * @param callback Callback (NULL to remove)
+ * @param context Passed to the callback
+ */
+void dma_register_callback(uint8_t channel, dma_callback_t callback, void* context);
+
+/**
+ * @brief Current destination address (next element to be written)
+ *
+ * @param channel DMA channel (0-15)
+ * @return Destination address
+ */
+uint32_t dma_get_dest_address(uint8_t channel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DMA_K64_H
@@ -4,19 +4,25 @@
  *
  * Implements precise hardware timer scheduling using FTM Output Compare mode.
  *
- * @version 2.3.0
- * @date 2026-02-12
+ * @version 2.4.0
+ * @date 2026-10-18
  */
 
 #include "hardware_scheduler_k64.h"
 #include "clock_k64.h"
+#include "compiler_k64.h"
 #include <string.h>
 
 // FTM registers (from pwm_k64.c)
 extern FTM_Type* pwm_get_regs(pwm_ftm_t ftm);
 
+// NVIC interrupt set-enable for IRQ 32-63 (FTM1: IRQ 43, FTM2: IRQ 44)
+#define NVIC_ISER1                  (*(volatile uint32_t*)0xE000E104)
+#define IRQ_FTM1                    43
+#define IRQ_FTM2                    44
+
 // Global hardware scheduler instance (for ISR access)
-static hw_scheduler_t* g_hw_sched = NULL;
+FAST_DATA static hw_scheduler_t* g_hw_sched = NULL;
 
 // FTM channel allocation (track which channels are used for scheduling)
 static bool ftm_channel_allocated[4][8] = {{false}};  // 4 FTMs, 8 channels each
@@ -82,11 +88,10 @@ static void setup_ftm_output_compare(pwm_ftm_t ftm, pwm_channel_t channel,
     ftm_regs->CONTROLS[channel].CnV = match_time_ticks;
 
     // Enable FTM interrupt in NVIC
-    // FTM1: IRQ 42, FTM2: IRQ 43
     if (ftm == PWM_FTM1) {
-        NVIC_ENABLE_IRQ(IRQ_FTM1);
+        NVIC_ISER1 = 1U << (IRQ_FTM1 - 32);
     } else if (ftm == PWM_FTM2) {
-        NVIC_ENABLE_IRQ(IRQ_FTM2);
+        NVIC_ISER1 = 1U << (IRQ_FTM2 - 32);
     }
 }
 
@@ -113,17 +118,12 @@ static uint32_t ftm_ticks_to_us(uint32_t ticks)
 }
 
 /**
- * @brief Schedule an event at absolute time (hardware timer)
+ * @brief Claim an event slot and FTM channel
  */
-int8_t hw_scheduler_schedule(hw_scheduler_t* sched,
-                             uint32_t absolute_time_us,
-                             hw_event_callback_t callback,
-                             void* context)
+static int8_t alloc_event(hw_scheduler_t* sched,
+                          uint32_t absolute_time_us,
+                          void* context)
 {
-    if (sched == NULL || callback == NULL) {
-        return -1;
-    }
-
     // Find free event slot
     int8_t event_id = -1;
     for (uint8_t i = 0; i < HW_SCHEDULER_MAX_EVENTS; i++) {
@@ -145,20 +145,92 @@ int8_t hw_scheduler_schedule(hw_scheduler_t* sched,
     }
 
     // Setup event
-    sched->events[event_id].active = true;
-    sched->events[event_id].scheduled_time_us = absolute_time_us;
-    sched->events[event_id].callback = callback;
-    sched->events[event_id].context = context;
-    sched->events[event_id].ftm = ftm;
-    sched->events[event_id].channel = channel;
+    hw_scheduled_event_t* event = &sched->events[event_id];
+    event->active = true;
+    event->scheduled_time_us = absolute_time_us;
+    event->callback = NULL;
+    event->burst_callback = NULL;
+    event->context = context;
+    event->ftm = ftm;
+    event->channel = channel;
+
+    return event_id;
+}
+
+/**
+ * @brief Start the hardware timer of an allocated event
+ */
+static void start_event(hw_scheduler_t* sched, int8_t event_id)
+{
+    hw_scheduled_event_t* event = &sched->events[event_id];
 
     // Calculate match time in FTM ticks
-    uint32_t match_ticks = us_to_ftm_ticks(absolute_time_us);
+    uint32_t match_ticks = us_to_ftm_ticks(event->scheduled_time_us);
 
     // Setup hardware timer
-    setup_ftm_output_compare(ftm, channel, match_ticks);
+    setup_ftm_output_compare(event->ftm, event->channel, match_ticks);
 
     sched->num_active++;
+}
+
+/**
+ * @brief Schedule an event at absolute time (hardware timer)
+ */
+int8_t hw_scheduler_schedule(hw_scheduler_t* sched,
+                             uint32_t absolute_time_us,
+                             hw_event_callback_t callback,
+                             void* context)
+{
+    if (sched == NULL || callback == NULL) {
+        return -1;
+    }
+
+    int8_t event_id = alloc_event(sched, absolute_time_us, context);
+    if (event_id < 0) {
+        return -1;
+    }
+
+    sched->events[event_id].callback = callback;
+    start_event(sched, event_id);
+
+    return event_id;
+}
+
+/**
+ * @brief Schedule a burst of edges on one hardware channel
+ */
+int8_t hw_scheduler_schedule_burst(hw_scheduler_t* sched,
+                                   uint32_t absolute_time_us,
+                                   uint32_t interval_a_us,
+                                   uint32_t interval_b_us,
+                                   uint8_t edges,
+                                   hw_burst_callback_t callback,
+                                   void* context)
+{
+    if (sched == NULL || callback == NULL ||
+        edges == 0 || edges > HW_BURST_MAX_EDGES) {
+        return -1;
+    }
+
+    // Each interval must fit in one 16-bit compare step
+    uint32_t ticks_a = us_to_ftm_ticks(interval_a_us);
+    uint32_t ticks_b = us_to_ftm_ticks(interval_b_us);
+    if (ticks_a == 0 || ticks_b == 0 || ticks_a > 0xFFFF || ticks_b > 0xFFFF) {
+        return -1;
+    }
+
+    int8_t event_id = alloc_event(sched, absolute_time_us, context);
+    if (event_id < 0) {
+        return -1;
+    }
+
+    hw_scheduled_event_t* event = &sched->events[event_id];
+    event->burst_callback = callback;
+    event->burst_ticks[0] = (uint16_t)ticks_a;
+    event->burst_ticks[1] = (uint16_t)ticks_b;
+    event->burst_edge = 0;
+    event->burst_edges = edges;
+    start_event(sched, event_id);
 
     return event_id;
 }
@@ -264,7 +336,7 @@ void hw_scheduler_get_stats(const hw_scheduler_t* sched,
  *
  * Called automatically by hardware when scheduled time arrives.
  */
-void hw_scheduler_ftm_isr(pwm_ftm_t ftm, pwm_channel_t channel)
+FAST_CODE void hw_scheduler_ftm_isr(pwm_ftm_t ftm, pwm_channel_t channel)
 {
     if (g_hw_sched == NULL) {
         return;
@@ -276,9 +348,31 @@ void hw_scheduler_ftm_isr(pwm_ftm_t ftm, pwm_channel_t channel)
             g_hw_sched->events[i].ftm == ftm &&
             g_hw_sched->events[i].channel == channel) {
 
+            hw_scheduled_event_t* event = &g_hw_sched->events[i];
+
+            if (event->burst_callback != NULL) {
+                uint8_t edge = event->burst_edge++;
+                event->burst_callback(event->context, edge);
+                g_hw_sched->events_fired++;
+
+                if (event->burst_edge < event->burst_edges) {
+                    // Re-arm the same channel for the next edge
+                    FTM_Type* regs = pwm_get_regs(ftm);
+                    if (regs != NULL) {
+                        regs->CONTROLS[channel].CnV =
+                            (regs->CONTROLS[channel].CnV + event->burst_ticks[edge & 1]) & 0xFFFF;
+                        regs->CONTROLS[channel].CnSC &= ~0x80;  // Clear CHF flag
+                        return;
+                    }
+                }
+
+                hw_scheduler_cancel(g_hw_sched, i);
+                break;
+            }
+
             // Fire event callback
-            if (g_hw_sched->events[i].callback != NULL) {
-                g_hw_sched->events[i].callback(g_hw_sched->events[i].context);
+            if (event->callback != NULL) {
+                event->callback(event->context);
             }
 
             // Update statistics
@@ -308,7 +402,7 @@ void hw_scheduler_ftm_isr(pwm_ftm_t ftm, pwm_channel_t channel)
 /**
  * @brief FTM1 interrupt handler
  */
-void FTM1_IRQHandler(void)
+FAST_CODE void FTM1_IRQHandler(void)
 {
     FTM_Type* ftm1 = pwm_get_regs(PWM_FTM1);
     if (ftm1 == NULL) {
@@ -326,7 +420,7 @@ void FTM1_IRQHandler(void)
 /**
  * @brief FTM2 interrupt handler
  */
-void FTM2_IRQHandler(void)
+FAST_CODE void FTM2_IRQHandler(void)
 {
     FTM_Type* ftm2 = pwm_get_regs(PWM_FTM2);
     if (ftm2 == NULL) {
@@ -5,8 +5,8 @@
  * Implements precise hardware timer scheduling using FTM Output Compare mode.
  * Provides microsecond-precision event firing without polling overhead.
  *
- * @version 2.3.0
- * @date 2026-02-12
+ * @version 2.4.0
+ * @date 2026-10-18
  *
  * Based on rusEFI:
  * - firmware/hw_layer/ports/kinetis/microsecond_timer_kinetis.cpp
@@ -44,6 +44,18 @@ extern "C" {
  */
 typedef void (*hw_event_callback_t)(void* context);
 
+/**
+ * @brief Burst edge callback type
+ *
+ * Called for each edge of a burst sequence (edge 0, 1, 2, ...).
+ */
+typedef void (*hw_burst_callback_t)(void* context, uint8_t edge);
+
+/**
+ * @brief Maximum edges in one burst sequence
+ */
+#define HW_BURST_MAX_EDGES  16
+
 /**
  * @brief Hardware scheduled event structure
  */
@@ -54,6 +66,12 @@ typedef struct {
     void* context;                    ///< User context data
     pwm_ftm_t ftm;                    ///< FTM module used
     pwm_channel_t channel;            ///< FTM channel used
+
+    // Burst sequence (one channel re-armed from its own ISR)
+    hw_burst_callback_t burst_callback;  ///< Edge callback (NULL = single event)
+    uint16_t burst_ticks[2];          ///< Alternating edge intervals (FTM ticks)
+    uint8_t burst_edge;               ///< Next edge index
+    uint8_t burst_edges;              ///< Total edges in the sequence
 } hw_scheduled_event_t;
 
 /**
@@ -99,6 +117,35 @@ int8_t hw_scheduler_schedule(hw_scheduler_t* sched,
                              hw_event_callback_t callback,
                              void* context);
 
+/**
+ * @brief Schedule a burst of edges on one hardware channel
+ *
+ * The first edge fires at absolute_time_us. Each following edge is
+ * re-armed from the channel ISR by adding interval_a_us (after even
+ * edges) or interval_b_us (after odd edges) to the compare value, so the
+ * whole sequence uses one event slot, one FTM channel and one interrupt
+ * per edge, with no angle scheduler involvement.
+ *
+ * Intervals are limited to one 16-bit FTM counter period (about 1 ms at
+ * 60 MHz bus clock, prescaler 1).
+ *
+ * @param sched Pointer to hardware scheduler structure
+ * @param absolute_time_us Absolute time of edge 0 (µs)
+ * @param interval_a_us Interval after even edges (µs)
+ * @param interval_b_us Interval after odd edges (µs)
+ * @param edges Number of edges (1-HW_BURST_MAX_EDGES)
+ * @param callback Function called on each edge
+ * @param context User context pointer (passed to callback)
+ * @return Event ID (0-7) if scheduled, -1 if queue full or invalid
+ */
+int8_t hw_scheduler_schedule_burst(hw_scheduler_t* sched,
+                                   uint32_t absolute_time_us,
+                                   uint32_t interval_a_us,
+                                   uint32_t interval_b_us,
+                                   uint8_t edges,
+                                   hw_burst_callback_t callback,
+                                   void* context);
+
 /**
  * @brief Cancel a scheduled event
  *
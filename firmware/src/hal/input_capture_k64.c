@@ -1,7 +1,7 @@
 /**
  * @file input_capture_k64.c
  * @brief Input Capture driver implementation for Kinetis K64
- * @version 2.3.0
+ * @version 2.4.0
  * @date 2026-02-12
  *
  * @copyright Copyright (c) 2026 - GPL v3 License
@@ -11,17 +11,33 @@
 #include <stddef.h>
 #include "input_capture_k64.h"
 #include "clock_k64.h"
+#include "compiler_k64.h"
+#include "dma_k64.h"
+#include "event_trace.h"
 
 //=============================================================================
 // Private Variables
 //=============================================================================
 
 // Callback storage for each FTM channel
-static ic_callback_t ic_callbacks[4][8] = {{NULL}};  // 4 FTMs, 8 channels each
+FAST_DATA static ic_callback_t ic_callbacks[4][8] = {{NULL}};  // 4 FTMs, 8 channels each
 
 // Last capture values for period calculation
 static uint32_t last_capture[4][8] = {{0}};
 
+// DMA capture mode: timestamp rings filled by eDMA
+typedef struct {
+    bool active;
+    pwm_ftm_t ftm;
+    pwm_channel_t channel;
+    uint8_t dma_channel;
+    uint16_t read_index;         // Next edge to hand to the callback
+    volatile bool busy;          // Batch being processed
+} ic_dma_stream_t;
+
+FAST_DATA static ic_dma_stream_t ic_dma_streams[IC_DMA_MAX_STREAMS];
+DMA_BUFFER static uint16_t ic_dma_rings[IC_DMA_MAX_STREAMS][IC_DMA_RING_SIZE];
+
 // Engine position tracking
 // static engine_position_t engine_pos = {0};
 // static uint16_t crank_teeth_per_rev = 36;
@@ -60,6 +76,77 @@ static uint32_t ticks_to_us(uint32_t ticks, pwm_ftm_t ftm) {
     return (uint32_t)period_us;
 }
 
+/**
+ * @brief Find the DMA stream of a capture channel
+ */
+FAST_CODE static int8_t ic_dma_find(pwm_ftm_t ftm, pwm_channel_t channel) {
+    for (uint8_t i = 0; i < IC_DMA_MAX_STREAMS; i++) {
+        if (ic_dma_streams[i].active && ic_dma_streams[i].ftm == ftm &&
+            ic_dma_streams[i].channel == channel) {
+            return (int8_t)i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Ring index the DMA will write next
+ */
+FAST_CODE static uint16_t ic_dma_write_index(uint8_t stream) {
+    uint32_t offset = dma_get_dest_address(ic_dma_streams[stream].dma_channel) -
+                      (uint32_t)ic_dma_rings[stream];
+    return (uint16_t)((offset / sizeof(uint16_t)) % IC_DMA_RING_SIZE);
+}
+
+/**
+ * @brief Hand buffered edges to the channel callback, oldest first
+ */
+FAST_CODE static uint16_t ic_dma_drain(uint8_t stream) {
+    ic_dma_stream_t* s = &ic_dma_streams[stream];
+
+    // A higher-priority caller leaves the batch to the one in progress
+    if (s->busy) {
+        return 0;
+    }
+    s->busy = true;
+
+    ic_callback_t callback = ic_callbacks[s->ftm][s->channel];
+    uint16_t write = ic_dma_write_index(stream);
+    uint16_t count = 0;
+
+    while (s->read_index != write) {
+        if (callback != NULL) {
+            callback(ic_dma_rings[stream][s->read_index]);
+        }
+        s->read_index = (uint16_t)((s->read_index + 1) % IC_DMA_RING_SIZE);
+        count++;
+    }
+
+    s->busy = false;
+    return count;
+}
+
+/**
+ * @brief DMA half/full ring interrupt
+ */
+FAST_CODE static void ic_dma_callback(uint8_t dma_channel, void* context) {
+    (void)dma_channel;
+    ic_dma_drain((uint8_t)(uintptr_t)context);
+}
+
+/**
+ * @brief DMAMUX request source of an FTM channel
+ */
+static int16_t ic_dma_source(pwm_ftm_t ftm, pwm_channel_t channel) {
+    switch (ftm) {
+        case PWM_FTM0: return DMA_SOURCE_FTM0_CH(channel);
+        case PWM_FTM1: return (channel <= PWM_CHANNEL_1) ? (int16_t)DMA_SOURCE_FTM1_CH(channel) : -1;
+        case PWM_FTM2: return (channel <= PWM_CHANNEL_1) ? (int16_t)DMA_SOURCE_FTM2_CH(channel) : -1;
+        case PWM_FTM3: return DMA_SOURCE_FTM3_CH(channel);
+        default:       return -1;
+    }
+}
+
 //=============================================================================
 // Public Functions
 //=============================================================================
@@ -108,6 +195,70 @@ void ic_register_callback(pwm_ftm_t ftm, pwm_channel_t channel,
     }
 }
 
+bool ic_dma_init(pwm_ftm_t ftm, pwm_channel_t channel, uint8_t dma_channel) {
+    FTM_Type* ftm_regs = pwm_get_regs(ftm);
+    int16_t source = ic_dma_source(ftm, channel);
+    if (ftm_regs == NULL || channel > PWM_CHANNEL_7 || source < 0 ||
+        dma_channel >= DMA_NUM_CHANNELS || ic_dma_find(ftm, channel) >= 0) {
+        return false;
+    }
+
+    int8_t stream = -1;
+    for (uint8_t i = 0; i < IC_DMA_MAX_STREAMS; i++) {
+        if (!ic_dma_streams[i].active) {
+            stream = (int8_t)i;
+            break;
+        }
+    }
+    if (stream < 0) {
+        return false;
+    }
+
+    ic_dma_stream_t* s = &ic_dma_streams[stream];
+    s->ftm = ftm;
+    s->channel = channel;
+    s->dma_channel = dma_channel;
+    s->read_index = 0;
+    s->busy = false;
+
+    dma_register_callback(dma_channel, ic_dma_callback, (void*)(uintptr_t)stream);
+    if (!dma_start_periph_to_ring(dma_channel, (uint8_t)source,
+                                  &ftm_regs->CONTROLS[channel].CnV,
+                                  ic_dma_rings[stream], IC_DMA_RING_SIZE,
+                                  DMA_SIZE_16BIT, true)) {
+        dma_register_callback(dma_channel, NULL, NULL);
+        return false;
+    }
+    s->active = true;
+
+    // CHIE + DMA: the capture raises a DMA request instead of an interrupt
+    ftm_regs->CONTROLS[channel].CnSC |= FTM_CnSC_CHIE | FTM_CnSC_DMA;
+
+    return true;
+}
+
+FAST_CODE uint16_t ic_dma_process(pwm_ftm_t ftm, pwm_channel_t channel) {
+    int8_t stream = ic_dma_find(ftm, channel);
+    if (stream < 0) {
+        return 0;
+    }
+
+    return ic_dma_drain((uint8_t)stream);
+}
+
+FAST_CODE uint16_t ic_dma_peek_last(pwm_ftm_t ftm, pwm_channel_t channel, uint32_t* timestamp) {
+    int8_t stream = ic_dma_find(ftm, channel);
+    if (stream < 0 || timestamp == NULL) {
+        return 0;
+    }
+
+    uint16_t write = ic_dma_write_index((uint8_t)stream);
+    *timestamp = ic_dma_rings[stream][(write + IC_DMA_RING_SIZE - 1) % IC_DMA_RING_SIZE];
+
+    return (uint16_t)((write + IC_DMA_RING_SIZE - ic_dma_streams[stream].read_index) %
+                      IC_DMA_RING_SIZE);
+}
+
 uint32_t ic_get_capture_value(pwm_ftm_t ftm, pwm_channel_t channel) {
     FTM_Type* ftm_regs = pwm_get_regs(ftm);
     if (ftm_regs == NULL || channel > PWM_CHANNEL_7) {
@@ -205,7 +356,7 @@ void ic_clear_event(pwm_ftm_t ftm, pwm_channel_t channel) {
  * for missing tooth detection and synchronization, and rusEFI RPM
  * calculator for filtered RPM with exponential moving average.
  */
-static void crank_sensor_callback(uint32_t timestamp) {
+FAST_CODE static void crank_sensor_callback(uint32_t timestamp) {
     // Process tooth through rusEFI trigger decoder
     trigger_decoder_process_tooth(&crank_decoder, timestamp);
 
@@ -232,6 +383,9 @@ static void crank_sensor_callback(uint32_t timestamp) {
         engine_pos.rpm = 0;
         engine_pos.tooth_count = 0;
     }
+
+    event_trace_record(EVENT_TRACE_TOOTH, EVENT_TRACE_NO_CYLINDER,
+                       (uint16_t)engine_pos.tooth_count);
 }
 
 void crank_sensor_init(uint16_t teeth_per_rev, uint16_t missing_teeth,
@@ -307,5 +461,28 @@ bool is_engine_synced(void) {
 // Interrupt Handlers (shared with PWM, need to check mode)
 //=============================================================================
 
-// Note: FTM interrupt handlers would be added here to dispatch to
-// registered callbacks based on channel interrupt flags
+// FTM1/FTM2 handlers live in hardware_scheduler_k64.c (output compare).
+// FTM0 carries the crank/cam inputs and dispatches to registered callbacks.
+
+/**
+ * @brief FTM0 interrupt handler (crank/cam trigger input capture)
+ */
+FAST_CODE void FTM0_IRQHandler(void) {
+    FTM_Type* ftm_regs = pwm_get_regs(PWM_FTM0);
+    if (ftm_regs == NULL) {
+        return;
+    }
+
+    for (uint8_t ch = 0; ch < 8; ch++) {
+        uint32_t cnsc = ftm_regs->CONTROLS[ch].CnSC;
+        // CHF set and CHIE enabled; channels in DMA mode are left to the DMA
+        if ((cnsc & (0xC0 | FTM_CnSC_DMA)) == 0xC0) {
+            uint32_t timestamp = ftm_regs->CONTROLS[ch].CnV;
+            ftm_regs->CONTROLS[ch].CnSC = cnsc & ~0x80;  // Clear CHF
+
+            if (ic_callbacks[PWM_FTM0][ch] != NULL) {
+                ic_callbacks[PWM_FTM0][ch](timestamp);
+            }
+        }
+    }
+}
@@ -13,6 +13,11 @@
  * - Interrupt-driven callbacks
  * - RPM calculation
  * - Support for VR (variable reluctance) and Hall effect sensors
+ * - Optional DMA capture mode: each capture is copied by eDMA into a
+ *   timestamp ring, and the callback runs in batches from the half/full
+ *   ring interrupt (one interrupt per IC_DMA_RING_SIZE/2 edges) or from
+ *   ic_dma_process() when fresher position is needed.
+ *   ic_dma_peek_last() reads the newest timestamp without processing.
  *
  * @copyright Copyright (c) 2026 - GPL v3 License
  */
@@ -48,6 +53,16 @@ typedef struct {
 // Input Capture Callback Function Type
 //=============================================================================
 
+/**
+ * @brief Timestamp ring size for DMA capture mode (edges)
+ */
+#define IC_DMA_RING_SIZE    32
+
+/**
+ * @brief Maximum channels in DMA capture mode
+ */
+#define IC_DMA_MAX_STREAMS  4
+
 /**
  * @brief Callback function type for input capture events
  * @param timestamp Timer value at capture (in timer ticks)
@@ -162,6 +177,46 @@ bool ic_event_occurred(pwm_ftm_t ftm, pwm_channel_t channel);
  */
 void ic_clear_event(pwm_ftm_t ftm, pwm_channel_t channel);
 
+/**
+ * @brief Switch a capture channel to DMA capture mode
+ *
+ * The channel must be set up with ic_init() and have its callback
+ * registered. Captures no longer raise an FTM interrupt: eDMA copies CnV
+ * into a ring and the callback is called once per buffered edge, in order,
+ * from the DMA half/full interrupt or ic_dma_process(). The FTM counter
+ * must not wrap between two processed edges more than the callback copes
+ * with today (same 16-bit timestamps as interrupt mode).
+ *
+ * @param ftm FlexTimer module
+ * @param channel Input capture channel
+ * @param dma_channel eDMA channel to use (0-15, not shared)
+ * @return true on success
+ */
+bool ic_dma_init(pwm_ftm_t ftm, pwm_channel_t channel, uint8_t dma_channel);
+
+/**
+ * @brief Process all buffered edges of a DMA capture channel now
+ *
+ * For the angle scheduler when it needs current position before the
+ * next half/full interrupt. Callers at a higher priority than the DMA
+ * interrupt return early if a batch is already being processed.
+ *
+ * @param ftm FlexTimer module
+ * @param channel Input capture channel
+ * @return Number of edges processed
+ */
+uint16_t ic_dma_process(pwm_ftm_t ftm, pwm_channel_t channel);
+
+/**
+ * @brief Read the newest DMA-captured timestamp without processing
+ *
+ * @param ftm FlexTimer module
+ * @param channel Input capture channel
+ * @param timestamp Receives the newest capture value (ticks)
+ * @return Edges captured but not yet processed (0 = no new edge)
+ */
+uint16_t ic_dma_peek_last(pwm_ftm_t ftm, pwm_channel_t channel, uint32_t* timestamp);
+
 //=============================================================================
 // High-Level Crank/Cam Functions
 //=============================================================================
@@ -11,6 +11,7 @@
 #include <stddef.h>
 #include "pit_k64.h"
 #include "clock_k64.h"
+#include "compiler_k64.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -26,7 +27,10 @@ extern "C" {
 // Private Variables
 //=============================================================================
 
-static pit_callback_t pit_callbacks[4] = {NULL, NULL, NULL, NULL};
+FAST_DATA static pit_callback_t pit_callbacks[4] = {NULL, NULL, NULL, NULL};
+
+// Interrupt entry latency per channel, in bus clock ticks
+FAST_DATA static pit_latency_t pit_latency[4];
 
 //=============================================================================
 // Private Helper Functions
@@ -52,11 +56,32 @@ static uint32_t pit_us_to_ticks(uint32_t period_us) {
     return (uint32_t)ticks;
 }
 
+/**
+ * @brief Record interrupt entry latency for a channel
+ *
+ * The timer reloads LDVAL and keeps counting down when it expires, so
+ * LDVAL - CVAL on ISR entry is the time since the interrupt was raised.
+ */
+static inline void pit_record_latency(uint8_t channel) {
+    uint32_t ticks = PIT->TIMER[channel].LDVAL - PIT->TIMER[channel].CVAL;
+    pit_latency_t* lat = &pit_latency[channel];
+
+    lat->last_ticks = ticks;
+    if (lat->samples == 0 || ticks < lat->min_ticks) {
+        lat->min_ticks = ticks;
+    }
+    if (ticks > lat->max_ticks) {
+        lat->max_ticks = ticks;
+    }
+    lat->samples++;
+}
+
 //=============================================================================
 // Interrupt Handlers
 //=============================================================================
 
-void PIT0_IRQHandler(void) {
+FAST_CODE void PIT0_IRQHandler(void) {
+    pit_record_latency(0);
     if (PIT->TIMER[0].TFLG & PIT_TFLG_TIF) {
         // Clear interrupt flag
         PIT->TIMER[0].TFLG = PIT_TFLG_TIF;
@@ -68,7 +93,8 @@ void PIT0_IRQHandler(void) {
     }
 }
 
-void PIT1_IRQHandler(void) {
+FAST_CODE void PIT1_IRQHandler(void) {
+    pit_record_latency(1);
     if (PIT->TIMER[1].TFLG & PIT_TFLG_TIF) {
         PIT->TIMER[1].TFLG = PIT_TFLG_TIF;
         if (pit_callbacks[1] != NULL) {
@@ -77,7 +103,8 @@ void PIT1_IRQHandler(void) {
     }
 }
 
-void PIT2_IRQHandler(void) {
+FAST_CODE void PIT2_IRQHandler(void) {
+    pit_record_latency(2);
     if (PIT->TIMER[2].TFLG & PIT_TFLG_TIF) {
         PIT->TIMER[2].TFLG = PIT_TFLG_TIF;
         if (pit_callbacks[2] != NULL) {
@@ -86,7 +113,8 @@ void PIT2_IRQHandler(void) {
     }
 }
 
-void PIT3_IRQHandler(void) {
+FAST_CODE void PIT3_IRQHandler(void) {
+    pit_record_latency(3);
     if (PIT->TIMER[3].TFLG & PIT_TFLG_TIF) {
         PIT->TIMER[3].TFLG = PIT_TFLG_TIF;
         if (pit_callbacks[3] != NULL) {
@@ -190,3 +218,21 @@ void pit_clear_interrupt_flag(pit_channel_t channel) {
         PIT->TIMER[channel].TFLG = PIT_TFLG_TIF;
     }
 }
+
+bool pit_get_latency(pit_channel_t channel, pit_latency_t* latency) {
+    if (channel > PIT_CHANNEL_3 || latency == NULL) {
+        return false;
+    }
+
+    *latency = pit_latency[channel];
+    return true;
+}
+
+void pit_reset_latency(pit_channel_t channel) {
+    if (channel <= PIT_CHANNEL_3) {
+        pit_latency[channel].last_ticks = 0;
+        pit_latency[channel].min_ticks = 0;
+        pit_latency[channel].max_ticks = 0;
+        pit_latency[channel].samples = 0;
+    }
+}
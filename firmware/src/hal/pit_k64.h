@@ -50,6 +50,24 @@ typedef struct {
 
 typedef void (*pit_callback_t)(void);
 
+//=============================================================================
+// PIT Interrupt Latency Statistics
+//=============================================================================
+
+/**
+ * @brief Interrupt entry latency, in bus clock ticks (60 MHz)
+ *
+ * Measured from timer expiry to the first instruction of the ISR. Compare
+ * builds with and without ENABLE_RAMFUNC to see the effect of running
+ * handlers from SRAM_L.
+ */
+typedef struct {
+    uint32_t last_ticks;         // Latency of the most recent interrupt
+    uint32_t min_ticks;          // Minimum observed latency
+    uint32_t max_ticks;          // Maximum observed latency
+    uint32_t samples;            // Number of interrupts measured
+} pit_latency_t;
+
 //=============================================================================
 // PIT Register Definitions
 //=============================================================================
@@ -156,4 +174,20 @@ bool pit_get_interrupt_flag(pit_channel_t channel);
  */
 void pit_clear_interrupt_flag(pit_channel_t channel);
 
+/**
+ * @brief Get interrupt entry latency statistics
+ *
+ * @param channel PIT channel
+ * @param latency Output statistics
+ * @return true if channel valid
+ */
+bool pit_get_latency(pit_channel_t channel, pit_latency_t* latency);
+
+/**
+ * @brief Reset interrupt entry latency statistics
+ *
+ * @param channel PIT channel
+ */
+void pit_reset_latency(pit_channel_t channel);
+
 #endif // PIT_K64_H
@@ -29,6 +29,13 @@
 #define PWM_MAX_PRESCALER           7     // Maximum prescaler value (divide by 128)
 #define PWM_MIN_FREQUENCY           1     // Minimum frequency in Hz
 #define PWM_MAX_FREQUENCY           1000000  // Maximum frequency in Hz
+#define PWM_DUTY_FULL_SCALE         10000    // pwm_duty_ticks() units (0.01%)
+
+//=============================================================================
+// Private Variables
+//=============================================================================
+
+static uint8_t pwm_sync_ftms = 0;     // FTMs set up by pwm_sync_enable() (bit n = FTMn)
 
 //=============================================================================
 // Private Helper Functions
@@ -105,6 +112,21 @@ static bool pwm_calculate_parameters(uint32_t frequency_hz,
     return false;
 }
 
+/**
+ * @brief Latch buffered register writes on a synchronized FTM
+ *
+ * Without pwm_sync_enable() the writes already took effect; nothing to do.
+ *
+ * @param ftm FTM module
+ * @param ftm_regs FTM registers
+ */
+static void pwm_latch(pwm_ftm_t ftm, FTM_Type* ftm_regs) {
+    if (pwm_sync_ftms & (1 << ftm)) {
+        ftm_regs->PWMLOAD |= FTM_PWMLOAD_LDOK;
+        ftm_regs->SYNC |= FTM_SYNC_SWSYNC;
+    }
+}
+
 //=============================================================================
 // Public Functions
 //=============================================================================
@@ -171,6 +193,7 @@ bool pwm_channel_init(pwm_ftm_t ftm, pwm_channel_t channel,
     uint16_t modulo = ftm_regs->MOD;
     uint16_t duty_value = (modulo * config->duty_cycle_percent) / 100;
     ftm_regs->CONTROLS[channel].CnV = duty_value;
+    pwm_latch(ftm, ftm_regs);
 
     // Configure channel mode (edge-aligned PWM)
     uint32_t cnsc = FTM_CnSC_MSB;  // PWM mode
@@ -213,6 +236,7 @@ void pwm_set_duty_cycle(pwm_ftm_t ftm, pwm_channel_t channel,
     uint16_t duty_value = (modulo * duty_percent) / 100;
 
     ftm_regs->CONTROLS[channel].CnV = duty_value;
+    pwm_latch(ftm, ftm_regs);
 }
 
 void pwm_set_duty_value(pwm_ftm_t ftm, pwm_channel_t channel,
@@ -223,6 +247,7 @@ void pwm_set_duty_value(pwm_ftm_t ftm, pwm_channel_t channel,
     }
 
     ftm_regs->CONTROLS[channel].CnV = duty_value;
+    pwm_latch(ftm, ftm_regs);
 }
 
 bool pwm_set_frequency(pwm_ftm_t ftm, uint32_t frequency_hz) {
@@ -249,6 +274,7 @@ bool pwm_set_frequency(pwm_ftm_t ftm, uint32_t frequency_hz) {
 
     // Re-enable counter
     ftm_regs->SC = sc;
+    pwm_latch(ftm, ftm_regs);
 
     return true;
 }
@@ -307,4 +333,104 @@ void pwm_set_pulse_width_us(pwm_ftm_t ftm, pwm_channel_t channel,
     }
 
     ftm_regs->CONTROLS[channel].CnV = (uint16_t)ticks;
+    pwm_latch(ftm, ftm_regs);
+}
+
+uint16_t pwm_duty_ticks(pwm_ftm_t ftm, uint16_t duty_permyriad) {
+    FTM_Type* ftm_regs = pwm_get_regs(ftm);
+    if (ftm_regs == NULL) {
+        return 0;
+    }
+
+    if (duty_permyriad > PWM_DUTY_FULL_SCALE) {
+        duty_permyriad = PWM_DUTY_FULL_SCALE;
+    }
+
+    uint32_t modulo = ftm_regs->MOD;
+    return (uint16_t)((modulo * duty_permyriad) / PWM_DUTY_FULL_SCALE);
+}
+
+bool pwm_sync_enable(pwm_ftm_t ftm, uint8_t channel_mask) {
+    FTM_Type* ftm_regs = pwm_get_regs(ftm);
+    if (ftm_regs == NULL || channel_mask == 0) {
+        return false;
+    }
+
+    // Enhanced mode; SYNCONF/COMBINE are write protected unless WPDIS
+    ftm_regs->MODE |= FTM_MODE_WPDIS;
+    ftm_regs->MODE |= FTM_MODE_FTMEN;
+
+    // Software trigger loads the MOD/CNTIN/CnV buffers
+    ftm_regs->SYNCONF |= FTM_SYNCONF_SYNCMODE | FTM_SYNCONF_SWWRBUF;
+
+    // Load at the period boundary: overflow (edge-aligned) or
+    // counter = CNTIN (center-aligned)
+    if (ftm_regs->SC & FTM_SC_CPWMS) {
+        ftm_regs->SYNC = FTM_SYNC_CNTMIN;
+    } else {
+        ftm_regs->SYNC = FTM_SYNC_CNTMAX;
+    }
+
+    // CnV synchronization is enabled per channel pair
+    uint32_t combine = ftm_regs->COMBINE;
+    for (uint8_t pair = 0; pair < PWM_NUM_CHANNELS / 2; pair++) {
+        if (channel_mask & (0x03 << (2 * pair))) {
+            combine |= FTM_COMBINE_SYNCEN(pair);
+        }
+    }
+    ftm_regs->COMBINE = combine;
+
+    pwm_sync_ftms |= (uint8_t)(1 << ftm);
+    return true;
+}
+
+void pwm_batch_clear(pwm_batch_t* batch) {
+    if (batch == NULL) {
+        return;
+    }
+
+    for (uint8_t f = 0; f < PWM_NUM_FTM; f++) {
+        batch->pending[f] = 0;
+    }
+}
+
+bool pwm_batch_set(pwm_batch_t* batch, pwm_ftm_t ftm, pwm_channel_t channel,
+                   uint16_t duty_ticks) {
+    if (batch == NULL || ftm >= PWM_NUM_FTM || channel > PWM_CHANNEL_7) {
+        return false;
+    }
+
+    batch->ticks[ftm][channel] = duty_ticks;
+    batch->pending[ftm] |= (uint8_t)(1 << channel);
+    return true;
+}
+
+uint8_t pwm_batch_commit(pwm_batch_t* batch) {
+    if (batch == NULL) {
+        return 0;
+    }
+
+    uint8_t updated = 0;
+
+    for (uint8_t f = 0; f < PWM_NUM_FTM; f++) {
+        uint8_t pending = batch->pending[f];
+        if (pending == 0) {
+            continue;
+        }
+
+        FTM_Type* ftm_regs = pwm_get_regs((pwm_ftm_t)f);
+
+        // Buffered on a synced FTM: nothing changes until the latch below
+        for (uint8_t ch = 0; ch < PWM_NUM_CHANNELS; ch++) {
+            if (pending & (1 << ch)) {
+                ftm_regs->CONTROLS[ch].CnV = batch->ticks[f][ch];
+            }
+        }
+
+        pwm_latch((pwm_ftm_t)f, ftm_regs);
+        batch->pending[f] = 0;
+        updated++;
+    }
+
+    return updated;
 }
@@ -14,6 +14,9 @@
  * - Complementary PWM with dead-time insertion
  * - Frequency range: 1 Hz - 60 MHz
  * - 16-bit resolution
+ * - Synchronized batch updates: duty values for many channels are staged
+ *   in a pwm_batch_t and latched together at the next period boundary
+ *   with one software sync per FTM (pwm_sync_enable(), pwm_batch_commit())
  *
  * @copyright Copyright (c) 2026 - GPL v3 License
  */
@@ -78,6 +81,24 @@ typedef struct {
     bool enable_prescaler_auto;  // Automatically calculate prescaler
 } pwm_config_t;
 
+//=============================================================================
+// PWM Batch Update
+//=============================================================================
+
+#define PWM_NUM_FTM                 4
+#define PWM_NUM_CHANNELS            8
+
+/**
+ * @brief Duty values staged for one synchronized update
+ *
+ * Values are timer ticks (0-MOD, see pwm_duty_ticks()); a channel is only
+ * written if its pending bit is set.
+ */
+typedef struct {
+    uint16_t ticks[PWM_NUM_FTM][PWM_NUM_CHANNELS];
+    uint8_t pending[PWM_NUM_FTM];     // Staged channels (bit n = channel n)
+} pwm_batch_t;
+
 //=============================================================================
 // PWM Channel Configuration
 //=============================================================================
@@ -156,6 +177,25 @@ typedef struct {
 #define FTM_CnSC_PWM_HIGH           (FTM_CnSC_MSB | FTM_CnSC_ELSB)
 #define FTM_CnSC_PWM_LOW            (FTM_CnSC_MSB | FTM_CnSC_ELSA)
 
+// FTM_MODE bits
+#define FTM_MODE_FTMEN              0x00000001  // FTM Enable (enhanced features)
+#define FTM_MODE_WPDIS              0x00000004  // Write Protection Disable
+
+// FTM_SYNC bits
+#define FTM_SYNC_CNTMIN             0x00000001  // Load at counter = CNTIN
+#define FTM_SYNC_CNTMAX             0x00000002  // Load at counter = MOD
+#define FTM_SYNC_SWSYNC             0x00000080  // Software trigger
+
+// FTM_SYNCONF bits
+#define FTM_SYNCONF_SYNCMODE        0x00000080  // Enhanced PWM synchronization
+#define FTM_SYNCONF_SWWRBUF         0x00000200  // Software trigger loads MOD/CNTIN/CnV
+
+// FTM_COMBINE bits (channel pair n = channels 2n, 2n+1)
+#define FTM_COMBINE_SYNCEN(pair)    (0x00000020UL << (8 * (pair)))
+
+// FTM_PWMLOAD bits
+#define FTM_PWMLOAD_LDOK            0x00000200  // Load enable
+
 //=============================================================================
 // Function Prototypes
 //=============================================================================
@@ -247,4 +287,70 @@ uint16_t pwm_get_modulo(pwm_ftm_t ftm);
 void pwm_set_pulse_width_us(pwm_ftm_t ftm, pwm_channel_t channel,
                             uint32_t pulse_us);
 
+/**
+ * @brief Convert a duty cycle to timer ticks
+ *
+ * Done once when a duty changes (or at configuration time for fixed
+ * duties), so the update path only writes integers.
+ *
+ * @param ftm FlexTimer module
+ * @param duty_permyriad Duty cycle in 0.01% units (0-10000)
+ * @return Duty value for pwm_set_duty_value() / pwm_batch_set() (0-MOD)
+ */
+uint16_t pwm_duty_ticks(pwm_ftm_t ftm, uint16_t duty_permyriad);
+
+/**
+ * @brief Enable synchronized (buffered) duty updates on an FTM
+ *
+ * Sets FTMEN and enhanced software synchronization, and SYNCEN for every
+ * channel pair containing a channel in channel_mask. CnV writes to those
+ * channels then go to the write buffers and latch together at the next
+ * counter overflow (MOD) after a software sync. Channels outside the mask
+ * (e.g. output compare on the same FTM) keep immediate updates.
+ *
+ * The single-channel setters (pwm_set_duty_*()) keep working on a synced
+ * FTM: each issues its own sync.
+ *
+ * Call after pwm_init() and pwm_channel_init().
+ *
+ * @param ftm FlexTimer module
+ * @param channel_mask PWM channels to synchronize (bit n = channel n)
+ * @return true if configured
+ */
+bool pwm_sync_enable(pwm_ftm_t ftm, uint8_t channel_mask);
+
+/**
+ * @brief Clear all staged values
+ *
+ * @param batch Batch to clear
+ */
+void pwm_batch_clear(pwm_batch_t* batch);
+
+/**
+ * @brief Stage a duty value for the next commit
+ *
+ * Staging the same channel twice keeps the last value.
+ *
+ * @param batch Batch
+ * @param ftm FlexTimer module
+ * @param channel PWM channel
+ * @param duty_ticks Duty value in timer ticks (0-MOD)
+ * @return true if staged
+ */
+bool pwm_batch_set(pwm_batch_t* batch, pwm_ftm_t ftm, pwm_channel_t channel,
+                   uint16_t duty_ticks);
+
+/**
+ * @brief Write all staged values and latch them together
+ *
+ * Per FTM with staged channels: the CnV buffers are written, then one
+ * software sync (and LDOK) latches them at the next period boundary.
+ * FTMs without pwm_sync_enable() get plain CnV writes. The batch is
+ * cleared.
+ *
+ * @param batch Batch
+ * @return Number of FTM modules updated
+ */
+uint8_t pwm_batch_commit(pwm_batch_t* batch);
+
 #endif // PWM_K64_H
@@ -11,7 +11,10 @@
 #include "spi_k64.h"
 #include "sim_k64.h"
 #include "gpio_k64.h"
+#include "dma_k64.h"
+#include "compiler_k64.h"
 #include <stdint.h>
+#include <stddef.h>
 
 //=============================================================================
 // SPI Register Definitions
@@ -27,11 +30,14 @@
 #define SPI_CTAR(base, n) (*((volatile uint32_t*)(base + 0x0C + (n * 4))))
 #define SPI_SR(base)    (*((volatile uint32_t*)(base + 0x2C)))
 #define SPI_DR(base)    (*((volatile uint32_t*)(base + 0x30)))
+#define SPI_RSER(base)  (*((volatile uint32_t*)(base + 0x30)))
 #define SPI_PUSHR(base) (*((volatile uint32_t*)(base + 0x34)))
 #define SPI_POPR(base)  (*((volatile uint32_t*)(base + 0x38)))
 
 // SPI MCR bits
 #define SPI_MCR_HALT        (1 << 0)
+#define SPI_MCR_PCSIS(x)    ((x) << 16)
+#define SPI_MCR_PCSSE       (1 << 25)
 #define SPI_MCR_SMPL_PT(x)  ((x) << 8)
 #define SPI_MCR_CLR_TXF     (1 << 10)
 #define SPI_MCR_CLR_RXF     (1 << 11)
@@ -72,8 +78,15 @@
 #define SPI_SR_TXFULL       (1 << 23)
 #define SPI_SR_RXEMPTY      (1 << 22)
 
+// SPI RSER bits
+#define SPI_RSER_TFFF_RE    (1 << 25)
+#define SPI_RSER_TFFF_DIRS  (1 << 24)
+#define SPI_RSER_RFDF_RE    (1 << 17)
+#define SPI_RSER_RFDF_DIRS  (1 << 16)
+
 // SPI PUSHR bits
 #define SPI_PUSHR_CONT      (1 << 31)
+#define SPI_PUSHR_CTAS(x)   (((x) & 0x7) << 28)
 #define SPI_PUSHR_EOQ       (1 << 27)
 #define SPI_PUSHR_CTCAS     (1 << 26)
 #define SPI_PUSHR_PCS(x)    ((x) << 16)
@@ -119,12 +132,59 @@ static spi_config_t spi_configs[3] = {
     {SPI2_BASE, 0, SPI_CLOCK_DIV256, 8, 0, 0, 0}
 };
 
+//=============================================================================
+// Shared Bus State
+//=============================================================================
+
+typedef struct {
+    spi_transaction_t* queue[SPI_BUS_QUEUE_SIZE];  // Sorted: next to run first
+    uint8_t count;
+    spi_transaction_t* active;          // Owns the chip select
+    uint16_t chunk;                     // Bytes in the transfer in flight
+    uint32_t ctar;                      // CTAR0 currently loaded
+    uint32_t ctar1;                     // CTAR1 currently loaded
+    uint8_t pcs_direct;                 // PCSn pins given to devices (bit n)
+    uint8_t decoder_codes;              // Decoder chip selects (0 = no decoder)
+    uint32_t sequence;
+    uint8_t dma_rx;
+    uint8_t dma_tx;
+    bool running;                       // spi_bus_run() on the stack
+    bool initialized;
+    spi_bus_stats_t stats;
+} spi_bus_t;
+
+FAST_DATA static spi_bus_t spi_buses[SPI_NUM_PORTS];
+
+static const uint8_t spi_fill_byte = SPI_BUS_FILL_BYTE;
+DMA_BUFFER static uint8_t spi_sink_byte;
+
 //=============================================================================
 // Private Function Prototypes
 //=============================================================================
 
 static uint32_t spi_get_base(spi_port_t port);
+/**
+ * @brief Switch a pin to an alternate function (DSPI PCS)
+ */
+static bool spi_pin_mux(gpio_port_t port, gpio_pin_t pin, uint8_t mux) {
+    PORT_Type* pin_port;
+    switch (port) {
+        case GPIO_PORT_A: pin_port = PORTA; break;
+        case GPIO_PORT_B: pin_port = PORTB; break;
+        case GPIO_PORT_C: pin_port = PORTC; break;
+        case GPIO_PORT_D: pin_port = PORTD; break;
+        case GPIO_PORT_E: pin_port = PORTE; break;
+        default: return false;
+    }
+
+    pin_port->PCR[pin] = PORT_PCR_MUX(mux) | PORT_PCR_DSE;
+    return true;
+}
+
+static uint32_t spi_ctar_value(uint8_t data_size, uint8_t clock_div, uint8_t cpol, uint8_t cpha);
 static void spi_configure_ctar(spi_port_t port);
+static void spi_bus_run(spi_bus_t* bus);
+static bool spi_pin_mux(gpio_port_t port, gpio_pin_t pin, uint8_t mux);
 
 //=============================================================================
 // SPI Private Functions
@@ -139,23 +199,289 @@ static uint32_t spi_get_base(spi_port_t port) {
     }
 }
 
-static void spi_configure_ctar(spi_port_t port) {
-    uint32_t base = spi_get_base(port);
-    spi_config_t* config = &spi_configs[port];
-    
-    // Configure CTAR0 for master mode
-    uint32_t ctar = SPI_CTAR_FMSZ(config->data_size - 1) |
-                    SPI_CTAR_BR(config->clock_div);
+static uint32_t spi_ctar_value(uint8_t data_size, uint8_t clock_div, uint8_t cpol, uint8_t cpha) {
+    uint32_t ctar = SPI_CTAR_FMSZ(data_size - 1) |
+                    SPI_CTAR_BR(clock_div);
     
-    if (config->cpol) {
+    if (cpol) {
         ctar |= SPI_CTAR_CPOL;
     }
     
-    if (config->cpha) {
+    if (cpha) {
         ctar |= SPI_CTAR_CPHA;
     }
     
-    SPI_CTAR(base, 0) = ctar;
+    return ctar;
+}
+
+static void spi_configure_ctar(spi_port_t port) {
+    uint32_t base = spi_get_base(port);
+    spi_config_t* config = &spi_configs[port];
+    
+    // Configure CTAR0 for master mode
+    SPI_CTAR(base, 0) = spi_ctar_value(config->data_size, config->clock_div,
+                                       config->cpol, config->cpha);
+}
+
+//=============================================================================
+// Shared Bus Private Functions
+//=============================================================================
+
+/**
+ * @brief Mask interrupts around queue updates (submit may come from any ISR)
+ */
+static inline uint32_t spi_irq_save(void) {
+#if defined(__arm__)
+    uint32_t primask;
+    __asm volatile("mrs %0, primask\n cpsid i" : "=r"(primask) :: "memory");
+    return primask;
+#else
+    return 0;
+#endif
+}
+
+static inline void spi_irq_restore(uint32_t primask) {
+#if defined(__arm__)
+    __asm volatile("msr primask, %0" :: "r"(primask) : "memory");
+#else
+    (void)primask;
+#endif
+}
+
+/**
+ * @brief a runs before b: higher priority first, FIFO within a priority
+ */
+static bool spi_bus_before(const spi_transaction_t* a, const spi_transaction_t* b) {
+    if (a->priority != b->priority) {
+        return a->priority > b->priority;
+    }
+    return (int32_t)(a->sequence - b->sequence) < 0;
+}
+
+/**
+ * @brief Sorted insert (interrupts masked by the caller)
+ */
+static bool spi_bus_insert(spi_bus_t* bus, spi_transaction_t* xfer) {
+    if (bus->count >= SPI_BUS_QUEUE_SIZE) {
+        return false;
+    }
+
+    uint8_t i = bus->count;
+    while (i > 0 && spi_bus_before(xfer, bus->queue[i - 1])) {
+        bus->queue[i] = bus->queue[i - 1];
+        i--;
+    }
+    bus->queue[i] = xfer;
+    bus->count++;
+
+    if (bus->count > bus->stats.max_queued) {
+        bus->stats.max_queued = bus->count;
+    }
+    return true;
+}
+
+/**
+ * @brief Take the next transaction (interrupts masked by the caller)
+ */
+static spi_transaction_t* spi_bus_pop(spi_bus_t* bus) {
+    if (bus->count == 0) {
+        return NULL;
+    }
+
+    spi_transaction_t* xfer = bus->queue[0];
+    bus->count--;
+    for (uint8_t i = 0; i < bus->count; i++) {
+        bus->queue[i] = bus->queue[i + 1];
+    }
+    return xfer;
+}
+
+/**
+ * @brief Select the active device: CTARs (if they differ) and chip select
+ *
+ * A command chain carries its chip selects in the PUSHR words.
+ */
+static void spi_bus_select(spi_bus_t* bus, spi_port_t port) {
+    const spi_transaction_t* xfer = bus->active;
+    const spi_device_t* dev = xfer->device;
+    uint32_t base = spi_get_base(port);
+    bool load_ctar1 = (xfer->cmd != NULL && xfer->ctar1 != 0 && bus->ctar1 != xfer->ctar1);
+
+    if (bus->ctar != dev->ctar || load_ctar1) {
+        SPI_MCR(base) |= SPI_MCR_HALT;
+        SPI_CTAR(base, 0) = dev->ctar;
+        if (load_ctar1) {
+            SPI_CTAR(base, 1) = xfer->ctar1;
+            bus->ctar1 = xfer->ctar1;
+        }
+        SPI_MCR(base) &= ~SPI_MCR_HALT;
+        bus->ctar = dev->ctar;
+    }
+
+    if (xfer->cmd == NULL) {
+        gpio_clear(dev->cs_port, dev->cs_pin);
+    }
+}
+
+static void spi_bus_release(spi_bus_t* bus) {
+    const spi_device_t* dev = bus->active->device;
+    if (bus->active->cmd == NULL) {
+        gpio_set(dev->cs_port, dev->cs_pin);
+    }
+    bus->active = NULL;
+}
+
+/**
+ * @brief Start the next block of the active transaction
+ *
+ * @return true if the block already completed (polled), false if DMA
+ *         is running and spi_bus_dma_done() will follow
+ */
+static bool spi_bus_start_chunk(spi_bus_t* bus, spi_port_t port) {
+    spi_transaction_t* xfer = bus->active;
+    uint32_t base = spi_get_base(port);
+    uint16_t n = (uint16_t)(xfer->length - xfer->offset);
+
+    if (xfer->block_size != 0 && n > xfer->block_size) {
+        n = xfer->block_size;
+    }
+    bus->chunk = n;
+
+    const uint8_t* tx = (xfer->tx != NULL) ? xfer->tx + xfer->offset : NULL;
+    const uint32_t* cmd = (xfer->cmd != NULL) ? xfer->cmd + xfer->offset : NULL;
+    uint8_t* rx = (xfer->rx != NULL) ? xfer->rx + xfer->offset : NULL;
+
+    if (bus->dma_rx == SPI_BUS_NO_DMA) {
+        for (uint16_t i = 0; i < n; i++) {
+            uint8_t b;
+            if (cmd != NULL) {
+                while (!(SPI_SR(base) & SPI_SR_TFFF));
+                SPI_PUSHR(base) = cmd[i];
+                while (!(SPI_SR(base) & SPI_SR_RFDF));
+                b = SPI_POPR(base) & 0xFF;
+                SPI_SR(base) = SPI_SR_RFDF | SPI_SR_TCF | SPI_SR_EOQF;
+            } else {
+                b = spi_transmit_byte(port, (tx != NULL) ? tx[i] : SPI_BUS_FILL_BYTE);
+            }
+            if (rx != NULL) {
+                rx[i] = b;
+            }
+        }
+        return true;
+    }
+
+    SPI_MCR(base) |= SPI_MCR_CLR_TXF | SPI_MCR_CLR_RXF;
+    SPI_SR(base) = SPI_SR_TCF | SPI_SR_EOQF | SPI_SR_TFUF | SPI_SR_TFFF |
+                   SPI_SR_RFOF | SPI_SR_RFDF;
+
+    dma_start_transfer(bus->dma_rx, DMA_SOURCE_SPI0_RX,
+                       &SPI_POPR(base), 0,
+                       (rx != NULL) ? (volatile void*)rx : (volatile void*)&spi_sink_byte,
+                       (rx != NULL) ? 1 : 0,
+                       n, DMA_SIZE_8BIT, true);
+    if (cmd != NULL) {
+        // Whole PUSHR words: chip select, CTAR and CONT/EOQ per byte
+        dma_start_transfer(bus->dma_tx, DMA_SOURCE_SPI0_TX,
+                           cmd, 4, &SPI_PUSHR(base), 0,
+                           n, DMA_SIZE_32BIT, false);
+    } else {
+        // Byte-wide FIFO writes reuse the command half of the last 32-bit
+        // PUSHR write, which may be a chain's PCS/CTAS(1)/EOQ. Chip select
+        // is a GPIO here: push the first byte as a whole word with a clean
+        // command (CTAS0, no PCS, no CONT/EOQ), then DMA the rest
+        SPI_PUSHR(base) = SPI_PUSHR_CTAS(0) |
+                          SPI_PUSHR_TXDATA((tx != NULL) ? tx[0] : SPI_BUS_FILL_BYTE);
+        if (n > 1) {
+            dma_start_transfer(bus->dma_tx, DMA_SOURCE_SPI0_TX,
+                               (tx != NULL) ? tx + 1 : &spi_fill_byte, (tx != NULL) ? 1 : 0,
+                               &SPI_PUSHR(base), 0,
+                               (uint16_t)(n - 1), DMA_SIZE_8BIT, false);
+        }
+    }
+
+    SPI_RSER(base) = SPI_RSER_RFDF_RE | SPI_RSER_RFDF_DIRS |
+                     SPI_RSER_TFFF_RE | SPI_RSER_TFFF_DIRS;
+    return false;
+}
+
+/**
+ * @brief Account for a finished block: complete, yield or continue
+ */
+static void spi_bus_chunk_done(spi_bus_t* bus) {
+    spi_transaction_t* xfer = bus->active;
+    xfer->offset = (uint16_t)(xfer->offset + bus->chunk);
+
+    if (xfer->offset >= xfer->length) {
+        spi_bus_release(bus);
+        bus->stats.completed++;
+        xfer->status = SPI_XFER_DONE;
+        if (xfer->callback != NULL) {
+            xfer->callback(xfer, xfer->context);
+        }
+        return;
+    }
+
+    // Block boundary: let higher priority work in, resume later in order
+    uint32_t primask = spi_irq_save();
+    if (xfer->block_size != 0 && bus->count > 0 && bus->count < SPI_BUS_QUEUE_SIZE &&
+        bus->queue[0]->priority > xfer->priority) {
+        spi_bus_release(bus);
+        xfer->status = SPI_XFER_QUEUED;
+        spi_bus_insert(bus, xfer);
+        bus->stats.preemptions++;
+    }
+    spi_irq_restore(primask);
+}
+
+/**
+ * @brief Run the queue until a DMA transfer is in flight or it is empty
+ *
+ * The caller has set bus->running, so submissions from completion
+ * callbacks only queue and are picked up by this loop.
+ */
+static void spi_bus_run(spi_bus_t* bus) {
+    spi_port_t port = (spi_port_t)(bus - spi_buses);
+
+    for (;;) {
+        if (bus->active == NULL) {
+            uint32_t primask = spi_irq_save();
+            bus->active = spi_bus_pop(bus);
+            if (bus->active == NULL) {
+                bus->running = false;
+            }
+            spi_irq_restore(primask);
+
+            if (bus->active == NULL) {
+                return;
+            }
+            bus->active->status = SPI_XFER_ACTIVE;
+            spi_bus_select(bus, port);
+        }
+
+        if (!spi_bus_start_chunk(bus, port)) {
+            bus->running = false;
+            return;
+        }
+        spi_bus_chunk_done(bus);
+    }
+}
+
+/**
+ * @brief Receive DMA complete: the whole block has been clocked
+ */
+FAST_CODE static void spi_bus_dma_done(uint8_t channel, void* context) {
+    (void)channel;
+    spi_bus_t* bus = (spi_bus_t*)context;
+    uint32_t base = spi_get_base((spi_port_t)(bus - spi_buses));
+
+    SPI_RSER(base) = 0;
+    if (bus->active == NULL) {
+        return;
+    }
+
+    bus->running = true;
+    spi_bus_chunk_done(bus);
+    spi_bus_run(bus);
 }
 
 //=============================================================================
@@ -284,3 +610,207 @@ uint8_t spi_transmit_byte(spi_port_t port, uint8_t data) {
     
     return rx_data;
 }
+
+//=============================================================================
+// Shared Bus Public Functions
+//=============================================================================
+
+bool spi_bus_init(spi_port_t port, uint8_t dma_rx_channel, uint8_t dma_tx_channel) {
+    if (port > SPI_2) {
+        return false;
+    }
+
+    spi_bus_t* bus = &spi_buses[port];
+    bool dma = (port == SPI_0 &&
+                dma_rx_channel < DMA_NUM_CHANNELS && dma_tx_channel < DMA_NUM_CHANNELS &&
+                dma_rx_channel != dma_tx_channel);
+
+    spi_init(port, SPI_MODE_MASTER, SPI_CLOCK_DIV256);
+
+    bus->count = 0;
+    bus->active = NULL;
+    bus->running = false;
+    bus->sequence = 0;
+    bus->ctar = SPI_CTAR(spi_get_base(port), 0);
+    bus->ctar1 = SPI_CTAR(spi_get_base(port), 1);
+    bus->pcs_direct = 0;
+    bus->decoder_codes = 0;
+    bus->dma_rx = dma ? dma_rx_channel : SPI_BUS_NO_DMA;
+    bus->dma_tx = dma ? dma_tx_channel : SPI_BUS_NO_DMA;
+    bus->stats.completed = 0;
+    bus->stats.preemptions = 0;
+    bus->stats.queue_full = 0;
+    bus->stats.max_queued = 0;
+
+    if (dma) {
+        dma_init();
+        dma_register_callback(bus->dma_rx, spi_bus_dma_done, bus);
+    }
+
+    bus->initialized = true;
+    return true;
+}
+
+bool spi_device_init(spi_device_t* device, spi_port_t port,
+                     gpio_port_t cs_port, gpio_pin_t cs_pin,
+                     uint8_t cpol, uint8_t cpha, uint8_t clock_div) {
+    if (device == NULL || port > SPI_2 || clock_div > SPI_CLOCK_DIV256) {
+        return false;
+    }
+
+    device->port = port;
+    device->cs_port = cs_port;
+    device->cs_pin = cs_pin;
+    device->pcs = SPI_PCS_NONE;
+    device->cpol = cpol ? 1 : 0;
+    device->cpha = cpha ? 1 : 0;
+    device->clock_div = clock_div;
+    device->ctar = spi_ctar_value(8, clock_div, device->cpol, device->cpha);
+
+    // Deassert before switching the pin to output
+    gpio_set(cs_port, cs_pin);
+    gpio_config(cs_port, cs_pin, GPIO_DIR_OUTPUT);
+
+    return true;
+}
+
+bool spi_device_use_pcs(spi_device_t* device, uint8_t pcs, uint8_t mux) {
+    if (device == NULL || pcs >= SPI_NUM_PCS || device->port > SPI_2 ||
+        !spi_buses[device->port].initialized ||
+        spi_buses[device->port].decoder_codes != 0) {
+        return false;
+    }
+
+    // Inactive high before the pin leaves GPIO (driven high already)
+    uint32_t base = spi_get_base(device->port);
+    SPI_MCR(base) |= SPI_MCR_HALT;
+    SPI_MCR(base) |= SPI_MCR_PCSIS(1U << pcs);
+    SPI_MCR(base) &= ~SPI_MCR_HALT;
+
+    if (!spi_pin_mux(device->cs_port, device->cs_pin, mux)) {
+        return false;
+    }
+    spi_buses[device->port].pcs_direct |= (uint8_t)(1U << pcs);
+    device->pcs = pcs;
+    return true;
+}
+
+bool spi_bus_use_pcs_decoder(spi_port_t port, const spi_pin_t* address,
+                             uint8_t address_bits) {
+    if (port != SPI_0 || address == NULL || address_bits == 0 ||
+        address_bits > SPI_DECODER_MAX_BITS || !spi_buses[port].initialized ||
+        spi_buses[port].pcs_direct != 0) {
+        return false;
+    }
+
+    // PCS5 becomes the strobe (inactive high); the address lines idle low
+    uint32_t base = spi_get_base(port);
+    SPI_MCR(base) |= SPI_MCR_HALT;
+    SPI_MCR(base) = (SPI_MCR(base) & ~SPI_MCR_PCSIS(0x3F)) |
+                    SPI_MCR_PCSSE | SPI_MCR_PCSIS(1U << SPI_DECODER_STROBE_PCS);
+    SPI_MCR(base) &= ~SPI_MCR_HALT;
+
+    for (uint8_t i = 0; i < address_bits; i++) {
+        if (!spi_pin_mux(address[i].port, address[i].pin, address[i].mux)) {
+            return false;
+        }
+    }
+    spi_buses[port].decoder_codes = (uint8_t)(1U << address_bits);
+    return true;
+}
+
+bool spi_device_use_decoded_pcs(spi_device_t* device, uint8_t code, uint8_t mux) {
+    if (device == NULL || device->port > SPI_2 ||
+        code >= spi_buses[device->port].decoder_codes) {
+        return false;
+    }
+
+    // The strobe pin is shared by every decoded device: already high
+    if (!spi_pin_mux(device->cs_port, device->cs_pin, mux)) {
+        return false;
+    }
+    device->pcs = (uint8_t)(SPI_PCS_DECODED | code);
+    return true;
+}
+
+uint32_t spi_pushr_command(const spi_device_t* device, uint8_t ctas,
+                           uint8_t data, bool cont, bool eoq) {
+    uint32_t word = SPI_PUSHR_CTAS(ctas) | SPI_PUSHR_TXDATA(data);
+
+    if (device != NULL && device->pcs < SPI_NUM_PCS) {
+        word |= SPI_PUSHR_PCS(1U << device->pcs);
+    } else if (device != NULL && device->pcs != SPI_PCS_NONE) {
+        // Decoder address on PCS0-4; the DSPI asserts the strobe itself
+        word |= SPI_PUSHR_PCS(device->pcs & ~SPI_PCS_DECODED);
+    }
+    if (cont) {
+        word |= SPI_PUSHR_CONT;
+    }
+    if (eoq) {
+        word |= SPI_PUSHR_EOQ;
+    }
+    return word;
+}
+
+bool spi_bus_submit(spi_transaction_t* xfer) {
+    if (xfer == NULL || xfer->device == NULL || xfer->length == 0 ||
+        xfer->device->port > SPI_2) {
+        return false;
+    }
+
+    // Byte pushes carry no chip select
+    if (xfer->cmd == NULL && xfer->device->pcs != SPI_PCS_NONE) {
+        return false;
+    }
+
+    spi_bus_t* bus = &spi_buses[xfer->device->port];
+    if (!bus->initialized) {
+        return false;
+    }
+
+    uint32_t primask = spi_irq_save();
+
+    if (xfer->status == SPI_XFER_QUEUED || xfer->status == SPI_XFER_ACTIVE) {
+        spi_irq_restore(primask);
+        return false;
+    }
+
+    xfer->offset = 0;
+    xfer->sequence = bus->sequence++;
+    xfer->status = SPI_XFER_QUEUED;
+
+    if (!spi_bus_insert(bus, xfer)) {
+        xfer->status = SPI_XFER_IDLE;
+        bus->stats.queue_full++;
+        spi_irq_restore(primask);
+        return false;
+    }
+
+    bool start = (bus->active == NULL && !bus->running);
+    if (start) {
+        bus->running = true;
+    }
+    spi_irq_restore(primask);
+
+    if (start) {
+        spi_bus_run(bus);
+    }
+    return true;
+}
+
+bool spi_bus_busy(spi_port_t port) {
+    if (port > SPI_2) {
+        return false;
+    }
+
+    const spi_bus_t* bus = &spi_buses[port];
+    return bus->active != NULL || bus->count > 0;
+}
+
+void spi_bus_get_stats(spi_port_t port, spi_bus_stats_t* stats) {
+    if (port > SPI_2 || stats == NULL) {
+        return;
+    }
+
+    *stats = spi_buses[port].stats;
+}
@@ -3,7 +3,27 @@
  * @brief SPI Driver for Teensy 3.5 (Kinetis K64)
  * @version 1.0.0
  * @date 2026-02-21
- * 
+ *
+ * Two interfaces share the ports:
+ * - Blocking byte transfers (spi_transmit_receive() etc.) for code that
+ *   owns a port alone
+ * - A shared bus: devices (spi_device_t) carry their own CPOL/CPHA, clock
+ *   and GPIO chip select, and transactions from all of them are queued by
+ *   priority and run back-to-back. On SPI0 each transfer runs by DMA and
+ *   the completion callback is called from the DMA interrupt; SPI1/SPI2
+ *   have no separate RX/TX DMA requests and run the same queue polled.
+ *   A transaction with block_size set yields the bus at block boundaries
+ *   to higher priority work (e.g. a knock IC read during an SD multi-block
+ *   write) and resumes afterwards.
+ * - Command chains: devices on the DSPI hardware chip selects
+ *   (spi_device_use_pcs()) are read by one transaction of PUSHR command
+ *   words (spi_pushr_command()). Each word carries its chip select, CTAR
+ *   and CONT, so several devices are clocked back-to-back by one DMA
+ *   transfer with a single completion interrupt. SPI0 has six PCS pins;
+ *   for more devices, PCS0-4 drive the address of an external decoder
+ *   (e.g. 74HC154 for 16 chip selects) gated by the PCS5 strobe
+ *   (spi_bus_use_pcs_decoder(), spi_device_use_decoded_pcs()).
+ *
  * @copyright Copyright (c) 2026 - GPL v3 License
  * @see https://github.com/pbuchabqui/Teensy35
  */
@@ -12,6 +32,8 @@
 #define SPI_K64_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "gpio_k64.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -47,6 +69,107 @@ typedef enum {
 #define SPI_CLOCK_DIV128    6   // 468.75kHz
 #define SPI_CLOCK_DIV256    7   // 234.375kHz
 
+//=============================================================================
+// Shared Bus
+//=============================================================================
+
+#define SPI_NUM_PORTS           3
+#define SPI_BUS_QUEUE_SIZE      16      // Queued transactions per port
+#define SPI_BUS_NO_DMA          0xFF    // spi_bus_init(): run transfers polled
+#define SPI_BUS_FILL_BYTE       0xFF    // Sent when a transaction has no tx data
+#define SPI_NUM_PCS             6       // Hardware chip selects PCS0-5 (SPI0)
+#define SPI_PCS_NONE            0xFF    // spi_device_t.pcs: GPIO chip select
+#define SPI_PCS_DECODED         0x80    // spi_device_t.pcs: decoder code in bits 0-4
+#define SPI_DECODER_MAX_BITS    5       // Decoder address lines PCS0-4
+#define SPI_DECODER_STROBE_PCS  5       // PCS5 is the decoder strobe (PCSS)
+#define SPI_NUM_DECODED_PCS     (1 << SPI_DECODER_MAX_BITS)
+
+typedef enum {
+    SPI_PRIORITY_LOW = 0,               // Logging, SD card
+    SPI_PRIORITY_NORMAL = 1,            // EGT, slow sensors
+    SPI_PRIORITY_HIGH = 2,              // Output drivers
+    SPI_PRIORITY_CRITICAL = 3,          // Angle-synchronous (knock IC)
+} spi_priority_t;
+
+typedef enum {
+    SPI_XFER_IDLE = 0,
+    SPI_XFER_QUEUED,
+    SPI_XFER_ACTIVE,
+    SPI_XFER_DONE,
+} spi_xfer_status_t;
+
+/**
+ * @brief Device on a shared bus
+ *
+ * Filled by spi_device_init(); ctar is precomputed so switching between
+ * devices costs one register write.
+ */
+typedef struct {
+    spi_port_t port;
+    gpio_port_t cs_port;
+    gpio_pin_t cs_pin;                  // Active low chip select
+    uint8_t pcs;                        // PCSn, SPI_PCS_DECODED | code or SPI_PCS_NONE
+    uint8_t cpol;
+    uint8_t cpha;
+    uint8_t clock_div;                  // SPI_CLOCK_DIV*
+    uint32_t ctar;
+} spi_device_t;
+
+/**
+ * @brief Pin and its DSPI alternate function
+ */
+typedef struct {
+    gpio_port_t port;
+    gpio_pin_t pin;
+    uint8_t mux;                        // PORT_MUX_ALT* of SPI0_PCSn on the pin
+} spi_pin_t;
+
+struct spi_transaction;
+
+/**
+ * @brief Completion callback (DMA interrupt context on SPI0)
+ */
+typedef void (*spi_done_t)(struct spi_transaction* xfer, void* context);
+
+/**
+ * @brief Queued transfer, owned by the caller until the callback
+ *
+ * tx and rx may point to the same buffer. Buffers must stay valid and
+ * untouched until status is SPI_XFER_DONE.
+ *
+ * With cmd set the transaction is a command chain: length PUSHR words
+ * are sent instead of tx, and their chip selects replace the GPIO one.
+ * device then only selects the port and CTAR0; words with CTAS 1 use
+ * ctar1. Block boundaries of a chain must fall between frames.
+ */
+typedef struct spi_transaction {
+    const spi_device_t* device;
+    const uint8_t* tx;                  // NULL = send SPI_BUS_FILL_BYTE
+    uint8_t* rx;                        // NULL = discard received bytes
+    const uint32_t* cmd;                // Command chain (NULL = tx bytes)
+    uint32_t ctar1;                     // CTAR1 of a command chain (0 = unused)
+    uint16_t length;
+    uint16_t block_size;                // Preemption points (0 = run to the end)
+    spi_priority_t priority;
+    spi_done_t callback;                // May be NULL (poll status)
+    void* context;
+
+    // Maintained by the bus
+    volatile spi_xfer_status_t status;
+    uint16_t offset;                    // Bytes transferred
+    uint32_t sequence;                  // FIFO order within a priority
+} spi_transaction_t;
+
+/**
+ * @brief Bus statistics
+ */
+typedef struct {
+    uint32_t completed;                 // Transactions finished
+    uint32_t preemptions;               // Transactions paused at a block boundary
+    uint32_t queue_full;                // Rejected submissions
+    uint8_t max_queued;                 // Queue high-water mark
+} spi_bus_stats_t;
+
 //=============================================================================
 // SPI Function Prototypes
 //=============================================================================
@@ -59,6 +182,128 @@ void spi_receive(spi_port_t port, uint8_t* data, uint16_t length);
 void spi_transmit_receive(spi_port_t port, const uint8_t* tx_data, uint8_t* rx_data, uint16_t length);
 uint8_t spi_transmit_byte(spi_port_t port, uint8_t data);
 
+/**
+ * @brief Initialize a port as a shared bus (master, idle queue)
+ *
+ * DMA is used on SPI0 when both channels are given; pass SPI_BUS_NO_DMA
+ * (or use SPI1/SPI2) to run transfers polled. The blocking functions
+ * must not be used on a shared bus port.
+ *
+ * @param port SPI port
+ * @param dma_rx_channel DMA channel for receive (0-15 or SPI_BUS_NO_DMA)
+ * @param dma_tx_channel DMA channel for transmit (0-15 or SPI_BUS_NO_DMA)
+ * @return true on success
+ */
+bool spi_bus_init(spi_port_t port, uint8_t dma_rx_channel, uint8_t dma_tx_channel);
+
+/**
+ * @brief Describe a device and configure its chip select (deasserted)
+ *
+ * @param device Device descriptor to fill
+ * @param port Bus the device is on
+ * @param cs_port Chip select GPIO port
+ * @param cs_pin Chip select GPIO pin
+ * @param cpol Clock polarity (0/1)
+ * @param cpha Clock phase (0/1)
+ * @param clock_div SPI_CLOCK_DIV*
+ * @return true on success
+ */
+bool spi_device_init(spi_device_t* device, spi_port_t port,
+                     gpio_port_t cs_port, gpio_pin_t cs_pin,
+                     uint8_t cpol, uint8_t cpha, uint8_t clock_div);
+
+/**
+ * @brief Move a device's chip select to the DSPI hardware PCS function
+ *
+ * The pin given to spi_device_init() is switched to mux (the SPI0_PCSn
+ * alternate function of that pin) and PCSn is made active low. The
+ * device can then only be used in command chains. Call after
+ * spi_bus_init().
+ *
+ * @param device Device from spi_device_init()
+ * @param pcs Hardware chip select (0 to SPI_NUM_PCS - 1)
+ * @param mux Pin mux value of SPI0_PCSn on the pin (PORT_MUX_ALT*)
+ * @return true on success, false if the port drives a decoder
+ */
+bool spi_device_use_pcs(spi_device_t* device, uint8_t pcs, uint8_t mux);
+
+/**
+ * @brief Drive an external chip select decoder from SPI0
+ *
+ * Sets MCR[PCSSE]: PCS0..PCS(address_bits - 1) carry the decoder
+ * address of each frame and PCS5 becomes an active low strobe, asserted
+ * once the address is stable, for the decoder enable input. Up to
+ * 1 << address_bits devices can then share one command chain
+ * (spi_device_use_decoded_pcs()). Call after spi_bus_init() and before
+ * any spi_device_use_pcs() on the port; the two are exclusive.
+ *
+ * @param port SPI_0 (the only port with PCS5)
+ * @param address Address pins, PCS0 first, with their SPI0_PCSn mux
+ * @param address_bits Decoder address lines (1 to SPI_DECODER_MAX_BITS)
+ * @return true on success
+ */
+bool spi_bus_use_pcs_decoder(spi_port_t port, const spi_pin_t* address,
+                             uint8_t address_bits);
+
+/**
+ * @brief Select a device through the external decoder
+ *
+ * Give spi_device_init() the PCS5 strobe pin as chip select; it is
+ * switched to mux here, like spi_device_use_pcs() does. The device can
+ * then only be used in command chains. Set up every decoded device
+ * before the first chain on the port.
+ *
+ * @param device Device from spi_device_init()
+ * @param code Decoder output of the device
+ *             (below 1 << address_bits of spi_bus_use_pcs_decoder())
+ * @param mux Pin mux value of SPI0_PCS5 on the strobe pin (PORT_MUX_ALT*)
+ * @return true on success
+ */
+bool spi_device_use_decoded_pcs(spi_device_t* device, uint8_t code, uint8_t mux);
+
+/**
+ * @brief PUSHR command word for one byte of a command chain
+ *
+ * @param device Device on a hardware or decoded chip select
+ * @param ctas CTAR to clock the byte with (0 or 1)
+ * @param data Byte to send
+ * @param cont Keep the chip select asserted after this byte (not on
+ *             the last byte of a frame)
+ * @param eoq Last word of the chain
+ * @return Command word
+ */
+uint32_t spi_pushr_command(const spi_device_t* device, uint8_t ctas,
+                           uint8_t data, bool cont, bool eoq);
+
+/**
+ * @brief Queue a transaction (any context)
+ *
+ * Starts it at once if the bus is idle. Otherwise it runs after all
+ * queued transactions of equal or higher priority, and before the rest
+ * of a lower priority transaction's blocks.
+ *
+ * @param xfer Transaction (device, buffers, length, priority filled in)
+ * @return false if the queue is full or the transaction is invalid,
+ *         already queued, or sends tx bytes to a hardware PCS device
+ */
+bool spi_bus_submit(spi_transaction_t* xfer);
+
+/**
+ * @brief Check for a transfer in progress or queued
+ *
+ * @param port SPI port
+ * @return true if the bus has work
+ */
+bool spi_bus_busy(spi_port_t port);
+
+/**
+ * @brief Read bus statistics
+ *
+ * @param port SPI port
+ * @param stats Output statistics
+ */
+void spi_bus_get_stats(spi_port_t port, spi_bus_stats_t* stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -10,6 +10,7 @@
  */
 
 #include "trigger_decoder_k64.h"
+#include "event_trace.h"
 #include <string.h>
 
 // Default synchronization ratios (rusEFI-compatible)
@@ -104,6 +105,8 @@ void trigger_decoder_process_tooth(trigger_decoder_t* decoder,
             if (!decoder->sync_locked) {
                 decoder->sync_locked = true;
                 decoder->sync_count++;
+                event_trace_record(EVENT_TRACE_SYNC, EVENT_TRACE_NO_CYLINDER,
+                                   (uint16_t)decoder->sync_count);
 
                 // Call sync callback if registered
                 if (decoder->on_sync_callback != NULL) {
@@ -126,6 +129,8 @@ void trigger_decoder_process_tooth(trigger_decoder_t* decoder,
     if (decoder->sync_locked) {
         if (decoder->tooth_count >= decoder->total_teeth) {
             // Lost synchronization!
+            event_trace_record(EVENT_TRACE_SYNC_LOSS, EVENT_TRACE_NO_CYLINDER,
+                               (uint16_t)decoder->tooth_count);
             decoder->sync_locked = false;
             decoder->sync_loss_count++;
             decoder->tooth_count = 0;
@@ -19,10 +19,21 @@ extern "C" {
 #include "hal/clock_k64.h"
 #include "hal/gpio_k64.h"
 #include "hal/uart_k64.h"
+#include "hal/compiler_k64.h"
 #include "communication/tunerstudio/tunerstudio.h"
 #include "config/config.h"
+#include "memory/mem_pool.h"
+#include "memory/trace_log.h"
+#include "memory/event_trace.h"
+#if BOOT_BENCHMARK
+#include "hal/pit_k64.h"
+#include "controllers/dsp_q15.h"
+#endif
 }
 #include "fatfs/fatfs_wrapper.h"
+#if BOOT_BENCHMARK
+#include "controllers/engine_layout.h"
+#endif
 
 //=============================================================================
 // Hardware Configuration
@@ -32,10 +43,25 @@ extern "C" {
 #define LED_PORT    GPIO_PORT_C
 #define LED_PIN     GPIO_PIN_5
 
-// Debug UART configuration
-#define DEBUG_UART  UART_0
+// Serial ports: TunerStudio owns UART0 (tunerstudio.c); trace records go
+// to their own port so they never land between TunerStudio responses
+#define TS_UART     UART_0      // PTB16 (RX) / PTB17 (TX)
+#define TRACE_UART  UART_2      // PTD3 (TX), pin 8
 #define UART_BAUD   115200
 
+// Boot benchmark (ENABLE_BOOT_BENCHMARK): PIT latency sampling window
+#ifndef BOOT_BENCHMARK
+#define BOOT_BENCHMARK          0
+#endif
+#define BENCH_PIT_CHANNEL       PIT_CHANNEL_3
+#define BENCH_PIT_PERIOD_US     100
+#define BENCH_PIT_WINDOW_MS     200
+
+#if BOOT_BENCHMARK
+// Engine measured by the layout benchmark (V8, 36-1, 1-8-4-3-6-5-7-2)
+typedef EngineLayout<36, 1, 1, 8, 4, 3, 6, 5, 7, 2> BenchLayout;
+#endif
+
 //=============================================================================
 // Global Variables
 //=============================================================================
@@ -74,44 +100,35 @@ uint32_t millis(void) {
 }
 
 /**
- * @brief Print string to debug UART
- * @param str Null-terminated string
- */
-void print(const char* str) {
-    uart_puts(DEBUG_UART, str);
-}
-
-/**
- * @brief Print string with newline
- * @param str Null-terminated string
- */
-void println(const char* str) {
-    uart_puts(DEBUG_UART, str);
-    uart_puts(DEBUG_UART, "\r\n");
-}
-
-/**
- * @brief Print unsigned 32-bit integer
- * @param value Value to print
+ * @brief Send pending trace records to the trace UART
+ *
+ * Records are binary frames (trace_log.h); render them on the host with
+ * tools/trace_decode.py. Only writes while the transmitter has room, so
+ * the main loop never waits on the UART (a frame is ~1.9 ms at 115200
+ * baud); a partly sent frame is continued on the next pass.
  */
-void print_uint(uint32_t value) {
-    char buffer[12];
-    int i = 0;
-
-    if (value == 0) {
-        uart_putc(DEBUG_UART, '0');
-        return;
-    }
-
-    // Convert to string (reverse order)
-    while (value > 0) {
-        buffer[i++] = '0' + (value % 10);
-        value /= 10;
+void trace_drain(void) {
+    static uint32_t reported_drops = 0;
+    static uint8_t frame[TRACE_LOG_FRAME_SIZE];
+    static uint8_t frame_pos = sizeof(frame);
+    trace_record_t record;
+
+    while (uart_tx_ready(TRACE_UART)) {
+        if (frame_pos >= sizeof(frame)) {
+            if (!trace_log_read(&record)) {
+                break;
+            }
+            trace_log_frame(&record, frame);
+            frame_pos = 0;
+        }
+        uart_putc(TRACE_UART, frame[frame_pos++]);
     }
 
-    // Print in correct order
-    while (i > 0) {
-        uart_putc(DEBUG_UART, buffer[--i]);
+    trace_log_stats_t stats;
+    trace_log_get_stats(&stats);
+    if (stats.dropped != reported_drops &&
+        TRACE1("trace: %u records dropped", stats.dropped - reported_drops)) {
+        reported_drops = stats.dropped;
     }
 }
 
@@ -135,38 +152,103 @@ void systick_init(void) {
 /**
  * @brief Print startup banner
  */
-void print_banner(void) {
-    println("========================================");
-    println("   Russefi Teensy 3.5 ECU Firmware");
-    println("========================================");
-    println("Version: 0.1.0 (Phase 1)");
-    println("Platform: Teensy 3.5 (MK64FX512)");
-    println("CPU Speed: 120 MHz");
-    println("License: GPL v3");
-    println("========================================");
-    println("");
+COLD_FUNC void print_banner(void) {
+    TRACE0("========================================");
+    TRACE0("   Russefi Teensy 3.5 ECU Firmware");
+    TRACE0("========================================");
+    TRACE0("Version: 0.1.0 (Phase 1)");
+    TRACE0("Platform: Teensy 3.5 (MK64FX512)");
+    TRACE0("CPU Speed: 120 MHz");
+    TRACE0("License: GPL v3");
+    TRACE0("========================================");
+    TRACE0("");
 }
 
 /**
  * @brief Print system information
  */
-void print_system_info(void) {
-    println("System Information:");
-    println("------------------");
-    println("Processor: MK64FX512VMD12 (Kinetis K64)");
-    println("Architecture: ARM Cortex-M4F @ 120 MHz");
-    println("FPU: Single-precision (32-bit float)");
-    println("Flash Memory: 512 KB");
-    println("RAM: 256 KB");
-    println("EEPROM: 4 KB");
-    println("Analog Inputs: 27 channels (13-bit ADC)");
-    println("PWM Outputs: 20 channels");
-    println("Digital I/O: 58 pins (5V tolerant)");
-    println("CAN Bus: 1x FlexCAN");
-    println("Serial Ports: 6x UART");
-    println("");
+COLD_FUNC void print_system_info(void) {
+    TRACE0("System Information:");
+    TRACE0("------------------");
+    TRACE0("Processor: MK64FX512VMD12 (Kinetis K64)");
+    TRACE0("Architecture: ARM Cortex-M4F @ 120 MHz");
+    TRACE0("FPU: Single-precision (32-bit float)");
+    TRACE0("Flash Memory: 512 KB");
+    TRACE0("RAM: 256 KB");
+    TRACE0("EEPROM: 4 KB");
+    TRACE0("Analog Inputs: 27 channels (13-bit ADC)");
+    TRACE0("PWM Outputs: 20 channels");
+    TRACE0("Digital I/O: 58 pins (5V tolerant)");
+    TRACE0("CAN Bus: 1x FlexCAN");
+    TRACE0("Serial Ports: 6x UART");
+    TRACE0("");
+}
+
+#if BOOT_BENCHMARK
+static void bench_pit_tick(void) {
 }
 
+/**
+ * @brief Measure hot-path timing and log it as "bench <name> <value>"
+ *
+ * Runs once at boot in ENABLE_BOOT_BENCHMARK builds. tools/build_matrix.sh
+ * collects these records per configuration (BENCH_PORT) for the
+ * benchmark columns of the report.
+ *
+ * - pit_latency_min/max: PIT interrupt entry latency, bus ticks (60 MHz)
+ * - bilinear/iir2/trim8: Q15 kernel cycles per call (DWT)
+ * - layout_*_rt/_ct: engine_control.c vs EngineLayout cycles per call
+ *   (injection timing, injectors to fire, batch pairs), DWT
+ */
+COLD_FUNC void run_boot_benchmark(void) {
+    pit_config_t pit_cfg = {
+        .period_us = BENCH_PIT_PERIOD_US,
+        .enable_interrupt = true,
+        .enable_chain = false,
+    };
+    pit_latency_t latency;
+    dsp_q15_bench_t dsp;
+    engine_layout_bench_t layout;
+    static ecu_state_t bench_ecu;
+    static const engine_config_t bench_engine = {
+        BenchLayout::num_cylinders, 5000, BenchLayout::crank_teeth,
+        BenchLayout::crank_teeth - BenchLayout::real_teeth,
+        { 1, 8, 4, 3, 6, 5, 7, 2 }, { 0 }
+    };
+
+    pit_init();
+    pit_channel_init(BENCH_PIT_CHANNEL, &pit_cfg);
+    pit_register_callback(BENCH_PIT_CHANNEL, bench_pit_tick);
+    pit_reset_latency(BENCH_PIT_CHANNEL);
+    pit_start(BENCH_PIT_CHANNEL);
+    delay_ms(BENCH_PIT_WINDOW_MS);
+    pit_stop(BENCH_PIT_CHANNEL);
+
+    if (pit_get_latency(BENCH_PIT_CHANNEL, &latency) && latency.samples > 0) {
+        TRACE1("bench pit_latency_min %u", latency.min_ticks);
+        TRACE1("bench pit_latency_max %u", latency.max_ticks);
+    }
+
+    if (dsp_q15_benchmark(&dsp)) {
+        TRACE1("bench bilinear %u", dsp.bilinear_simd);
+        TRACE1("bench iir2 %u", dsp.iir2_simd);
+        TRACE1("bench trim8 %u", dsp.trim8_simd);
+    }
+
+    ecu_init(&bench_ecu, &bench_engine);
+    bench_ecu.fuel.injection_mode = INJECTION_MODE_SEQUENTIAL;
+    if (engine_layout_benchmark<BenchLayout>(&bench_ecu, &layout)) {
+        TRACE1("bench layout_inj_rt %u", layout.injection_timing_runtime);
+        TRACE1("bench layout_inj_ct %u", layout.injection_timing_static);
+        TRACE1("bench layout_fire_rt %u", layout.injectors_to_fire_runtime);
+        TRACE1("bench layout_fire_ct %u", layout.injectors_to_fire_static);
+        TRACE1("bench layout_pairs_rt %u", layout.batch_pairs_runtime);
+        TRACE1("bench layout_pairs_ct %u", layout.batch_pairs_static);
+    }
+    TRACE0("bench done");
+}
+#endif
+
 //=============================================================================
 // Main Function
 //=============================================================================
@@ -175,6 +257,13 @@ int main(void) {
     // Initialize system clocks (120 MHz)
     clock_init();
 
+    // Initialize static memory pools before any driver allocates
+    mem_pool_init();
+
+    // Trace log first so every init step can log
+    trace_log_init();
+    event_trace_init();
+
     // Initialize GPIO subsystem
     gpio_init();
 
@@ -182,13 +271,15 @@ int main(void) {
     gpio_config(LED_PORT, LED_PIN, GPIO_DIR_OUTPUT);
     gpio_clear(LED_PORT, LED_PIN); // LED off initially
 
-    // Initialize UART for debug output
+    // Initialize the TunerStudio and trace UARTs
     uart_config_t uart_cfg = {
         .baud_rate = UART_BAUD,
         .enable_tx = true,
-        .enable_rx = false,
+        .enable_rx = true,
     };
-    uart_init(DEBUG_UART, &uart_cfg);
+    uart_init(TS_UART, &uart_cfg);
+    uart_cfg.enable_rx = false;
+    uart_init(TRACE_UART, &uart_cfg);
 
     // Initialize SysTick for millisecond timing
     systick_init();
@@ -200,20 +291,24 @@ int main(void) {
     print_banner();
     print_system_info();
 
-    println("Initialization complete.");
-    println("LED will blink at 1 Hz");
-    println("");
+    TRACE0("Initialization complete.");
+    TRACE0("LED will blink at 1 Hz");
+    TRACE0("");
 
-    println("rusEFI Teensy 3.5 v2.2.0 - Basic functionality test");
-    println("FatFS and Wideband updates implemented (see documentation)");
+    TRACE0("rusEFI Teensy 3.5 v2.2.0 - Basic functionality test");
+    TRACE0("FatFS and Wideband updates implemented (see documentation)");
     
     // Initialize TunerStudio communication
     tunerstudio_init();
-    println("TunerStudio communication initialized");
+    TRACE0("TunerStudio communication initialized");
     
     // Initialize configuration system
     config_init();
-    println("Configuration system initialized");
+    TRACE0("Configuration system initialized");
+
+#if BOOT_BENCHMARK
+    run_boot_benchmark();
+#endif
 
     // Main loop
     uint32_t last_blink = 0;
@@ -239,11 +334,15 @@ int main(void) {
         if ((now - last_heartbeat) >= 1000) {
             last_heartbeat = now;
 
-            print("Heartbeat: ");
-            print_uint(now / 1000);
-            println(" seconds uptime");
+            TRACE1("Heartbeat: %u seconds uptime", now / 1000);
         }
 
+        // Send pending trace records
+        trace_drain();
+
+        // Resume an abandoned event trace dump
+        event_trace_update();
+
         // Sleep until next interrupt (low power)
         __asm volatile("wfi");
 
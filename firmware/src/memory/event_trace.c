@@ -0,0 +1,202 @@
+/**
+ * @file event_trace.c
+ * @brief Engine event timeline recorder implementation
+ * @version 1.1.0
+ * @date 2026-10-18
+ *
+ * The ring is only read while frozen. A writer that passed the enabled
+ * check just before the freeze may still complete its entry, so the
+ * newest entry of a dump can be one event past the freeze time.
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "event_trace.h"
+#include "mem_pool.h"
+#include "clock_k64.h"
+#include "fatfs_wrapper.h"
+#include <stddef.h>
+#include <string.h>
+
+#define EVENT_TRACE_MASK            (EVENT_TRACE_ENTRIES - 1)
+#define EVENT_TRACE_DUMP_TIMEOUT_CYCLES \
+    ((uint32_t)EVENT_TRACE_DUMP_TIMEOUT_MS * (CPU_CORE_CLK_HZ / 1000U))
+
+//=============================================================================
+// Recorder State (.bss)
+//=============================================================================
+
+event_trace_t g_event_trace;
+
+//=============================================================================
+// Private Helper Functions
+//=============================================================================
+
+static uint8_t* put_u32(uint8_t* p, uint32_t value) {
+    *p++ = (value >> 24) & 0xFF;
+    *p++ = (value >> 16) & 0xFF;
+    *p++ = (value >> 8) & 0xFF;
+    *p++ = value & 0xFF;
+    return p;
+}
+
+static uint8_t* put_u16(uint8_t* p, uint16_t value) {
+    *p++ = (value >> 8) & 0xFF;
+    *p++ = value & 0xFF;
+    return p;
+}
+
+static uint32_t entry_count(uint32_t head) {
+    return (head < EVENT_TRACE_ENTRIES) ? head : EVENT_TRACE_ENTRIES;
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+void event_trace_init(void) {
+    cycle_counter_enable();
+    memset(&g_event_trace, 0, sizeof(g_event_trace));
+    g_event_trace.enabled = true;
+}
+
+void event_trace_freeze(void) {
+    if (g_event_trace.enabled) {
+        g_event_trace.enabled = false;
+        g_event_trace.frozen_cycles = cycle_counter_read();
+    }
+    g_event_trace.dump_active = false;
+}
+
+void event_trace_resume(void) {
+    g_event_trace.dump_active = false;
+    g_event_trace.enabled = true;
+}
+
+void event_trace_update(void) {
+    if (g_event_trace.dump_active &&
+        cycle_counter_read() - g_event_trace.dump_cycles >= EVENT_TRACE_DUMP_TIMEOUT_CYCLES) {
+        event_trace_resume();
+    }
+}
+
+bool event_trace_is_frozen(void) {
+    return !g_event_trace.enabled;
+}
+
+uint32_t event_trace_dump_size(void) {
+    return EVENT_TRACE_HEADER_SIZE + entry_count(g_event_trace.head) * EVENT_TRACE_ENTRY_SIZE;
+}
+
+uint16_t event_trace_serialize(uint32_t offset, uint8_t* buffer, uint16_t size) {
+    if (buffer == NULL) {
+        return 0;
+    }
+
+    uint32_t total = event_trace_dump_size();
+    if (offset >= total) {
+        return 0;
+    }
+
+    uint32_t end = offset + size;
+    if (end > total) {
+        end = total;
+    }
+
+    uint32_t head = g_event_trace.head;
+    uint32_t count = entry_count(head);
+    uint32_t oldest = head - count;
+    uint8_t item[EVENT_TRACE_HEADER_SIZE];
+    uint32_t pos = offset;
+
+    // Build the header or entry that holds pos, copy the requested part
+    while (pos < end) {
+        uint32_t base;
+        uint32_t length;
+        uint8_t* p = item;
+
+        if (pos < EVENT_TRACE_HEADER_SIZE) {
+            p = put_u16(p, (uint16_t)count);
+            p = put_u16(p, EVENT_TRACE_ENTRY_SIZE);
+            p = put_u32(p, head);
+            p = put_u32(p, g_event_trace.frozen_cycles);
+            put_u32(p, CPU_CORE_CLK_HZ);
+            base = 0;
+            length = EVENT_TRACE_HEADER_SIZE;
+        } else {
+            uint32_t n = (pos - EVENT_TRACE_HEADER_SIZE) / EVENT_TRACE_ENTRY_SIZE;
+            const event_trace_entry_t* e = &g_event_trace.entries[(oldest + n) & EVENT_TRACE_MASK];
+            p = put_u32(p, e->cycles);
+            *p++ = e->info & 0xFF;
+            *p++ = (e->info >> 8) & 0xFF;
+            put_u16(p, (uint16_t)(e->info >> 16));
+            base = EVENT_TRACE_HEADER_SIZE + n * EVENT_TRACE_ENTRY_SIZE;
+            length = EVENT_TRACE_ENTRY_SIZE;
+        }
+
+        uint32_t stop = (base + length < end) ? base + length : end;
+        memcpy(&buffer[pos - offset], &item[pos - base], stop - pos);
+        pos = stop;
+    }
+
+    return (uint16_t)(end - offset);
+}
+
+uint16_t event_trace_read_chunk(uint8_t chunk, uint8_t* buffer, uint16_t size) {
+    if (chunk == 0 && !event_trace_is_frozen()) {
+        event_trace_freeze();
+        g_event_trace.dump_active = true;
+    } else if (!event_trace_is_frozen()) {
+        return 0;
+    }
+    g_event_trace.dump_cycles = cycle_counter_read();
+
+    uint32_t offset = (uint32_t)chunk * EVENT_TRACE_CHUNK_SIZE;
+    uint16_t length = event_trace_serialize(offset, buffer,
+                                            (size < EVENT_TRACE_CHUNK_SIZE) ? size : EVENT_TRACE_CHUNK_SIZE);
+
+    if (offset + length >= event_trace_dump_size()) {
+        event_trace_resume();
+    }
+    return length;
+}
+
+bool event_trace_save(const char* filename) {
+    if (filename == NULL) {
+        return false;
+    }
+
+    uint8_t* block = (uint8_t*)mem_pool_alloc(MEM_POOL_SECTOR);
+    if (block == NULL) {
+        return false;
+    }
+
+    fatfs_file_t file;
+    bool ok = false;
+    bool was_frozen = event_trace_is_frozen();
+    bool was_dump = g_event_trace.dump_active;
+
+    event_trace_freeze();
+    if (fatfs_open_file(filename, FATFS_MODE_WRITE, &file) == FATFS_OK) {
+        uint32_t offset = 0;
+        uint16_t length;
+        ok = true;
+
+        while (ok && (length = event_trace_serialize(offset, block, MEM_POOL_SECTOR_SIZE)) > 0) {
+            uint32_t written;
+            ok = fatfs_write_file(file, block, length, &written) == FATFS_OK && written == length;
+            offset += length;
+        }
+
+        ok = (fatfs_close_file(file) == FATFS_OK) && ok;
+    }
+    if (!was_frozen) {
+        event_trace_resume();
+    } else {
+        g_event_trace.dump_active = was_dump;  // A TunerStudio dump may still time out
+    }
+
+    mem_pool_free(MEM_POOL_SECTOR, block);
+    return ok;
+}
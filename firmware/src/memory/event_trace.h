@@ -0,0 +1,211 @@
+/**
+ * @file event_trace.h
+ * @brief Engine event timeline recorder for Teensy 3.5
+ * @version 1.1.0
+ * @date 2026-10-18
+ *
+ * Flight recorder for timing problems: every trigger tooth, sync change,
+ * armed and fired output event, ADC conversion and TunerStudio packet is
+ * stored as an 8-byte entry (DWT cycle count, type, cylinder, value) in a
+ * RAM ring that always holds the most recent EVENT_TRACE_ENTRIES events.
+ *
+ * event_trace_record() is inline: one atomic increment of the ring head
+ * (LDREX/STREX) and two stores, no locks, so it stays enabled in
+ * production and is safe from any ISR priority.
+ *
+ * To dump, the ring is frozen (recording stops), serialized oldest first
+ * and resumed. Dumps go over TunerStudio (TS_PAGE_EVENT_TRACE chunks) or
+ * to SD (event_trace_save()); tools/event_trace_to_perfetto.py converts
+ * them to Chrome trace / Perfetto JSON. A TunerStudio dump that stops
+ * before its last chunk resumes recording after
+ * EVENT_TRACE_DUMP_TIMEOUT_MS without a chunk read (event_trace_update()).
+ *
+ * Dump layout (big-endian, same as output channels):
+ *   0   uint16 entry count
+ *   2   uint16 entry size (8)
+ *   4   uint32 events recorded since init (entries lost = this - count)
+ *   8   uint32 cycle counter at freeze
+ *   12  uint32 cycle counter rate (Hz)
+ *   16  per entry, oldest first:
+ *       uint32 cycles, uint8 type, uint8 cylinder, uint16 value
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef EVENT_TRACE_H
+#define EVENT_TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cycle_counter_k64.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=============================================================================
+// Configuration
+//=============================================================================
+
+#ifndef EVENT_TRACE_ENTRIES
+#define EVENT_TRACE_ENTRIES         512     ///< Ring size (power of 2), 4 KB
+#endif
+
+#if (EVENT_TRACE_ENTRIES & (EVENT_TRACE_ENTRIES - 1)) != 0
+#error "EVENT_TRACE_ENTRIES must be a power of 2"
+#endif
+
+#define EVENT_TRACE_HEADER_SIZE     16
+#define EVENT_TRACE_ENTRY_SIZE      8
+#define EVENT_TRACE_SIZE            (EVENT_TRACE_HEADER_SIZE + EVENT_TRACE_ENTRIES * EVENT_TRACE_ENTRY_SIZE)
+#define EVENT_TRACE_CHUNK_SIZE      240     ///< Dump bytes per TunerStudio page read
+
+#ifndef EVENT_TRACE_DUMP_TIMEOUT_MS
+#define EVENT_TRACE_DUMP_TIMEOUT_MS 2000    ///< Abandoned dump: resume after this
+#endif
+
+#define EVENT_TRACE_NO_CYLINDER     0xFF
+
+/**
+ * @brief Event types (cylinder and value meaning per type)
+ */
+typedef enum {
+    EVENT_TRACE_TOOTH = 1,                  ///< Crank tooth: value = tooth index
+    EVENT_TRACE_SYNC,                       ///< Sync acquired: value = sync count
+    EVENT_TRACE_SYNC_LOSS,                  ///< Sync lost: value = tooth count at loss
+    EVENT_TRACE_ARMED,                      ///< Output event armed: cylinder, value = angle (deg)
+    EVENT_TRACE_FIRED,                      ///< Output event fired: cylinder, value = lateness (us)
+    EVENT_TRACE_ADC,                        ///< ADC conversion: cylinder = channel, value = raw
+    EVENT_TRACE_TS_PACKET,                  ///< TunerStudio packet: cylinder = command, value = payload bytes
+} event_trace_type_t;
+
+/**
+ * @brief One ring entry
+ */
+typedef struct {
+    uint32_t cycles;                        ///< DWT cycle counter
+    uint32_t info;                          ///< type | cylinder << 8 | value << 16
+} event_trace_entry_t;
+
+/**
+ * @brief Recorder state (written by event_trace_record())
+ */
+typedef struct {
+    volatile bool enabled;
+    volatile uint32_t head;                 ///< Events recorded since init
+    uint32_t frozen_cycles;                 ///< Cycle counter at freeze
+    uint32_t dump_cycles;                   ///< Cycle counter at the last chunk read
+    bool dump_active;                       ///< Frozen by a chunk read (times out)
+    event_trace_entry_t entries[EVENT_TRACE_ENTRIES];
+} event_trace_t;
+
+extern event_trace_t g_event_trace;
+
+//=============================================================================
+// Recording
+//=============================================================================
+
+/**
+ * @brief Record one event (ISR safe, lock-free)
+ *
+ * @param type event_trace_type_t
+ * @param cylinder Cylinder (0-based), channel or command; EVENT_TRACE_NO_CYLINDER if none
+ * @param value Type-specific value
+ */
+static inline void event_trace_record(uint8_t type, uint8_t cylinder, uint16_t value)
+{
+    if (!g_event_trace.enabled) {
+        return;
+    }
+
+    uint32_t index = __atomic_fetch_add(&g_event_trace.head, 1, __ATOMIC_RELAXED);
+    event_trace_entry_t* e = &g_event_trace.entries[index & (EVENT_TRACE_ENTRIES - 1)];
+    e->cycles = cycle_counter_read();
+    e->info = (uint32_t)type | ((uint32_t)cylinder << 8) | ((uint32_t)value << 16);
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+/**
+ * @brief Clear the ring, enable the cycle counter and start recording
+ */
+void event_trace_init(void);
+
+/**
+ * @brief Stop recording (e.g. on a timing fault, or before a dump)
+ *
+ * Idempotent; the first call latches the freeze time. The ring stays
+ * frozen until event_trace_resume() or the end of a TunerStudio dump.
+ */
+void event_trace_freeze(void);
+
+/**
+ * @brief Resume recording after a dump
+ */
+void event_trace_resume(void);
+
+/**
+ * @brief Resume an abandoned TunerStudio dump (main loop)
+ *
+ * Recording frozen by chunk 0 resumes once no chunk has been read for
+ * EVENT_TRACE_DUMP_TIMEOUT_MS. An explicit event_trace_freeze() does not
+ * time out.
+ */
+void event_trace_update(void);
+
+/**
+ * @brief Check whether recording is stopped
+ */
+bool event_trace_is_frozen(void);
+
+/**
+ * @brief Serialize part of the frozen ring in dump layout
+ *
+ * @param offset Byte offset into the dump
+ * @param buffer Output buffer
+ * @param size Buffer size in bytes
+ * @return Bytes written (0 past the end of the dump)
+ */
+uint16_t event_trace_serialize(uint32_t offset, uint8_t* buffer, uint16_t size);
+
+/**
+ * @brief Total dump size in bytes for the current ring contents
+ */
+uint32_t event_trace_dump_size(void);
+
+/**
+ * @brief Read one TunerStudio chunk of the dump
+ *
+ * Chunk 0 freezes the ring; reading the chunk that holds the end of the
+ * dump resumes recording. Other chunks are only served while the ring is
+ * frozen, so a dump never mixes entries from before and after a resume
+ * (timeout or end of a previous dump): the reader must start again at
+ * chunk 0.
+ *
+ * @param chunk Chunk index (EVENT_TRACE_CHUNK_SIZE bytes each)
+ * @param buffer Output buffer
+ * @param size Buffer size in bytes
+ * @return Bytes written (0 past the end of the dump, or if the ring is
+ *         not frozen)
+ */
+uint16_t event_trace_read_chunk(uint8_t chunk, uint8_t* buffer, uint16_t size);
+
+/**
+ * @brief Write the dump to a file on the SD card
+ *
+ * Recording is frozen while writing and resumed afterwards, unless the
+ * ring was already frozen (e.g. by a fault handler).
+ *
+ * @param filename Destination path (overwritten)
+ * @return true on success
+ */
+bool event_trace_save(const char* filename);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EVENT_TRACE_H
@@ -0,0 +1,160 @@
+/**
+ * @file mem_pool.c
+ * @brief Static fixed-block memory pools implementation
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * Each pool keeps a singly linked free list threaded through the free
+ * blocks themselves (the first 16 bits hold the next block index). The
+ * list head packs an ABA tag in the upper 16 bits and the first free index
+ * in the lower 16 bits, so a single 32-bit compare-and-swap pops or pushes
+ * a block without disabling interrupts.
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "mem_pool.h"
+#include <stddef.h>
+
+//=============================================================================
+// Private Definitions
+//=============================================================================
+
+#define MEM_POOL_EMPTY          0xFFFF
+#define MEM_POOL_TAG_INC        0x00010000
+
+typedef struct {
+    uint8_t* storage;            // Block storage
+    uint16_t block_size;         // Bytes per block
+    uint16_t block_count;        // Total blocks
+    volatile uint32_t head;      // (tag << 16) | first free index
+    volatile uint16_t in_use;    // Blocks currently allocated
+    volatile uint16_t high_water;
+    volatile uint32_t alloc_failures;
+} mem_pool_t;
+
+//=============================================================================
+// Pool Storage (.bss)
+//=============================================================================
+
+static uint8_t sector_storage[MEM_POOL_SECTOR_COUNT][MEM_POOL_SECTOR_SIZE] __attribute__((aligned(8)));
+static uint8_t frame_storage[MEM_POOL_FRAME_COUNT][MEM_POOL_FRAME_SIZE] __attribute__((aligned(8)));
+static uint8_t page_storage[MEM_POOL_PAGE_COUNT][MEM_POOL_PAGE_SIZE] __attribute__((aligned(8)));
+
+static mem_pool_t pools[MEM_POOL_COUNT] = {
+    [MEM_POOL_SECTOR] = { &sector_storage[0][0], MEM_POOL_SECTOR_SIZE, MEM_POOL_SECTOR_COUNT, MEM_POOL_EMPTY, 0, 0, 0 },
+    [MEM_POOL_FRAME]  = { &frame_storage[0][0],  MEM_POOL_FRAME_SIZE,  MEM_POOL_FRAME_COUNT,  MEM_POOL_EMPTY, 0, 0, 0 },
+    [MEM_POOL_PAGE]   = { &page_storage[0][0],   MEM_POOL_PAGE_SIZE,   MEM_POOL_PAGE_COUNT,   MEM_POOL_EMPTY, 0, 0, 0 },
+};
+
+//=============================================================================
+// Private Helper Functions
+//=============================================================================
+
+static inline uint16_t* block_next(const mem_pool_t* p, uint16_t index) {
+    return (uint16_t*)(p->storage + ((uint32_t)index * p->block_size));
+}
+
+static void update_high_water(mem_pool_t* p, uint16_t in_use) {
+    uint16_t hw = __atomic_load_n(&p->high_water, __ATOMIC_RELAXED);
+    while (in_use > hw) {
+        if (__atomic_compare_exchange_n(&p->high_water, &hw, in_use, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+void mem_pool_init(void) {
+    for (uint8_t i = 0; i < MEM_POOL_COUNT; i++) {
+        mem_pool_t* p = &pools[i];
+
+        // Chain every block: 0 -> 1 -> ... -> n-1 -> EMPTY
+        for (uint16_t b = 0; b < p->block_count; b++) {
+            *block_next(p, b) = (b + 1 < p->block_count) ? (uint16_t)(b + 1) : MEM_POOL_EMPTY;
+        }
+
+        p->head = (p->block_count > 0) ? 0 : MEM_POOL_EMPTY;
+        p->in_use = 0;
+        p->high_water = 0;
+        p->alloc_failures = 0;
+    }
+}
+
+void* mem_pool_alloc(mem_pool_id_t pool) {
+    if (pool >= MEM_POOL_COUNT) {
+        return NULL;
+    }
+
+    mem_pool_t* p = &pools[pool];
+    uint32_t old_head = __atomic_load_n(&p->head, __ATOMIC_ACQUIRE);
+    uint32_t new_head;
+    uint16_t index;
+
+    do {
+        index = (uint16_t)(old_head & 0xFFFF);
+        if (index == MEM_POOL_EMPTY) {
+            __atomic_fetch_add(&p->alloc_failures, 1, __ATOMIC_RELAXED);
+            return NULL;
+        }
+        new_head = ((old_head + MEM_POOL_TAG_INC) & 0xFFFF0000) | *block_next(p, index);
+    } while (!__atomic_compare_exchange_n(&p->head, &old_head, new_head, true,
+                                          __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+    uint16_t in_use = __atomic_add_fetch(&p->in_use, 1, __ATOMIC_RELAXED);
+    update_high_water(p, in_use);
+
+    return p->storage + ((uint32_t)index * p->block_size);
+}
+
+bool mem_pool_free(mem_pool_id_t pool, void* block) {
+    if (pool >= MEM_POOL_COUNT || block == NULL) {
+        return false;
+    }
+
+    mem_pool_t* p = &pools[pool];
+    uint8_t* ptr = (uint8_t*)block;
+    uint32_t pool_bytes = (uint32_t)p->block_count * p->block_size;
+
+    // Reject pointers outside the pool or not on a block boundary
+    if (ptr < p->storage || ptr >= p->storage + pool_bytes) {
+        return false;
+    }
+    uint32_t offset = (uint32_t)(ptr - p->storage);
+    if ((offset % p->block_size) != 0) {
+        return false;
+    }
+
+    uint16_t index = (uint16_t)(offset / p->block_size);
+    uint32_t old_head = __atomic_load_n(&p->head, __ATOMIC_RELAXED);
+    uint32_t new_head;
+
+    do {
+        *block_next(p, index) = (uint16_t)(old_head & 0xFFFF);
+        new_head = ((old_head + MEM_POOL_TAG_INC) & 0xFFFF0000) | index;
+    } while (!__atomic_compare_exchange_n(&p->head, &old_head, new_head, true,
+                                          __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+    __atomic_sub_fetch(&p->in_use, 1, __ATOMIC_RELAXED);
+    return true;
+}
+
+bool mem_pool_get_stats(mem_pool_id_t pool, mem_pool_stats_t* stats) {
+    if (pool >= MEM_POOL_COUNT || stats == NULL) {
+        return false;
+    }
+
+    const mem_pool_t* p = &pools[pool];
+    stats->block_size = p->block_size;
+    stats->block_count = p->block_count;
+    stats->in_use = p->in_use;
+    stats->high_water = p->high_water;
+    stats->alloc_failures = p->alloc_failures;
+
+    return true;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file mem_pool.h
+ * @brief Static fixed-block memory pools for Teensy 3.5
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * Typed pools of fixed-size blocks, statically allocated in .bss, that
+ * replace large stack buffers and VLAs. Allocation and release are O(1)
+ * and lock-free (LDREX/STREX compare-and-swap on a tagged free-list head),
+ * so they may be called from ISRs and from the main loop concurrently.
+ *
+ * Pools:
+ * - MEM_POOL_SECTOR: 512 B SD card sectors
+ * - MEM_POOL_FRAME:  64 B CAN/TunerStudio frames and short strings
+ * - MEM_POOL_PAGE:   1 KB configuration pages
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef MEM_POOL_H
+#define MEM_POOL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=============================================================================
+// Pool Configuration
+//=============================================================================
+
+#define MEM_POOL_SECTOR_SIZE    512
+#define MEM_POOL_SECTOR_COUNT   4
+
+#define MEM_POOL_FRAME_SIZE     64
+#define MEM_POOL_FRAME_COUNT    16
+
+#define MEM_POOL_PAGE_SIZE      1024    // Must match CONFIG_PAGE_SIZE
+#define MEM_POOL_PAGE_COUNT     1
+
+//=============================================================================
+// Types
+//=============================================================================
+
+typedef enum {
+    MEM_POOL_SECTOR = 0,
+    MEM_POOL_FRAME,
+    MEM_POOL_PAGE,
+    MEM_POOL_COUNT
+} mem_pool_id_t;
+
+typedef struct {
+    uint16_t block_size;         // Bytes per block
+    uint16_t block_count;        // Total blocks in pool
+    uint16_t in_use;             // Blocks currently allocated
+    uint16_t high_water;         // Maximum blocks allocated at once
+    uint32_t alloc_failures;     // Allocations refused (pool empty)
+} mem_pool_stats_t;
+
+//=============================================================================
+// Function Prototypes
+//=============================================================================
+
+/**
+ * @brief Initialize all pools (call once before any allocation)
+ */
+void mem_pool_init(void);
+
+/**
+ * @brief Allocate one block from a pool
+ *
+ * @param pool Pool identifier
+ * @return Pointer to block, or NULL if the pool is empty
+ */
+void* mem_pool_alloc(mem_pool_id_t pool);
+
+/**
+ * @brief Return a block to its pool
+ *
+ * @param pool Pool identifier
+ * @param block Block previously returned by mem_pool_alloc (NULL ignored)
+ * @return true if the block belonged to the pool and was released
+ */
+bool mem_pool_free(mem_pool_id_t pool, void* block);
+
+/**
+ * @brief Get pool usage statistics
+ *
+ * @param pool Pool identifier
+ * @param stats Output statistics
+ * @return true if pool valid
+ */
+bool mem_pool_get_stats(mem_pool_id_t pool, mem_pool_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MEM_POOL_H
@@ -0,0 +1,83 @@
+/**
+ * @file mem_report.c
+ * @brief Runtime memory footprint report implementation
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "mem_report.h"
+#include "stack_monitor.h"
+#include <stddef.h>
+#include <malloc.h>
+
+//=============================================================================
+// External symbols from linker script
+//=============================================================================
+
+extern uint8_t end;          // Start of heap
+extern uint8_t _heap_limit;  // End of reserved heap
+
+//=============================================================================
+// Private Helper Functions
+//=============================================================================
+
+static uint8_t* put_u32(uint8_t* p, uint32_t value) {
+    *p++ = (value >> 24) & 0xFF;
+    *p++ = (value >> 16) & 0xFF;
+    *p++ = (value >> 8) & 0xFF;
+    *p++ = value & 0xFF;
+    return p;
+}
+
+static uint8_t* put_u16(uint8_t* p, uint16_t value) {
+    *p++ = (value >> 8) & 0xFF;
+    *p++ = value & 0xFF;
+    return p;
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+void mem_report_collect(mem_report_t* report) {
+    if (report == NULL) {
+        return;
+    }
+
+    report->stack_size = stack_monitor_size();
+    report->stack_high_water = stack_monitor_high_water();
+
+    report->heap_size = (uint32_t)(&_heap_limit - &end);
+    report->heap_used = (uint32_t)mallinfo().uordblks;
+
+    for (uint8_t i = 0; i < MEM_POOL_COUNT; i++) {
+        mem_pool_get_stats((mem_pool_id_t)i, &report->pools[i]);
+    }
+}
+
+uint16_t mem_report_serialize(const mem_report_t* report, uint8_t* buffer, uint16_t size) {
+    if (report == NULL || buffer == NULL || size < MEM_REPORT_SIZE) {
+        return 0;
+    }
+
+    uint8_t* p = buffer;
+    p = put_u32(p, report->stack_size);
+    p = put_u32(p, report->stack_high_water);
+    p = put_u32(p, report->heap_size);
+    p = put_u32(p, report->heap_used);
+    *p++ = MEM_POOL_COUNT;
+
+    for (uint8_t i = 0; i < MEM_POOL_COUNT; i++) {
+        const mem_pool_stats_t* s = &report->pools[i];
+        p = put_u16(p, s->block_size);
+        p = put_u16(p, s->block_count);
+        p = put_u16(p, s->in_use);
+        p = put_u16(p, s->high_water);
+        p = put_u32(p, s->alloc_failures);
+    }
+
+    return (uint16_t)(p - buffer);
+}
@@ -0,0 +1,71 @@
+/**
+ * @file mem_report.h
+ * @brief Runtime memory footprint report for Teensy 3.5
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * Collects stack high-water (painted stack), heap use and pool watermarks
+ * into one snapshot, and serializes it for the TunerStudio memory page
+ * (TS_PAGE_MEMORY). Build-time per-object tables come from
+ * tools/memory_report.py.
+ *
+ * Page layout (big-endian, same as output channels):
+ *   0   uint32 stack size
+ *   4   uint32 stack high-water
+ *   8   uint32 heap size (reserved by linker script)
+ *   12  uint32 heap in use (malloc)
+ *   16  uint8  pool count
+ *   17  per pool, 12 bytes each:
+ *       uint16 block size, uint16 block count, uint16 in use,
+ *       uint16 high-water, uint32 allocation failures
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef MEM_REPORT_H
+#define MEM_REPORT_H
+
+#include <stdint.h>
+#include "mem_pool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MEM_REPORT_HEADER_SIZE      17
+#define MEM_REPORT_POOL_SIZE        12
+#define MEM_REPORT_SIZE             (MEM_REPORT_HEADER_SIZE + MEM_POOL_COUNT * MEM_REPORT_POOL_SIZE)
+
+typedef struct {
+    uint32_t stack_size;
+    uint32_t stack_high_water;
+    uint32_t heap_size;
+    uint32_t heap_used;
+    mem_pool_stats_t pools[MEM_POOL_COUNT];
+} mem_report_t;
+
+/**
+ * @brief Take a snapshot of current memory usage
+ *
+ * Scans the painted stack, so call from the main loop, not from an ISR.
+ *
+ * @param report Output snapshot
+ */
+void mem_report_collect(mem_report_t* report);
+
+/**
+ * @brief Serialize a snapshot in TunerStudio page layout
+ *
+ * @param report Snapshot to serialize
+ * @param buffer Output buffer
+ * @param size Buffer size in bytes
+ * @return Bytes written (0 if buffer too small)
+ */
+uint16_t mem_report_serialize(const mem_report_t* report, uint8_t* buffer, uint16_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MEM_REPORT_H
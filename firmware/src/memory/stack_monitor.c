@@ -0,0 +1,41 @@
+/**
+ * @file stack_monitor.c
+ * @brief Main stack high-water measurement implementation
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "stack_monitor.h"
+#include <stddef.h>
+
+//=============================================================================
+// External symbols from linker script
+//=============================================================================
+
+extern uint32_t _sstack;     // Lowest stack address
+extern uint32_t _estack;     // Initial stack pointer (top)
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+uint32_t stack_monitor_size(void) {
+    return (uint32_t)((uint8_t*)&_estack - (uint8_t*)&_sstack);
+}
+
+uint32_t stack_monitor_free(void) {
+    const uint32_t* p = &_sstack;
+
+    while (p < &_estack && *p == STACK_PAINT_PATTERN) {
+        p++;
+    }
+
+    return (uint32_t)((const uint8_t*)p - (const uint8_t*)&_sstack);
+}
+
+uint32_t stack_monitor_high_water(void) {
+    return stack_monitor_size() - stack_monitor_free();
+}
@@ -0,0 +1,47 @@
+/**
+ * @file stack_monitor.h
+ * @brief Main stack high-water measurement for Teensy 3.5
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * Reset_Handler paints the unused main stack (_sstack.._estack in SRAM_L)
+ * with STACK_PAINT_PATTERN. The high-water mark is found by scanning up
+ * from the bottom of the stack for the first word that was overwritten.
+ * Pair with the per-function .su files from -fstack-usage
+ * (tools/stack_report.sh) to see which call chains set the peak.
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef STACK_MONITOR_H
+#define STACK_MONITOR_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STACK_PAINT_PATTERN     0xC5C5C5C5
+
+/**
+ * @brief Get total main stack size in bytes
+ */
+uint32_t stack_monitor_size(void);
+
+/**
+ * @brief Get peak main stack usage in bytes since reset
+ */
+uint32_t stack_monitor_high_water(void);
+
+/**
+ * @brief Get unused main stack in bytes (never touched since reset)
+ */
+uint32_t stack_monitor_free(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STACK_MONITOR_H
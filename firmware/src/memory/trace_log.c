@@ -0,0 +1,116 @@
+/**
+ * @file trace_log.c
+ * @brief Deferred-format binary trace log implementation
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * Writers claim a slot by advancing head with a compare-and-swap, fill it
+ * and store the format ID last. The single reader copies the slot at
+ * tail once its format ID is non-zero, clears it and advances tail. The
+ * linker script starts .trace_fmt with a pad word, so no format ID is 0.
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "trace_log.h"
+#include "cycle_counter_k64.h"
+#include "compiler_k64.h"
+#include <stddef.h>
+#include <string.h>
+
+#define TRACE_LOG_MASK          (TRACE_LOG_RECORDS - 1)
+
+//=============================================================================
+// Ring Storage (.bss)
+//=============================================================================
+
+static trace_record_t ring[TRACE_LOG_RECORDS];
+static volatile uint32_t head;               // Next slot to claim
+static volatile uint32_t tail;               // Next slot to read
+static volatile uint32_t dropped;
+static volatile uint32_t high_water;
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+void trace_log_init(void) {
+    cycle_counter_enable();
+    memset(ring, 0, sizeof(ring));
+    head = 0;
+    tail = 0;
+    dropped = 0;
+    high_water = 0;
+}
+
+FAST_CODE bool trace_log_write(uint32_t fmt, uint32_t a, uint32_t b, uint32_t c) {
+    uint32_t slot = __atomic_load_n(&head, __ATOMIC_RELAXED);
+    uint32_t pending;
+
+    do {
+        pending = slot - __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+        if (pending >= TRACE_LOG_RECORDS) {
+            __atomic_fetch_add(&dropped, 1, __ATOMIC_RELAXED);
+            return false;
+        }
+    } while (!__atomic_compare_exchange_n(&head, &slot, slot + 1, true,
+                                          __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+    trace_record_t* r = &ring[slot & TRACE_LOG_MASK];
+    r->cycles = cycle_counter_read();
+    r->args[0] = a;
+    r->args[1] = b;
+    r->args[2] = c;
+    __atomic_store_n(&r->fmt, fmt, __ATOMIC_RELEASE);
+
+    // Diagnostic only; a lost race just under-reports the peak
+    if (pending + 1 > high_water) {
+        high_water = pending + 1;
+    }
+    return true;
+}
+
+bool trace_log_read(trace_record_t* record) {
+    if (record == NULL) {
+        return false;
+    }
+
+    uint32_t slot = tail;
+    if (slot == __atomic_load_n(&head, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+
+    // Claimed but still being written (the writer was preempted)
+    trace_record_t* r = &ring[slot & TRACE_LOG_MASK];
+    uint32_t fmt = __atomic_load_n(&r->fmt, __ATOMIC_ACQUIRE);
+    if (fmt == 0) {
+        return false;
+    }
+
+    *record = *r;
+    record->fmt = fmt;
+    r->fmt = 0;
+    __atomic_store_n(&tail, slot + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+void trace_log_frame(const trace_record_t* record, uint8_t* frame) {
+    if (record == NULL || frame == NULL) {
+        return;
+    }
+
+    frame[0] = TRACE_LOG_SYNC_0;
+    frame[1] = TRACE_LOG_SYNC_1;
+    memcpy(&frame[2], record, sizeof(trace_record_t));
+}
+
+void trace_log_get_stats(trace_log_stats_t* stats) {
+    if (stats == NULL) {
+        return;
+    }
+
+    stats->written = head;
+    stats->dropped = dropped;
+    stats->high_water = high_water;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file trace_log.h
+ * @brief Deferred-format binary trace log for Teensy 3.5
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * TRACE0()..TRACE3() store a fixed 20-byte record (format ID, cycle
+ * counter, up to three 32-bit arguments) in a RAM ring instead of
+ * formatting on target. The format string itself is placed in the
+ * .trace_fmt section, which the linker script keeps in the ELF as a
+ * non-loaded (INFO) section: it costs no flash, and its address is the
+ * format ID. tools/trace_decode.py reads the strings back from the ELF and
+ * renders the records captured from the debug UART.
+ *
+ * A slot is claimed with one compare-and-swap on the ring head
+ * (LDREX/STREX), so logging is lock-free and safe from any ISR priority;
+ * the format ID is stored last and marks the record complete. When the
+ * ring is full new records are dropped and counted. The main loop drains
+ * records with trace_log_read().
+ *
+ * Arguments are raw 32-bit words: integers as-is, floats through
+ * trace_f32() (decoded for %f/%e/%g). %s is not supported.
+ *
+ * Wire frame (trace_log_frame()): 'T' 'R', then the record in target
+ * byte order (little-endian).
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef TRACE_LOG_H
+#define TRACE_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//=============================================================================
+// Configuration
+//=============================================================================
+
+#ifndef TRACE_LOG_RECORDS
+#define TRACE_LOG_RECORDS       128         ///< Ring size (power of 2)
+#endif
+
+#if (TRACE_LOG_RECORDS & (TRACE_LOG_RECORDS - 1)) != 0
+#error "TRACE_LOG_RECORDS must be a power of 2"
+#endif
+
+#define TRACE_LOG_MAX_ARGS      3
+#define TRACE_LOG_SYNC_0        0x54        ///< 'T'
+#define TRACE_LOG_SYNC_1        0x52        ///< 'R'
+#define TRACE_LOG_FRAME_SIZE    (2 + sizeof(trace_record_t))
+
+/**
+ * @brief One log record
+ */
+typedef struct {
+    uint32_t fmt;                           ///< Format string address in .trace_fmt (0 = empty)
+    uint32_t cycles;                        ///< DWT cycle counter at the call
+    uint32_t args[TRACE_LOG_MAX_ARGS];
+} trace_record_t;
+
+/**
+ * @brief Log statistics
+ */
+typedef struct {
+    uint32_t written;                       ///< Records stored
+    uint32_t dropped;                       ///< Records lost to a full ring
+    uint32_t high_water;                    ///< Peak records pending
+} trace_log_stats_t;
+
+//=============================================================================
+// Logging Macros
+//=============================================================================
+
+/**
+ * @brief Place a format string in .trace_fmt and yield its ID
+ */
+#define TRACE_FMT(str) __extension__ ({                                        \
+    static const char _trace_fmt[] __attribute__((section(".trace_fmt"), used)) = str; \
+    (uint32_t)(uintptr_t)_trace_fmt;                                           \
+})
+
+#define TRACE0(fmt)             trace_log_write(TRACE_FMT(fmt), 0, 0, 0)
+#define TRACE1(fmt, a)          trace_log_write(TRACE_FMT(fmt), (uint32_t)(a), 0, 0)
+#define TRACE2(fmt, a, b)       trace_log_write(TRACE_FMT(fmt), (uint32_t)(a), (uint32_t)(b), 0)
+#define TRACE3(fmt, a, b, c)    trace_log_write(TRACE_FMT(fmt), (uint32_t)(a), (uint32_t)(b), (uint32_t)(c))
+
+/**
+ * @brief Float argument as its bit pattern
+ */
+static inline uint32_t trace_f32(float value) {
+    union { float f; uint32_t u; } bits;
+    bits.f = value;
+    return bits.u;
+}
+
+//=============================================================================
+// Public Functions
+//=============================================================================
+
+/**
+ * @brief Clear the ring and enable the cycle counter
+ */
+void trace_log_init(void);
+
+/**
+ * @brief Store one record (use the TRACEn() macros)
+ *
+ * @param fmt Format ID from TRACE_FMT()
+ * @return false if the ring was full (record dropped)
+ */
+bool trace_log_write(uint32_t fmt, uint32_t a, uint32_t b, uint32_t c);
+
+/**
+ * @brief Take the oldest complete record (single reader, main loop)
+ *
+ * @param record Destination
+ * @return false if no complete record is pending
+ */
+bool trace_log_read(trace_record_t* record);
+
+/**
+ * @brief Serialize a record into a wire frame
+ *
+ * @param record Record from trace_log_read()
+ * @param frame Destination, TRACE_LOG_FRAME_SIZE bytes
+ */
+void trace_log_frame(const trace_record_t* record, uint8_t* frame);
+
+/**
+ * @brief Get log statistics
+ */
+void trace_log_get_stats(trace_log_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TRACE_LOG_H
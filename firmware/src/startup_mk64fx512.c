@@ -13,12 +13,19 @@
 
 #include <stdint.h>
 #include <string.h>
+#include "stack_monitor.h"
 
 //=============================================================================
 // External symbols from linker script
 //=============================================================================
 
-extern uint32_t _sstack;     // Initial stack pointer
+extern uint32_t _estack;     // Initial stack pointer (top of SRAM_L)
+extern uint32_t _sstack;     // Lowest stack address
+extern uint32_t _siramfunc;  // Start of .ramfunc in Flash
+extern uint32_t _sramfunc;   // Start of .ramfunc in SRAM_L
+extern uint32_t _eramfunc;   // End of .ramfunc in SRAM_L
+extern uint32_t _sram_vectors; // RAM vector table in SRAM_L
+extern uint32_t _eram_vectors; // End of RAM vector table
 extern uint32_t _sidata;     // Start of .data in Flash
 extern uint32_t _sdata;      // Start of .data in RAM
 extern uint32_t _edata;      // End of .data in RAM
@@ -138,7 +145,7 @@ void ENET_Error_IRQHandler(void) __attribute__((weak, alias("Default_Handler")))
 __attribute__((section(".vectors"), used))
 void (*const g_pfnVectors[])(void) = {
     // Core Level - CM4
-    (void (*)(void))&_sstack,           // 0:  Initial Stack Pointer
+    (void (*)(void))&_estack,           // 0:  Initial Stack Pointer
     Reset_Handler,                       // 1:  Reset Handler
     NMI_Handler,                         // 2:  NMI Handler
     HardFault_Handler,                   // 3:  Hard Fault Handler
@@ -247,9 +254,30 @@ void (*const g_pfnVectors[])(void) = {
 // Reset Handler - Called on startup/reset
 //=============================================================================
 
+// Vector Table Offset Register (System Control Block)
+#define SCB_VTOR    (*(volatile uint32_t*)0xE000ED08)
+
 void Reset_Handler(void) {
     uint32_t *src, *dest;
 
+    // Copy ISR code and data (.ramfunc/.fastdata) from Flash to SRAM_L
+    src = &_siramfunc;
+    dest = &_sramfunc;
+    while (dest < &_eramfunc) {
+        *dest++ = *src++;
+    }
+
+    // Relocate the vector table to SRAM_L so exception entry fetches the
+    // handler address over the code bus instead of from Flash
+    src = (uint32_t*)g_pfnVectors;
+    dest = &_sram_vectors;
+    while (dest < &_eram_vectors) {
+        *dest++ = *src++;
+    }
+    SCB_VTOR = (uint32_t)(uintptr_t)&_sram_vectors;
+    __asm volatile("dsb");
+    __asm volatile("isb");
+
     // Copy .data section from Flash to RAM
     src = &_sidata;
     dest = &_sdata;
@@ -263,6 +291,15 @@ void Reset_Handler(void) {
         *dest++ = 0;
     }
 
+    // Paint the unused main stack for high-water measurement, stopping
+    // short of the live Reset_Handler frame
+    uint32_t sp;
+    __asm volatile("mov %0, sp" : "=r"(sp));
+    dest = &_sstack;
+    while ((uint32_t)(uintptr_t)dest < sp - 32) {
+        *dest++ = STACK_PAINT_PATTERN;
+    }
+
     // Call global constructors (C++)
     extern void (*__init_array_start[])(void);
     extern void (*__init_array_end[])(void);
@@ -0,0 +1,107 @@
+/**
+ * @file fuzz_main.c
+ * @brief Standalone driver for LLVMFuzzerTestOneInput targets
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * Used when the target is not linked with libFuzzer (GCC builds, AFL):
+ *
+ *   ts_fuzz FILE...              run each file once (corpus replay, AFL @@)
+ *   ts_fuzz -                    run stdin once (AFL stdin mode)
+ *   ts_fuzz [-runs=N] [-seed=S]  N generated inputs (default 100000)
+ *
+ * Generated inputs mix raw noise with packet-shaped data (start byte,
+ * plausible or oversized length, payload) so the random run reaches the
+ * packet handlers, not only the start-byte search.
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FUZZ_MAX_INPUT          4096
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+static uint32_t rng_state;
+
+static uint32_t rng_next(void) {
+    // xorshift32
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static size_t generate(uint8_t* buf) {
+    size_t size = 1 + rng_next() % (FUZZ_MAX_INPUT - 1);
+    size_t i = 0;
+
+    buf[i++] = (uint8_t)rng_next();
+    while (i < size) {
+        uint32_t r = rng_next();
+        if ((r & 3) == 0 && i + 2 < size) {
+            // Packet-shaped: start byte, length, command and payload
+            buf[i++] = 0xAA;
+            buf[i++] = (uint8_t)((r >> 8) & 1 ? (r >> 16) : (r >> 16) % 64);
+            buf[i++] = (uint8_t)((r >> 24) % 10);
+        } else {
+            buf[i++] = (uint8_t)(r >> 8);
+        }
+    }
+    return size;
+}
+
+static int run_file(const char* path) {
+    static uint8_t buf[1 << 20];
+    FILE* f = (strcmp(path, "-") == 0) ? stdin : fopen(path, "rb");
+    if (f == NULL) {
+        perror(path);
+        return 1;
+    }
+
+    size_t size = fread(buf, 1, sizeof(buf), f);
+    if (f != stdin) {
+        fclose(f);
+    }
+
+    LLVMFuzzerTestOneInput(buf, size);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    unsigned long runs = 100000;
+    unsigned long seed = 1;
+    int files = 0;
+    int rc = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "-runs=", 6) == 0) {
+            runs = strtoul(argv[i] + 6, NULL, 0);
+        } else if (strncmp(argv[i], "-seed=", 6) == 0) {
+            seed = strtoul(argv[i] + 6, NULL, 0);
+        } else {
+            rc |= run_file(argv[i]);
+            files++;
+        }
+    }
+
+    if (files > 0) {
+        return rc;
+    }
+
+    static uint8_t buf[FUZZ_MAX_INPUT];
+    rng_state = (uint32_t)seed ? (uint32_t)seed : 1;
+    for (unsigned long n = 0; n < runs; n++) {
+        size_t size = generate(buf);
+        LLVMFuzzerTestOneInput(buf, size);
+    }
+
+    printf("%lu inputs, seed %lu: OK\n", runs, seed);
+    return 0;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file ts_bench.c
+ * @brief TunerStudio parser throughput benchmark (host)
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * Feeds a prebuilt stream through tunerstudio_process_byte() and reports
+ * MB/s and packets/s. The stream is the tuning-session mix: mostly
+ * full-size write chunks, with query and out-of-range packets and line
+ * noise between packets. Responses go to the counting UART stub.
+ *
+ *   ts_bench [-seconds=S] [-min-mbps=X]
+ *
+ * -min-mbps fails (exit 1) below the given throughput, for use as a
+ * regression gate. Compare numbers from the same build type only: the
+ * sanitizer build is several times slower than a plain -O2 build
+ * (-DENABLE_SANITIZERS=OFF).
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "tunerstudio.h"
+#include "event_trace.h"
+#include "hal_stubs.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_STREAM_SIZE       (1 << 20)
+#define BENCH_PAYLOAD           200
+
+static uint8_t stream[BENCH_STREAM_SIZE];
+
+static size_t put_packet(uint8_t* p, uint8_t command, uint16_t offset, uint8_t payload) {
+    size_t n = 0;
+    p[n++] = 0xAA;
+    p[n++] = payload;
+    p[n++] = command;
+    p[n++] = (uint8_t)(offset >> 8);
+    p[n++] = (uint8_t)offset;
+    for (uint8_t i = 0; i < payload; i++) {
+        p[n++] = (uint8_t)(i * 7);
+    }
+    for (int i = 0; i < TS_PACKET_TAIL_SIZE; i++) {
+        p[n++] = 0x5A;
+    }
+    return n;
+}
+
+static size_t build_stream(uint32_t* packets) {
+    size_t size = 0;
+    uint32_t count = 0;
+    uint32_t n = 0;
+
+    while (size + TS_MAX_PACKET_SIZE + 16 < BENCH_STREAM_SIZE) {
+        switch (n++ % 16) {
+            case 0:
+                size += put_packet(&stream[size], TS_COMMAND_QUERY, 0, 0);
+                break;
+            case 1:
+                // Chunk past the end of the page (rejected)
+                size += put_packet(&stream[size], TS_COMMAND_WRITE_CHUNK, TS_PAGE_SIZE - 8, 32);
+                break;
+            case 2:
+                // Line noise between packets
+                memset(&stream[size], 0x55, 8);
+                size += 8;
+                continue;
+            default:
+                size += put_packet(&stream[size], TS_COMMAND_WRITE_CHUNK,
+                                   (uint16_t)((n * BENCH_PAYLOAD) % (TS_PAGE_SIZE - BENCH_PAYLOAD)),
+                                   BENCH_PAYLOAD);
+                break;
+        }
+        count++;
+    }
+
+    *packets = count;
+    return size;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char** argv) {
+    double seconds = 1.0;
+    double min_mbps = 0.0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "-seconds=", 9) == 0) {
+            seconds = atof(argv[i] + 9);
+        } else if (strncmp(argv[i], "-min-mbps=", 10) == 0) {
+            min_mbps = atof(argv[i] + 10);
+        }
+    }
+
+    event_trace_init();
+    tunerstudio_init();
+
+    uint32_t packets;
+    size_t size = build_stream(&packets);
+    uint32_t total_before = tunerstudio_get_counters()->totalCounter;
+
+    double start = now_seconds();
+    double elapsed;
+    uint64_t bytes = 0;
+    uint32_t passes = 0;
+
+    do {
+        for (size_t i = 0; i < size; i++) {
+            tunerstudio_process_byte(stream[i]);
+        }
+        bytes += size;
+        passes++;
+        elapsed = now_seconds() - start;
+    } while (elapsed < seconds);
+
+    // Every packet in the stream must have been framed and dispatched
+    uint32_t processed = tunerstudio_get_counters()->totalCounter - total_before;
+    if (processed != packets * passes) {
+        printf("FAIL: %u packets processed, expected %u\n", processed, packets * passes);
+        return 1;
+    }
+
+    double mbps = (double)bytes / elapsed / 1e6;
+    printf("parser: %.1f MB/s, %.0f packets/s (%u passes of %zu bytes, %u UART bytes out)\n",
+           mbps, (double)processed / elapsed, passes, size, host_uart_tx_bytes);
+
+    if (mbps < min_mbps) {
+        printf("FAIL: below %.1f MB/s\n", min_mbps);
+        return 1;
+    }
+    return 0;
+}
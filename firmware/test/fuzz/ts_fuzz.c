@@ -0,0 +1,128 @@
+/**
+ * @file ts_fuzz.c
+ * @brief Fuzz target for the TunerStudio byte parser and page writes
+ * @version 1.1.0
+ * @date 2026-10-18
+ *
+ * libFuzzer entry point (also driven by fuzz_main.c for AFL and plain
+ * sanitizer builds). The first input byte selects the mode:
+ *
+ * - even: the rest is a raw byte stream for tunerstudio_process_byte().
+ *   Afterwards the parser must resynchronize: TS_MAX_PACKET_SIZE zero
+ *   bytes flush any pending packet, then one query packet must be
+ *   processed exactly once.
+ * - odd: the rest is a list of (page, offset, size, data) page writes
+ *   and reads. tunerstudio_write_chunk() must accept exactly the chunks
+ *   that fit a writable page, and event trace chunks other than 0 must
+ *   read as zeros unless a dump has frozen the ring.
+ *
+ * Any violated property aborts, which both fuzzers report as a crash.
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "tunerstudio.h"
+#include "event_trace.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#define TS_START_BYTE           0xAA
+
+static void check(int condition) {
+    if (!condition) {
+        abort();
+    }
+}
+
+static void feed(const uint8_t* data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        tunerstudio_process_byte(data[i]);
+    }
+}
+
+static void fuzz_stream(const uint8_t* data, size_t size) {
+    static const uint8_t zeros[TS_MAX_PACKET_SIZE + 1];
+    static const uint8_t query[] = {
+        TS_START_BYTE, 0, TS_COMMAND_QUERY, 0, 0, 0, 0, 0, 0
+    };
+
+    feed(data, size);
+
+    // Flush: a pending packet completes, zeros are ignored between packets
+    feed(zeros, sizeof(zeros));
+
+    uint32_t before = tunerstudio_get_counters()->queryCommandCounter;
+    feed(query, sizeof(query));
+    check(tunerstudio_get_counters()->queryCommandCounter == before + 1);
+}
+
+static void fuzz_pages(const uint8_t* data, size_t size) {
+    uint8_t page_data[TS_MAX_DATA_SIZE];
+
+    while (size >= 5) {
+        uint16_t page = (uint16_t)((data[0] << 8) | data[1]);
+        uint16_t offset = (uint16_t)((data[2] << 8) | data[3]);
+        uint8_t length = data[4];
+        data += 5;
+        size -= 5;
+
+        if (length & 0x80) {
+            // Read: any size up to one packet, into an exact-size buffer
+            uint16_t read_size = (uint16_t)(length & 0x7F) * 2;
+            if (read_size > sizeof(page_data)) {
+                read_size = sizeof(page_data);
+            }
+
+            // Event trace chunks past 0 are only served from a frozen ring
+            bool trace_rejected = (page & 0xFF00) == TS_PAGE_EVENT_TRACE &&
+                                  (page & 0xFF) != 0 && !event_trace_is_frozen();
+            tunerstudio_read_page(page, page_data, read_size);
+            for (uint16_t i = 0; trace_rejected && i < read_size; i++) {
+                check(page_data[i] == 0);
+            }
+
+            // Time between reads (offset): abandoned dumps time out
+            host_cycles_advance((uint32_t)offset << 12);
+            event_trace_update();
+            continue;
+        }
+
+        uint8_t chunk = (length <= size) ? length : (uint8_t)size;
+        int expected_ok = ((uint32_t)offset + chunk <= TS_PAGE_SIZE) &&
+                          page != TS_PAGE_MEMORY &&
+                          (page & 0xFF00) != TS_PAGE_EVENT_TRACE;
+
+        int result = tunerstudio_write_chunk(page, offset, data, chunk);
+        check((result == 0) == expected_ok);
+
+        data += chunk;
+        size -= chunk;
+    }
+
+    // A write with no data is always rejected
+    check(tunerstudio_write_chunk(TS_PAGE_SETTINGS, 0, NULL, 1) != 0);
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    static int initialized = 0;
+    if (!initialized) {
+        event_trace_init();
+        initialized = 1;
+    }
+
+    tunerstudio_init();
+    event_trace_resume();
+
+    if (size == 0) {
+        return 0;
+    }
+
+    if ((data[0] & 1) == 0) {
+        fuzz_stream(data + 1, size - 1);
+    } else {
+        fuzz_pages(data + 1, size - 1);
+    }
+    return 0;
+}
@@ -0,0 +1,232 @@
+/**
+ * @file dispatcher_sim.c
+ * @brief Dwell/spark pairing simulation for the angle dispatcher (host)
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * Runs an 8-cylinder COP engine on a 36-1 wheel through engine_sim and
+ * checks every coil event:
+ *
+ * - a dwell never starts on a coil that is already charging
+ * - a spark only fires a coil that is charging (ignition_coils_release()
+ *   returns the latched mask, and nothing once released)
+ * - each slot sparks within its advance range before its TDC, once per
+ *   cycle, even while the advance crosses 0° at slot 0 (cycle start)
+ *
+ * Scenarios: advance stepping between 0° and 40° every cycle, the rev
+ * limiter moving through retard, spark cut and hard cut, and a slow main
+ * loop that misses some builds (the previous list is reused).
+ *
+ *   dispatcher_sim [-cycles=N] [-rpm=R]
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "engine_sim.h"
+#include "hal_stubs.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_CYLINDERS           8
+#define SIM_MAX_ADVANCE         40
+#define SIM_WARMUP_CYCLES       2
+
+static const uint8_t advance_steps[] = { 0, 15, 0, 35, 5, 0, SIM_MAX_ADVANCE, 2, 0, 25 };
+
+static ecu_state_t ecu;
+static event_scheduler_t sched;
+static angle_dispatcher_t disp;
+static ignition_coils_t coils;
+static rev_limiter_t limiter;
+
+static uint16_t sim_rpm;
+static cylinder_mask_t charging;
+static int32_t last_spark[SIM_CYLINDERS];
+static uint32_t sparks;
+static uint32_t failures;
+
+// Scenario settings read by the main loop hook
+static bool vary_advance;
+static bool use_limiter;
+static uint32_t skip_build_every;
+
+static int32_t sim_degrees(void) {
+    return (int32_t)engine_sim_cycle * FULL_CYCLE_ANGLE + engine_sim_angle;
+}
+
+static void fail(const char* what, uint8_t slot) {
+    if (failures < 10) {
+        printf("FAIL: %s, slot %u at cycle %u angle %u\n",
+               what, slot, engine_sim_cycle, engine_sim_angle);
+    }
+    failures++;
+}
+
+static void dwell_action(uint8_t slot) {
+    cylinder_mask_t mask = ignition_coils_get_mask(&coils, slot);
+    if (mask == 0) {
+        fail("dwell without coil", slot);
+    }
+    if (charging & mask) {
+        fail("double dwell", slot);
+    }
+    charging |= mask;
+}
+
+static void spark_action(uint8_t slot) {
+    cylinder_mask_t mask = ignition_coils_release(&coils, slot);
+    if (mask == 0) {
+        fail("spark without armed coil", slot);
+        return;
+    }
+    if (mask & ~charging) {
+        fail("spark on uncharged coil", slot);
+    }
+    charging &= (cylinder_mask_t)~mask;
+
+    // Within the advance range before this slot's TDC
+    int32_t tdc = (int32_t)(engine_slot_tdc_angle(&ecu.config, slot) + 0.5f);
+    int32_t lead = ((tdc - engine_sim_angle) % FULL_CYCLE_ANGLE + FULL_CYCLE_ANGLE) % FULL_CYCLE_ANGLE;
+    if (lead > SIM_MAX_ADVANCE) {
+        fail("spark outside advance range", slot);
+    }
+
+    int32_t now = sim_degrees();
+    if (last_spark[slot] >= 0 && now - last_spark[slot] < FULL_CYCLE_ANGLE - SIM_MAX_ADVANCE) {
+        fail("double spark", slot);
+    }
+    if (!use_limiter && last_spark[slot] >= 0 &&
+        now - last_spark[slot] > FULL_CYCLE_ANGLE + SIM_MAX_ADVANCE) {
+        fail("missed spark", slot);
+    }
+    last_spark[slot] = now;
+    sparks++;
+}
+
+static void main_loop(uint32_t cycle, uint16_t angle) {
+    (void)angle;
+
+    if (vary_advance) {
+        uint8_t advance = advance_steps[cycle % sizeof(advance_steps)];
+        for (uint8_t cyl = 0; cyl < SIM_CYLINDERS; cyl++) {
+            ecu.ignition.cylinder_timing_deg[cyl] = advance;
+        }
+    }
+
+    if (use_limiter) {
+        // Through retard, spark cut and hard cut and back, 40 cycles each
+        static const int16_t offsets[] = { -1000, -200, -100, 100, -100, -1000 };
+        int16_t offset = offsets[(cycle / 40) % (sizeof(offsets) / sizeof(offsets[0]))];
+        ecu.sensors.rpm = (uint16_t)(limiter.config.rpm_limit + offset);
+    }
+
+    if (skip_build_every != 0 && cycle % skip_build_every == skip_build_every - 1) {
+        return;  // Main loop busy for this whole cycle
+    }
+    dispatcher_update(&disp);
+}
+
+static void setup(void) {
+    engine_config_t config = {
+        SIM_CYLINDERS, 5000, 36, 1, { 1, 8, 4, 3, 6, 5, 7, 2 }, { 0 }
+    };
+
+    ecu_init(&ecu, &config);
+    ecu.ignition.ignition_mode = IGNITION_MODE_COP;
+    ecu.sensors.rpm = sim_rpm;
+    ecu.sensors.battery_voltage = 13.5f;
+    for (uint8_t cyl = 0; cyl < SIM_CYLINDERS; cyl++) {
+        ecu.ignition.cylinder_timing_deg[cyl] = 20;
+    }
+
+    host_cam_synced = true;
+    ignition_coils_init(&coils, &ecu, NULL);
+
+    dispatcher_init(&disp, &ecu, &sched, NULL, spark_action);
+    dispatcher_set_ignition(&disp, &coils);
+    dispatcher_set_dwell_action(&disp, dwell_action);
+    if (use_limiter) {
+        rev_limiter_init(&limiter, SIM_CYLINDERS, (uint16_t)(sim_rpm + 200));
+        dispatcher_set_rev_limiter(&disp, &limiter);
+    }
+
+    engine_sim_reset();
+    charging = 0;
+    sparks = 0;
+    for (uint8_t cyl = 0; cyl < SIM_CYLINDERS; cyl++) {
+        last_spark[cyl] = -1;
+    }
+}
+
+static bool run_scenario(const char* name, uint32_t cycles, uint16_t main_loop_deg) {
+    uint32_t failures_before = failures;
+
+    setup();
+
+    engine_sim_t sim = { &disp, sim_rpm, 10, main_loop_deg, main_loop };
+    engine_sim_run(&sim, SIM_WARMUP_CYCLES);
+    uint32_t late_before = disp.events_late;
+    engine_sim_run(&sim, cycles);
+
+    if (disp.events_late != late_before) {
+        printf("FAIL: %u events late after warm-up\n", disp.events_late - late_before);
+        failures++;
+    }
+    if (skip_build_every == 0 && disp.list_overruns != 0) {
+        printf("FAIL: %u list overruns\n", disp.list_overruns);
+        failures++;
+    }
+    if (skip_build_every != 0 && disp.list_overruns == 0) {
+        printf("FAIL: skipped builds not counted as overruns\n");
+        failures++;
+    }
+    if (!use_limiter && sparks < (cycles - 1) * SIM_CYLINDERS) {
+        printf("FAIL: %u sparks in %u cycles\n", sparks, cycles);
+        failures++;
+    }
+    if (engine_sim_stats.queue_full != 0 || disp.arm_failures != 0) {
+        printf("FAIL: scheduler queue full (%u)\n", engine_sim_stats.queue_full);
+        failures++;
+    }
+
+    bool ok = (failures == failures_before);
+    printf("%-16s %s: %u sparks, %u overruns, %u armed, queue depth %u\n",
+           name, ok ? "OK" : "FAILED", sparks, disp.list_overruns,
+           disp.events_armed, engine_sim_stats.max_depth);
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    uint32_t cycles = 2000;
+    sim_rpm = 6000;
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "-cycles=", 8) == 0) {
+            cycles = (uint32_t)strtoul(argv[i] + 8, NULL, 0);
+        } else if (strncmp(argv[i], "-rpm=", 5) == 0) {
+            sim_rpm = (uint16_t)strtoul(argv[i] + 5, NULL, 0);
+        }
+    }
+    if (cycles < 2 || sim_rpm == 0) {
+        printf("usage: dispatcher_sim [-cycles=N] [-rpm=R]\n");
+        return 2;
+    }
+
+    bool ok = true;
+
+    vary_advance = true;
+    use_limiter = false;
+    skip_build_every = 0;
+    ok &= run_scenario("advance_steps", cycles, 10);
+
+    use_limiter = true;
+    ok &= run_scenario("rev_limiter", cycles, 10);
+
+    use_limiter = false;
+    skip_build_every = 7;
+    ok &= run_scenario("slow_main_loop", cycles, 90);
+
+    return ok ? 0 : 1;
+}
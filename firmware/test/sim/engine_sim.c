@@ -0,0 +1,129 @@
+/**
+ * @file engine_sim.c
+ * @brief Crank-angle simulation for the angle dispatcher (host)
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "engine_sim.h"
+#include <string.h>
+
+typedef struct {
+    uint16_t remaining_deg;           // Degrees until the event fires
+    uint8_t cylinder;
+    void (*action)(uint8_t);
+} sim_event_t;
+
+uint16_t engine_sim_angle;
+uint32_t engine_sim_cycle;
+uint32_t engine_sim_time_us;
+engine_sim_stats_t engine_sim_stats;
+
+// Every armed event holds an FTM channel on the target until it fires
+// (scheduler_add_event() fails when hw_scheduler_schedule() does), so
+// the depth that matters is the hardware one, not MAX_SCHEDULED_EVENTS
+#define SIM_QUEUE_SIZE  HW_SCHEDULER_MAX_EVENTS
+
+_Static_assert(SIM_QUEUE_SIZE <= MAX_SCHEDULED_EVENTS,
+               "every hardware slot needs a software event slot");
+
+static sim_event_t queue[SIM_QUEUE_SIZE];
+static uint8_t queue_depth;
+
+bool scheduler_add_event(event_scheduler_t* sched,
+                         uint16_t angle,
+                         uint8_t cylinder,
+                         void (*action)(uint8_t),
+                         uint32_t current_time_us)
+{
+    (void)sched;
+    (void)current_time_us;
+
+    if (action == NULL || queue_depth >= SIM_QUEUE_SIZE) {
+        engine_sim_stats.queue_full++;
+        return false;
+    }
+
+    sim_event_t* ev = &queue[queue_depth++];
+    ev->remaining_deg = (uint16_t)((angle % FULL_CYCLE_ANGLE + FULL_CYCLE_ANGLE - engine_sim_angle) %
+                                   FULL_CYCLE_ANGLE);
+    ev->cylinder = cylinder;
+    ev->action = action;
+
+    engine_sim_stats.queued++;
+    if (queue_depth > engine_sim_stats.max_depth) {
+        engine_sim_stats.max_depth = queue_depth;
+    }
+    return true;
+}
+
+void engine_sim_reset(void)
+{
+    engine_sim_angle = 0;
+    engine_sim_cycle = 0;
+    engine_sim_time_us = 0;
+    queue_depth = 0;
+    memset(&engine_sim_stats, 0, sizeof(engine_sim_stats));
+}
+
+/**
+ * @brief Fire due events (in queue order) and age the rest by one degree
+ */
+static void step_queue(void)
+{
+    uint8_t i = 0;
+    while (i < queue_depth) {
+        if (queue[i].remaining_deg == 0) {
+            sim_event_t ev = queue[i];
+            queue[i] = queue[--queue_depth];
+            engine_sim_stats.fired++;
+            ev.action(ev.cylinder);
+        } else {
+            i++;
+        }
+    }
+    for (i = 0; i < queue_depth; i++) {
+        queue[i].remaining_deg--;
+    }
+}
+
+void engine_sim_run(const engine_sim_t* sim, uint32_t cycles)
+{
+    // Missing tooth at the end of each revolution: the tooth before it
+    // covers two tooth spacings
+    uint16_t missing = (uint16_t)(360 - sim->tooth_deg);
+    uint32_t ns_per_deg = 60000000000ULL / ((uint64_t)sim->rpm * 360U);
+    uint64_t time_ns = (uint64_t)engine_sim_time_us * 1000U;
+
+    for (uint32_t n = 0; n < cycles; n++) {
+        for (uint16_t deg = 0; deg < FULL_CYCLE_ANGLE; deg++) {
+            engine_sim_angle = deg;
+            engine_sim_time_us = (uint32_t)(time_ns / 1000U);
+
+            uint16_t in_rev = deg % 360;
+            if (in_rev % sim->tooth_deg == 0 && in_rev != missing) {
+                uint16_t span = (in_rev + sim->tooth_deg == missing) ?
+                                (uint16_t)(2 * sim->tooth_deg) : sim->tooth_deg;
+                dispatcher_on_tooth(sim->disp, deg, span, engine_sim_time_us);
+            }
+
+            step_queue();
+
+            if (sim->main_loop_deg != 0 && deg % sim->main_loop_deg == 0) {
+                if (sim->main_loop != NULL) {
+                    sim->main_loop(engine_sim_cycle, deg);
+                } else {
+                    dispatcher_update(sim->disp);
+                }
+            }
+
+            time_ns += ns_per_deg;
+        }
+        engine_sim_cycle++;
+    }
+
+    engine_sim_time_us = (uint32_t)(time_ns / 1000U);
+}
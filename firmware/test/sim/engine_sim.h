@@ -0,0 +1,75 @@
+/**
+ * @file engine_sim.h
+ * @brief Crank-angle simulation for the angle dispatcher (host)
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * Turns the crank one degree per step at a fixed RPM over a missing-tooth
+ * wheel. On each tooth the dispatcher is called like the tooth ISR would;
+ * every main_loop_deg degrees the main loop hook runs (default:
+ * dispatcher_update()).
+ *
+ * Replaces event_scheduler.c: scheduler_add_event() queues the action and
+ * the simulation calls it when the crank reaches the event angle, so
+ * actions see the crank angle they fired at (engine_sim_angle).
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef ENGINE_SIM_H
+#define ENGINE_SIM_H
+
+#include "angle_dispatcher.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Main loop pass, every main_loop_deg degrees
+ *
+ * Replaces the default dispatcher_update() call, so a hook can change
+ * ECU inputs and decide whether the dispatcher gets its main loop time.
+ */
+typedef void (*engine_sim_hook_t)(uint32_t cycle, uint16_t angle);
+
+typedef struct {
+    angle_dispatcher_t* disp;
+    uint16_t rpm;
+    uint16_t tooth_deg;               ///< Crank degrees per tooth (10 = 36-1 wheel)
+    uint16_t main_loop_deg;           ///< Main loop period in crank degrees
+    engine_sim_hook_t main_loop;      ///< Main loop hook (NULL = dispatcher_update())
+} engine_sim_t;
+
+/**
+ * @brief Scheduler statistics of the simulation
+ */
+typedef struct {
+    uint32_t queued;                  ///< Events accepted
+    uint32_t fired;                   ///< Events whose action ran
+    uint32_t queue_full;              ///< Events refused (queue full)
+    uint32_t max_depth;               ///< Highest queue occupancy
+} engine_sim_stats_t;
+
+extern uint16_t engine_sim_angle;     ///< Crank angle of the current step (0-719°)
+extern uint32_t engine_sim_cycle;     ///< Cycles completed
+extern uint32_t engine_sim_time_us;   ///< Simulated time
+extern engine_sim_stats_t engine_sim_stats;
+
+/**
+ * @brief Reset crank position, time, queue and statistics
+ */
+void engine_sim_reset(void);
+
+/**
+ * @brief Run whole engine cycles (720° each)
+ */
+void engine_sim_run(const engine_sim_t* sim, uint32_t cycles);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_SIM_H
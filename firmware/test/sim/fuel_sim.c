@@ -0,0 +1,221 @@
+/**
+ * @file fuel_sim.c
+ * @brief Per-cylinder fuel accounting simulation (host)
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * Runs a 4-cylinder engine through engine_sim with the injection
+ * transition engine attached and adds up the fuel of every injector
+ * pulse that actually fires. For each finished cycle:
+ *
+ * - the fuel the transition engine booked equals the fuel fired, so a
+ *   squirt cut by the rev limiter or refused by the scheduler is never
+ *   counted as delivered
+ * - without cuts every cylinder receives exactly its cycle fuel
+ *   (last_error_us == 0), through simultaneous -> batch -> sequential
+ *   transitions, cam loss and manual mode requests, with the pulse width
+ *   changing mid-cycle
+ *
+ *   fuel_sim [-cycles=N] [-rpm=R]
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "engine_sim.h"
+#include "hal_stubs.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_CYLINDERS           4
+#define SIM_PHASE_CYCLES        25
+
+static ecu_state_t ecu;
+static event_scheduler_t sched;
+static angle_dispatcher_t disp;
+static injection_transition_t transition;
+static rev_limiter_t limiter;
+static cam_sync_state_t cam;
+
+static uint32_t fired_us[2][INJ_TRANSITION_MAX_CYLINDERS];
+static uint32_t booked_us[INJ_TRANSITION_MAX_CYLINDERS];
+static uint32_t target_us[INJ_TRANSITION_MAX_CYLINDERS];
+static uint32_t cuts;
+static uint32_t checked_cycle;
+static uint32_t cuts_at_cycle_start;
+static uint32_t cycles_checked;
+static uint32_t failures;
+
+static bool use_limiter;
+
+static void fail(const char* what, uint8_t cylinder, int32_t value) {
+    if (failures < 10) {
+        printf("FAIL: %s, cylinder %u (%d us) in cycle %u (%s)\n", what, cylinder, value,
+               disp.cycles - 1, get_injection_mode_name(transition.active_mode));
+    }
+    failures++;
+}
+
+static void inject_action(uint8_t cylinder) {
+    uint32_t pulse = injection_transition_get_pulse(&transition, cylinder);
+    if (pulse <= transition.latency_us) {
+        fail("empty pulse fired", cylinder, (int32_t)pulse);
+        return;
+    }
+    fired_us[disp.cycles & 1][cylinder] += pulse - transition.latency_us;
+}
+
+/**
+ * @brief Compare the finished cycle's fired fuel with its accounting
+ */
+static void check_cycle(void) {
+    uint32_t finished = disp.cycles - 1;
+    uint32_t* fired = fired_us[finished & 1];
+    bool cut = (cuts != cuts_at_cycle_start);
+
+    // The first cycle after sync starts mid-cycle and is not accounted
+    if (finished > 0) {
+        for (uint8_t cyl = 0; cyl < SIM_CYLINDERS; cyl++) {
+            if (fired[cyl] != booked_us[cyl]) {
+                fail("fired fuel differs from booked", cyl, (int32_t)fired[cyl] - (int32_t)booked_us[cyl]);
+            }
+            if (transition.last_error_us[cyl] != (int32_t)(target_us[cyl] - booked_us[cyl])) {
+                fail("fuel error not recorded", cyl, transition.last_error_us[cyl]);
+            }
+            if (!cut && transition.last_error_us[cyl] != 0) {
+                fail("fuel error without cut", cyl, transition.last_error_us[cyl]);
+            }
+        }
+        cycles_checked++;
+    }
+
+    memset(fired, 0, sizeof(fired_us[0]));
+    cuts_at_cycle_start = cuts;
+    checked_cycle = disp.cycles;
+}
+
+static void main_loop(uint32_t cycle, uint16_t angle) {
+    if (disp.cycles != checked_cycle) {
+        check_cycle();
+    }
+
+    // Accounting of the running cycle, complete at its last degree
+    memcpy(booked_us, transition.delivered_us, sizeof(booked_us));
+    memcpy(target_us, transition.target_us, sizeof(target_us));
+    cuts = limiter.injections_cut;
+
+    if (angle == 0) {
+        // Mode phases: cranking, batch, sequential, cam lost, then manual
+        // requests of every mode
+        static const injection_mode_t manual[] = {
+            INJECTION_MODE_SEQUENTIAL, INJECTION_MODE_SINGLE_POINT,
+            INJECTION_MODE_BATCH, INJECTION_MODE_SIMULTANEOUS
+        };
+        uint32_t phase = (cycle / SIM_PHASE_CYCLES) % 8;
+        if (phase < 4) {
+            injection_transition_set_auto(&transition, true);
+            ecu.sensors.engine_running = (phase != 0);
+            host_cam_synced = (phase == 2);
+        } else {
+            injection_transition_request(&transition, manual[phase - 4]);
+        }
+
+        if (use_limiter) {
+            // Fuel cut stages of the limiter, 20 cycles each
+            static const int16_t offsets[] = { -1000, 100, -100, 100, -1000 };
+            int16_t offset = offsets[(cycle / 20) % (sizeof(offsets) / sizeof(offsets[0]))];
+            ecu.sensors.rpm = (uint16_t)(limiter.config.rpm_limit + offset);
+        }
+    }
+
+    if (angle % 180 == 90) {
+        // Pulse width changes mid-cycle, different per cylinder
+        for (uint8_t cyl = 0; cyl < SIM_CYLINDERS; cyl++) {
+            ecu.fuel.cylinder_pulse_us[cyl] = 2500U + ((cycle * 37U + angle + cyl * 113U) % 1500U);
+        }
+    }
+
+    dispatcher_update(&disp);
+}
+
+static bool run_scenario(const char* name, uint16_t rpm, uint32_t cycles) {
+    uint32_t failures_before = failures;
+    engine_config_t config = {
+        SIM_CYLINDERS, 2000, 36, 1, { 1, 3, 4, 2 }, { 0 }
+    };
+
+    ecu_init(&ecu, &config);
+    ecu.sensors.rpm = rpm;
+    ecu.sensors.battery_voltage = 13.5f;
+    ecu.fuel.injection_mode = INJECTION_MODE_SIMULTANEOUS;
+    host_cam_synced = false;
+
+    injection_transition_init(&transition, &ecu, &cam);
+    dispatcher_init(&disp, &ecu, &sched, inject_action, NULL);
+    dispatcher_set_transition(&disp, &transition);
+    if (use_limiter) {
+        rev_limiter_init(&limiter, SIM_CYLINDERS, (uint16_t)(rpm + 500));
+        dispatcher_set_rev_limiter(&disp, &limiter);
+    } else {
+        memset(&limiter, 0, sizeof(limiter));
+    }
+
+    engine_sim_reset();
+    memset(fired_us, 0, sizeof(fired_us));
+    cuts = 0;
+    cuts_at_cycle_start = 0;
+    checked_cycle = 0;
+    cycles_checked = 0;
+
+    // Main loop every degree: the accounting copy is taken after the
+    // last event of each cycle
+    engine_sim_t sim = { &disp, rpm, 10, 1, main_loop };
+    engine_sim_run(&sim, cycles);
+
+    if (cycles_checked + 2 < cycles) {
+        printf("FAIL: %u of %u cycles checked\n", cycles_checked, cycles);
+        failures++;
+    }
+    if (transition.transitions == 0) {
+        printf("FAIL: no mode transitions\n");
+        failures++;
+    }
+    if (use_limiter && limiter.injections_cut == 0) {
+        printf("FAIL: rev limiter never cut fuel\n");
+        failures++;
+    }
+
+    bool ok = (failures == failures_before);
+    printf("%-12s %s: %u cycles, %u transitions, %u error cycles, %u injections cut\n",
+           name, ok ? "OK" : "FAILED", cycles_checked, transition.transitions,
+           transition.error_cycles, limiter.injections_cut);
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    uint32_t cycles = 1000;
+    uint16_t rpm = 3000;
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "-cycles=", 8) == 0) {
+            cycles = (uint32_t)strtoul(argv[i] + 8, NULL, 0);
+        } else if (strncmp(argv[i], "-rpm=", 5) == 0) {
+            rpm = (uint16_t)strtoul(argv[i] + 5, NULL, 0);
+        }
+    }
+    if (cycles < 3 || rpm == 0) {
+        printf("usage: fuel_sim [-cycles=N] [-rpm=R]\n");
+        return 2;
+    }
+
+    bool ok = true;
+
+    use_limiter = false;
+    ok &= run_scenario("transitions", rpm, cycles);
+
+    use_limiter = true;
+    ok &= run_scenario("rev_limiter", rpm, cycles);
+
+    return ok ? 0 : 1;
+}
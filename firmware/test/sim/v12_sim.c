@@ -0,0 +1,166 @@
+/**
+ * @file v12_sim.c
+ * @brief V12 at 9000 RPM through the angle dispatcher (host)
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * Built with ENGINE_MAX_CYLINDERS=12. Runs a 12-cylinder COP engine with
+ * dwell on a 36-1 wheel at 9000 RPM (one tooth every 185 us, a spark
+ * every 60°), in sequential and then batch injection, and checks that
+ * the sized lists and queues keep up:
+ *
+ * - every event armed: no late events, no scheduler queue failures
+ * - every spark paired with its dwell on an armed coil
+ * - one spark per cylinder and the expected injections per cycle
+ * - the scheduler queue never fills (HW_SCHEDULER_MAX_EVENTS FTM channels)
+ *
+ *   v12_sim [-cycles=N] [-rpm=R]
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "engine_sim.h"
+#include "hal_stubs.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_CYLINDERS           12
+#define SIM_WARMUP_CYCLES       3
+
+#if ENGINE_MAX_CYLINDERS < SIM_CYLINDERS
+#error "v12_sim needs ENGINE_MAX_CYLINDERS >= 12"
+#endif
+
+static ecu_state_t ecu;
+static event_scheduler_t sched;
+static angle_dispatcher_t disp;
+static injection_transition_t transition;
+static ignition_coils_t coils;
+static cam_sync_state_t cam;
+
+static uint32_t dwells;
+static uint32_t sparks;
+static uint32_t injections;
+static uint32_t bad_sparks;
+
+static void inject_action(uint8_t cylinder) {
+    (void)cylinder;
+    injections++;
+}
+
+static void dwell_action(uint8_t slot) {
+    (void)slot;
+    dwells++;
+}
+
+static void spark_action(uint8_t slot) {
+    if (ignition_coils_release(&coils, slot) == 0) {
+        bad_sparks++;
+    }
+    sparks++;
+}
+
+static bool run_mode(injection_mode_t mode, uint16_t rpm, uint32_t cycles) {
+    static const engine_config_t config = {
+        SIM_CYLINDERS, 6000, 36, 1,
+        { 1, 7, 5, 11, 3, 9, 6, 12, 2, 8, 4, 10 }, { 0 }
+    };
+
+    ecu_init(&ecu, &config);
+    ecu.sensors.rpm = rpm;
+    ecu.sensors.engine_running = true;
+    ecu.sensors.battery_voltage = 13.5f;
+    ecu.ignition.ignition_mode = IGNITION_MODE_COP;
+    ecu.fuel.injection_mode = mode;
+    for (uint8_t cyl = 0; cyl < SIM_CYLINDERS; cyl++) {
+        ecu.ignition.cylinder_timing_deg[cyl] = 35;
+        ecu.fuel.cylinder_pulse_us[cyl] = 4000;
+    }
+
+    host_cam_synced = true;
+    injection_transition_init(&transition, &ecu, &cam);
+    injection_transition_request(&transition, mode);
+    ignition_coils_init(&coils, &ecu, NULL);
+
+    dispatcher_init(&disp, &ecu, &sched, inject_action, spark_action);
+    dispatcher_set_transition(&disp, &transition);
+    dispatcher_set_ignition(&disp, &coils);
+    dispatcher_set_dwell_action(&disp, dwell_action);
+
+    engine_sim_reset();
+    engine_sim_t sim = { &disp, rpm, 10, 10, NULL };
+    engine_sim_run(&sim, SIM_WARMUP_CYCLES);
+
+    uint32_t late_before = disp.events_late;
+    dwells = 0;
+    sparks = 0;
+    injections = 0;
+    bad_sparks = 0;
+    engine_sim_run(&sim, cycles);
+
+    uint32_t squirts = (mode == INJECTION_MODE_BATCH) ? 2 : 1;
+    uint32_t failures = 0;
+
+    if (disp.events_late != late_before) {
+        printf("FAIL: %u events late\n", disp.events_late - late_before);
+        failures++;
+    }
+    if (disp.arm_failures != 0 || engine_sim_stats.queue_full != 0) {
+        printf("FAIL: %u arm failures, %u queue full\n", disp.arm_failures, engine_sim_stats.queue_full);
+        failures++;
+    }
+    if (disp.list_overruns != 0) {
+        printf("FAIL: %u list overruns\n", disp.list_overruns);
+        failures++;
+    }
+    if (bad_sparks != 0) {
+        printf("FAIL: %u sparks without armed coil\n", bad_sparks);
+        failures++;
+    }
+    // One dwell per spark, give or take the one charging at each end
+    if (dwells + 1 < sparks || dwells > sparks + 1) {
+        printf("FAIL: %u dwells for %u sparks\n", dwells, sparks);
+        failures++;
+    }
+    // Window boundaries may split one cycle's events
+    if (sparks + SIM_CYLINDERS < cycles * SIM_CYLINDERS ||
+        sparks > cycles * SIM_CYLINDERS + SIM_CYLINDERS) {
+        printf("FAIL: %u sparks in %u cycles\n", sparks, cycles);
+        failures++;
+    }
+    if (injections + squirts * SIM_CYLINDERS < cycles * squirts * SIM_CYLINDERS ||
+        injections > cycles * squirts * SIM_CYLINDERS + squirts * SIM_CYLINDERS) {
+        printf("FAIL: %u injections in %u cycles\n", injections, cycles);
+        failures++;
+    }
+
+    printf("V12 %u rpm %-10s %s: %u sparks, %u injections, queue depth %u of %u\n",
+           rpm, get_injection_mode_name(mode), (failures == 0) ? "OK" : "FAILED",
+           sparks, injections, engine_sim_stats.max_depth, (unsigned)HW_SCHEDULER_MAX_EVENTS);
+    return failures == 0;
+}
+
+int main(int argc, char** argv) {
+    uint32_t cycles = 1000;
+    uint16_t rpm = 9000;
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "-cycles=", 8) == 0) {
+            cycles = (uint32_t)strtoul(argv[i] + 8, NULL, 0);
+        } else if (strncmp(argv[i], "-rpm=", 5) == 0) {
+            rpm = (uint16_t)strtoul(argv[i] + 5, NULL, 0);
+        }
+    }
+    if (cycles == 0 || rpm == 0) {
+        printf("usage: v12_sim [-cycles=N] [-rpm=R]\n");
+        return 2;
+    }
+
+    bool ok = true;
+    ok &= run_mode(INJECTION_MODE_SEQUENTIAL, rpm, cycles);
+    ok &= run_mode(INJECTION_MODE_BATCH, rpm, cycles);
+
+    return ok ? 0 : 1;
+}
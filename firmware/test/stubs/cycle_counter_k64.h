@@ -0,0 +1,46 @@
+/**
+ * @file cycle_counter_k64.h
+ * @brief Host stand-in for the DWT cycle counter (test builds only)
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * Shadows src/hal/cycle_counter_k64.h on the host include path. Reads
+ * return a counter advanced by host_cycles_advance(), so recorders that
+ * timestamp with the cycle counter get deterministic values in tests.
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef CYCLE_COUNTER_K64_H
+#define CYCLE_COUNTER_K64_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CYCLE_COUNTER_AVAILABLE     0
+
+extern uint32_t host_cycle_count;
+
+static inline void cycle_counter_enable(void)
+{
+}
+
+static inline uint32_t cycle_counter_read(void)
+{
+    return host_cycle_count;
+}
+
+static inline void host_cycles_advance(uint32_t cycles)
+{
+    host_cycle_count += cycles;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CYCLE_COUNTER_K64_H
@@ -0,0 +1,68 @@
+/**
+ * @file engine_stubs.c
+ * @brief Host stand-ins for engine sensor inputs and PWM outputs (test builds only)
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * ADC channels read 0 V, crank position comes from the simulation (the
+ * controllers under test get their RPM and angle as arguments), and cam
+ * phase is whatever the test sets in host_cam_synced. PWM duty writes
+ * are discarded.
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "hal_stubs.h"
+#include "adc_k64.h"
+#include "input_capture_k64.h"
+#include "cam_sync_k64.h"
+#include "pwm_k64.h"
+#include <stddef.h>
+
+bool host_cam_synced;
+
+static engine_position_t host_engine_position;
+
+float adc_read_voltage(adc_instance_t instance, adc_channel_t channel) {
+    (void)instance;
+    (void)channel;
+    return 0.0f;
+}
+
+engine_position_t* get_engine_position(void) {
+    return &host_engine_position;
+}
+
+uint16_t get_engine_rpm(void) {
+    return 0;
+}
+
+bool is_engine_synced(void) {
+    return true;
+}
+
+bool cam_sync_is_synced(const cam_sync_state_t* cam_sync) {
+    (void)cam_sync;
+    return host_cam_synced;
+}
+
+void pwm_set_duty_value(pwm_ftm_t ftm, pwm_channel_t channel, uint16_t duty_value) {
+    (void)ftm;
+    (void)channel;
+    (void)duty_value;
+}
+
+uint16_t pwm_duty_ticks(pwm_ftm_t ftm, uint16_t duty_permyriad) {
+    (void)ftm;
+    return duty_permyriad;
+}
+
+bool pwm_batch_set(pwm_batch_t* batch, pwm_ftm_t ftm, pwm_channel_t channel,
+                   uint16_t duty_ticks) {
+    (void)batch;
+    (void)ftm;
+    (void)channel;
+    (void)duty_ticks;
+    return true;
+}
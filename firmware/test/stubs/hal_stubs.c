@@ -0,0 +1,95 @@
+/**
+ * @file hal_stubs.c
+ * @brief Host stand-ins for UART, SD card and memory report (test builds only)
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * UART output is counted and discarded, UART input is always empty. The
+ * SD card and the memory report (which needs linker symbols) report
+ * failure / empty data.
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "hal_stubs.h"
+#include "cycle_counter_k64.h"
+#include "uart_k64.h"
+#include "mem_report.h"
+#include "fatfs_wrapper.h"
+#include <string.h>
+
+uint32_t host_cycle_count;
+uint32_t host_uart_tx_bytes;
+
+//=============================================================================
+// UART
+//=============================================================================
+
+void uart_putc(uart_instance_t instance, uint8_t data) {
+    (void)instance;
+    (void)data;
+    host_uart_tx_bytes++;
+}
+
+void uart_puts(uart_instance_t instance, const char* str) {
+    while (*str) {
+        uart_putc(instance, (uint8_t)*str++);
+    }
+}
+
+uint8_t uart_getc(uart_instance_t instance) {
+    (void)instance;
+    return 0;
+}
+
+bool uart_rx_ready(uart_instance_t instance) {
+    (void)instance;
+    return false;
+}
+
+bool uart_tx_ready(uart_instance_t instance) {
+    (void)instance;
+    return true;
+}
+
+//=============================================================================
+// Memory Report
+//=============================================================================
+
+void mem_report_collect(mem_report_t* report) {
+    memset(report, 0, sizeof(mem_report_t));
+}
+
+uint16_t mem_report_serialize(const mem_report_t* report, uint8_t* buffer, uint16_t size) {
+    (void)report;
+    if (size < MEM_REPORT_SIZE) {
+        return 0;
+    }
+    memset(buffer, 0, MEM_REPORT_SIZE);
+    return MEM_REPORT_SIZE;
+}
+
+//=============================================================================
+// SD Card
+//=============================================================================
+
+fatfs_result_t fatfs_open_file(const char* filename, fatfs_mode_t mode, fatfs_file_t* file) {
+    (void)filename;
+    (void)mode;
+    (void)file;
+    return FATFS_ERROR_NOT_INIT;
+}
+
+fatfs_result_t fatfs_write_file(fatfs_file_t file, const void* buffer, uint32_t size, uint32_t* bytes_written) {
+    (void)file;
+    (void)buffer;
+    (void)size;
+    *bytes_written = 0;
+    return FATFS_ERROR_NOT_INIT;
+}
+
+fatfs_result_t fatfs_close_file(fatfs_file_t file) {
+    (void)file;
+    return FATFS_ERROR_NOT_INIT;
+}
@@ -0,0 +1,35 @@
+/**
+ * @file hal_stubs.h
+ * @brief Host stand-ins for target peripherals (test builds only)
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#ifndef HAL_STUBS_H
+#define HAL_STUBS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Bytes sent through uart_putc() since start
+ */
+extern uint32_t host_uart_tx_bytes;
+
+/**
+ * @brief Value returned by cam_sync_is_synced()
+ */
+extern bool host_cam_synced;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HAL_STUBS_H
@@ -0,0 +1,190 @@
+/**
+ * @file dsp_q15_test.c
+ * @brief Known-vector tests for the Q15 kernels (host)
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * The host build has no __ARM_FEATURE_DSP, so the public kernels run the
+ * C reference. These vectors pin its rounding (half up), saturation and
+ * clamping, which the SIMD versions must match bit for bit on the target
+ * (dsp_q15_self_test()).
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "dsp_q15.h"
+#include <stdio.h>
+#include <string.h>
+
+static uint32_t checks;
+static uint32_t failures;
+
+#define CHECK_EQ(actual, expected)                                              \
+    do {                                                                        \
+        long a_ = (long)(actual);                                               \
+        long e_ = (long)(expected);                                             \
+        checks++;                                                               \
+        if (a_ != e_) {                                                         \
+            printf("FAIL %s:%d: %s = %ld, expected %ld\n",                      \
+                   __FILE__, __LINE__, #actual, a_, e_);                        \
+            failures++;                                                         \
+        }                                                                       \
+    } while (0)
+
+static void test_axis(void)
+{
+    static const int16_t bins[] = { 500, 1000, 2000, 4000 };
+    static const struct {
+        int16_t value;
+        uint8_t index;
+        uint16_t frac;
+    } vectors[] = {
+        {  400, 0, 0 },                 // Below the axis: first bin
+        {  500, 0, 0 },
+        {  750, 0, 8192 },
+        { 1000, 1, 0 },                 // On a breakpoint: its own bin
+        { 1250, 1, 4096 },
+        { 3000, 2, 8192 },
+        { 4000, 2, DSP_Q14_ONE },       // Last breakpoint: end of last bin
+        { 5000, 2, DSP_Q14_ONE },       // Above the axis: clamped
+    };
+
+    for (size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+        uint8_t index = 0xFF;
+        uint16_t frac = 0xFFFF;
+        dsp_q15_axis(bins, 4, vectors[i].value, &index, &frac);
+        CHECK_EQ(index, vectors[i].index);
+        CHECK_EQ(frac, vectors[i].frac);
+    }
+}
+
+static void test_bilinear(void)
+{
+    static const int16_t cells[2][2] = { { 100, 200 }, { 300, 400 } };
+    const dsp_q15_table_t table = { &cells[0][0], 2, 2 };
+
+    // Corners, centre and a quarter step
+    CHECK_EQ(dsp_q15_bilinear(&table, 0, 0, 0, 0), 100);
+    CHECK_EQ(dsp_q15_bilinear(&table, 0, 0, DSP_Q14_ONE, 0), 200);
+    CHECK_EQ(dsp_q15_bilinear(&table, 0, 0, 0, DSP_Q14_ONE), 300);
+    CHECK_EQ(dsp_q15_bilinear(&table, 0, 0, DSP_Q14_ONE, DSP_Q14_ONE), 400);
+    CHECK_EQ(dsp_q15_bilinear(&table, 0, 0, 8192, 8192), 250);
+    CHECK_EQ(dsp_q15_bilinear(&table, 0, 0, 4096, 0), 125);
+    CHECK_EQ(dsp_q15_bilinear(&table, 0, 0, 4096, 12288), 275);
+
+    // Fractions above 1.0 are clamped
+    CHECK_EQ(dsp_q15_bilinear(&table, 0, 0, 20000, 0), 200);
+
+    // Halves round up: +0.5 -> 1, -0.5 -> 0
+    static const int16_t half[2][2] = { { 0, 1 }, { 0, -1 } };
+    const dsp_q15_table_t half_table = { &half[0][0], 2, 2 };
+    CHECK_EQ(dsp_q15_bilinear(&half_table, 0, 0, 8192, 0), 1);
+    CHECK_EQ(dsp_q15_bilinear(&half_table, 0, 0, 8192, DSP_Q14_ONE), 0);
+
+    // Full-scale cells never overflow the int16 result
+    static const int16_t extremes[3][3] = {
+        {  32767, -32768,  32767 },
+        { -32768,  32767, -32768 },
+        {  32767,  32767,  32767 },
+    };
+    const dsp_q15_table_t ext = { &extremes[0][0], 3, 3 };
+    CHECK_EQ(dsp_q15_bilinear(&ext, 0, 0, DSP_Q14_ONE, 0), -32768);
+    CHECK_EQ(dsp_q15_bilinear(&ext, 0, 0, 8192, 0), 0);
+    CHECK_EQ(dsp_q15_bilinear(&ext, 1, 1, 0, DSP_Q14_ONE), 32767);
+    CHECK_EQ(dsp_q15_bilinear(&ext, 1, 1, DSP_Q14_ONE, DSP_Q14_ONE), 32767);
+    CHECK_EQ(dsp_q15_bilinear(&ext, 0, 1, 0, 0), -32768);
+}
+
+static void test_iir2(void)
+{
+    dsp_iir2_t filter;
+    uint32_t out;
+
+    // Half steps towards the input, rounded half up on both channels
+    dsp_q15_iir2_init(&filter, 16384, 16384, 0);
+    out = dsp_q15_iir2(&filter, dsp_pack16(1000, -1000));
+    CHECK_EQ(dsp_lo16(out), 500);
+    CHECK_EQ(dsp_hi16(out), -500);
+    out = dsp_q15_iir2(&filter, dsp_pack16(1000, -1000));
+    CHECK_EQ(dsp_lo16(out), 750);
+    CHECK_EQ(dsp_hi16(out), -750);
+    CHECK_EQ(filter.state, out);
+
+    // Full-scale step with maximum alpha: difference saturates first
+    dsp_q15_iir2_init(&filter, 32767, 32767, dsp_pack16(-32768, 32767));
+    out = dsp_q15_iir2(&filter, dsp_pack16(32767, -32768));
+    CHECK_EQ(dsp_lo16(out), -2);
+    CHECK_EQ(dsp_hi16(out), 0);
+
+    // Independent channels: alpha 0 holds, alpha 1/8 settles within
+    // 0.5 / alpha LSB of a constant input
+    dsp_q15_iir2_init(&filter, 4096, 0, dsp_pack16(0, 1234));
+    for (int i = 0; i < 200; i++) {
+        out = dsp_q15_iir2(&filter, dsp_pack16(8000, 8000));
+    }
+    checks++;
+    if (dsp_lo16(out) < 8000 - 4 || dsp_lo16(out) > 8000) {
+        printf("FAIL %s:%d: settled at %d, expected 7996-8000\n", __FILE__, __LINE__, dsp_lo16(out));
+        failures++;
+    }
+    CHECK_EQ(dsp_hi16(out), 1234);
+
+    // Negative coefficients are clamped to 0
+    dsp_q15_iir2_init(&filter, -5, -32768, dsp_pack16(10, 20));
+    out = dsp_q15_iir2(&filter, dsp_pack16(30000, -30000));
+    CHECK_EQ(dsp_lo16(out), 10);
+    CHECK_EQ(dsp_hi16(out), 20);
+
+    // Block filtering equals sample by sample
+    static const uint32_t block[] = { 0x00100020, 0x7FFF8000, 0x80007FFF, 0x12345678, 0 };
+    dsp_iir2_t a;
+    dsp_iir2_t b;
+    dsp_q15_iir2_init(&a, 3000, 20000, dsp_pack16(-100, 100));
+    b = a;
+    for (size_t i = 0; i < sizeof(block) / sizeof(block[0]); i++) {
+        dsp_q15_iir2(&b, block[i]);
+    }
+    CHECK_EQ(dsp_q15_iir2_block(&a, block, sizeof(block) / sizeof(block[0])), b.state);
+}
+
+static void test_trim8(void)
+{
+    static const int16_t base[DSP_TRIM_CYLINDERS] = {
+        1000, 32000, -32000, 0, 32767, -32768, 100, -100
+    };
+    static const int16_t trim[DSP_TRIM_CYLINDERS] = {
+        -10, 1000, -1000, 0, 1, -1, -200, 200
+    };
+    static const int16_t expected[DSP_TRIM_CYLINDERS] = {
+        990, 32767, -32768, 0, 32767, -32768, -100, 100
+    };
+    int16_t out[DSP_TRIM_CYLINDERS];
+
+    dsp_q15_trim8(out, base, trim);
+    for (int i = 0; i < DSP_TRIM_CYLINDERS; i++) {
+        CHECK_EQ(out[i], expected[i]);
+    }
+
+    // Output may alias the base values
+    memcpy(out, base, sizeof(out));
+    dsp_q15_trim8(out, out, trim);
+    CHECK_EQ(memcmp(out, expected, sizeof(out)), 0);
+}
+
+int main(void)
+{
+    test_axis();
+    test_bilinear();
+    test_iir2();
+    test_trim8();
+
+    // Kernels against the reference (trivially equal on the host) and the
+    // benchmark, which needs the target cycle counter
+    CHECK_EQ(dsp_q15_self_test(), 0);
+    dsp_q15_bench_t bench;
+    CHECK_EQ(dsp_q15_benchmark(&bench), DSP_Q15_SIMD);
+
+    printf("dsp_q15: %u checks, %u failed\n", checks, failures);
+    return (failures == 0) ? 0 : 1;
+}
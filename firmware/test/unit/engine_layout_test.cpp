@@ -0,0 +1,195 @@
+/**
+ * @file engine_layout_test.cpp
+ * @brief Compile-time layouts against the runtime path (host)
+ * @version 1.0.0
+ * @date 2026-10-18
+ *
+ * Instantiates EngineLayout for an I4, an I6 and a V8 and checks every
+ * per-slot table and drop-in function against engine_control.c and
+ * ignition_coils.c configured for the same engine:
+ *
+ * - injection and TDC angles, event anchor teeth
+ * - batch pairs and get_injectors_to_fire() over the whole cycle in each
+ *   injection mode
+ * - COP and wasted-spark coil masks as armed by ignition_coils
+ *
+ * The host has no cycle counter, so engine_layout_benchmark() must refuse
+ * to run; the cycle counts come from the target boot benchmark.
+ *
+ * @copyright Copyright (c) 2026 - GPL v3 License
+ * @see https://github.com/pbuchabqui/Teensy35
+ */
+
+#include "engine_layout.h"
+extern "C" {
+#include "ignition_coils.h"
+#include "hal_stubs.h"
+}
+#include <math.h>
+#include <stdio.h>
+
+static uint32_t checks;
+static uint32_t failures;
+
+#define CHECK_EQ(actual, expected)                                              \
+    do {                                                                        \
+        long a_ = (long)(actual);                                               \
+        long e_ = (long)(expected);                                             \
+        checks++;                                                               \
+        if (a_ != e_) {                                                         \
+            printf("FAIL %s:%d: %s = %ld, expected %ld\n",                      \
+                   __FILE__, __LINE__, #actual, a_, e_);                        \
+            failures++;                                                         \
+        }                                                                       \
+    } while (0)
+
+#define CHECK_ANGLE(actual, expected)                                           \
+    do {                                                                        \
+        float a_ = (actual);                                                    \
+        float e_ = (expected);                                                  \
+        checks++;                                                               \
+        if (fabsf(a_ - e_) > 0.001f) {                                          \
+            printf("FAIL %s:%d: %s = %.3f, expected %.3f\n",                    \
+                   __FILE__, __LINE__, #actual, (double)a_, (double)e_);        \
+            failures++;                                                         \
+        }                                                                       \
+    } while (0)
+
+typedef EngineLayout<36, 1, 1, 3, 4, 2> LayoutI4;
+typedef EngineLayout<60, 2, 1, 5, 3, 6, 2, 4> LayoutI6;
+typedef EngineLayout<36, 1, 1, 8, 4, 3, 6, 5, 7, 2> LayoutV8;
+
+template <class Layout>
+static void init_ecu(ecu_state_t* ecu)
+{
+    engine_config_t config;
+
+    memset(&config, 0, sizeof(config));
+    config.num_cylinders = Layout::num_cylinders;
+    config.crank_teeth = Layout::crank_teeth;
+    config.missing_teeth = Layout::crank_teeth - Layout::real_teeth;
+    for (uint8_t slot = 0; slot < Layout::num_cylinders; slot++) {
+        config.firing_order[slot] = Layout::firing_order[slot];
+    }
+    ecu_init(ecu, &config);
+}
+
+/**
+ * @brief Angles and event anchors per slot
+ */
+template <class Layout>
+static void check_angles(ecu_state_t* ecu)
+{
+    const float tooth_deg = 360.0f / Layout::crank_teeth;
+
+    for (uint8_t slot = 0; slot < Layout::num_cylinders; slot++) {
+        CHECK_ANGLE(Layout::injection_angles[slot], calculate_injection_timing(ecu, slot));
+        CHECK_ANGLE(Layout::calculate_injection_timing(slot), calculate_injection_timing(ecu, slot));
+        CHECK_ANGLE(Layout::tdc_events[slot].angle, engine_slot_tdc_angle(&ecu->config, slot));
+
+        const layout_event_t* events[2] = { &Layout::injection_events[slot], &Layout::tdc_events[slot] };
+        for (uint8_t e = 0; e < 2; e++) {
+            CHECK_EQ(events[e]->slot, slot);
+            CHECK_EQ(events[e]->cylinder, ecu->config.firing_order[slot]);
+            CHECK_EQ(events[e]->revolution, (events[e]->angle >= 360.0f) ? 1 : 0);
+            CHECK_EQ(events[e]->tooth < Layout::real_teeth, true);
+            CHECK_ANGLE(events[e]->revolution * 360.0f + events[e]->tooth * tooth_deg +
+                        events[e]->tooth_offset_deg, events[e]->angle);
+        }
+    }
+    CHECK_ANGLE(Layout::calculate_injection_timing(Layout::num_cylinders), 0.0f);
+}
+
+/**
+ * @brief Batch pairs and injector masks over the cycle, every mode
+ */
+template <class Layout>
+static void check_injectors(ecu_state_t* runtime)
+{
+    static const injection_mode_t modes[] = {
+        INJECTION_MODE_SEQUENTIAL, INJECTION_MODE_BATCH,
+        INJECTION_MODE_SIMULTANEOUS, INJECTION_MODE_SINGLE_POINT,
+    };
+    ecu_state_t specialized = *runtime;
+
+    init_batch_injection_pairs(runtime);
+    Layout::init_batch_injection_pairs(&specialized);
+    CHECK_EQ(specialized.fuel.num_batch_pairs, runtime->fuel.num_batch_pairs);
+    for (uint8_t pair = 0; pair < runtime->fuel.num_batch_pairs; pair++) {
+        CHECK_EQ(specialized.fuel.batch_pairs[pair][0], runtime->fuel.batch_pairs[pair][0]);
+        CHECK_EQ(specialized.fuel.batch_pairs[pair][1], runtime->fuel.batch_pairs[pair][1]);
+    }
+
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        runtime->fuel.injection_mode = modes[m];
+        specialized.fuel.injection_mode = modes[m];
+        uint32_t mismatches = 0;
+
+        // Half-degree steps cover both edges of every 5° window
+        for (uint16_t step = 0; step < 1440; step++) {
+            float angle = step * 0.5f;
+            if (Layout::get_injectors_to_fire(&specialized, angle) !=
+                get_injectors_to_fire(runtime, angle)) {
+                mismatches++;
+            }
+        }
+        CHECK_EQ(mismatches, 0);
+    }
+}
+
+/**
+ * @brief Coil masks as armed by ignition_coils (cam synced: COP, lost:
+ * wasted spark)
+ */
+template <class Layout>
+static void check_coils(ecu_state_t* ecu)
+{
+    ignition_coils_t coils;
+    cam_sync_state_t cam;
+
+    memset(&cam, 0, sizeof(cam));
+    ecu->ignition.ignition_mode = IGNITION_MODE_COP;
+    CHECK_EQ(ignition_coils_init(&coils, ecu, &cam), true);
+
+    host_cam_synced = true;
+    ignition_coils_update(&coils);
+    for (uint8_t slot = 0; slot < Layout::num_cylinders; slot++) {
+        CHECK_EQ(Layout::cop_masks[slot], ignition_coils_arm(&coils, slot));
+    }
+
+    host_cam_synced = false;
+    ignition_coils_update(&coils);
+    for (uint8_t slot = 0; slot < Layout::num_cylinders; slot++) {
+        CHECK_EQ(Layout::wasted_spark_masks[slot], ignition_coils_arm(&coils, slot));
+    }
+}
+
+template <class Layout>
+static void check_layout(const char* name)
+{
+    static ecu_state_t ecu;
+    engine_layout_bench_t bench;
+    uint32_t failures_before = failures;
+
+    init_ecu<Layout>(&ecu);
+    check_angles<Layout>(&ecu);
+    check_injectors<Layout>(&ecu);
+    check_coils<Layout>(&ecu);
+
+    // No cycle counter on the host; a mismatched engine is always refused
+    CHECK_EQ(engine_layout_benchmark<Layout>(&ecu, &bench), CYCLE_COUNTER_AVAILABLE);
+    ecu.config.num_cylinders = (uint8_t)(Layout::num_cylinders - 1);
+    CHECK_EQ(engine_layout_benchmark<Layout>(&ecu, &bench), false);
+
+    printf("%s: %s\n", name, (failures == failures_before) ? "OK" : "FAILED");
+}
+
+int main(void)
+{
+    check_layout<LayoutI4>("I4 36-1 1-3-4-2");
+    check_layout<LayoutI6>("I6 60-2 1-5-3-6-2-4");
+    check_layout<LayoutV8>("V8 36-1 1-8-4-3-6-5-7-2");
+
+    printf("engine_layout_test: %u checks, %u failures\n", checks, failures);
+    return (failures == 0) ? 0 : 1;
+}
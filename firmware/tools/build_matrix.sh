@@ -0,0 +1,120 @@
+#!/bin/bash
+###############################################################################
+# Russefi Teensy 3.5 ECU - Size/Speed Build Matrix
+###############################################################################
+#
+# Builds the firmware in each optimization configuration and writes a
+# markdown table of flash/RAM usage, boot benchmark results and the size
+# of the hot ISR symbols.
+#
+# Usage:
+#   tools/build_matrix.sh [output.md]
+#   BENCH_PORT=/dev/ttyACM0 tools/build_matrix.sh [output.md]
+#
+# Benchmarks need teensy_loader_cli and a Teensy 3.5 whose trace UART
+# (UART2 TX, pin 8) is on BENCH_PORT. Each configuration is built with
+# ENABLE_BOOT_BENCHMARK, flashed, and its "bench" trace records are
+# decoded for BENCH_SECONDS (default 5). Without BENCH_PORT the benchmark
+# columns are left empty.
+#
+# Benchmark columns:
+#   PIT min/max  PIT interrupt entry latency, bus ticks (60 MHz)
+#   bilinear, iir2, trim8  Q15 kernel cycles per call (DWT)
+#   inj, fire, pairs       engine_control.c (rt) vs EngineLayout (ct)
+#                          cycles per call for a V8 (DWT)
+#
+# Configurations:
+#   baseline     -O2, FAST_CODE executed from flash
+#   lto          -O2 -flto
+#   hotcold      -O3 hot sources, -Os cold sources
+#   lto-hotcold  both of the above
+#   ramfunc      lto-hotcold + FAST_CODE functions executed from SRAM_L
+#
+###############################################################################
+
+set -e
+
+FW_DIR="$(cd "$(dirname "$0")/.." && pwd)"
+OUT="${1:-${FW_DIR}/build_matrix.md}"
+SIZE="${SIZE:-arm-none-eabi-size}"
+NM="${NM:-arm-none-eabi-nm}"
+ELF="russefi_teensy35.elf"
+BENCH_SECONDS="${BENCH_SECONDS:-5}"
+
+# Keys of the "bench <key> <value>" records, in column order
+BENCH_KEYS="pit_latency_min pit_latency_max bilinear iir2 trim8 \
+    layout_inj_rt layout_inj_ct layout_fire_rt layout_fire_ct layout_pairs_rt layout_pairs_ct"
+
+# Symbols whose size/placement is interesting for interrupt latency
+HOT_SYMBOLS="FTM0_IRQHandler FTM1_IRQHandler FTM2_IRQHandler PIT0_IRQHandler hw_scheduler_ftm_isr"
+
+CONFIGS="baseline lto hotcold lto-hotcold ramfunc"
+
+config_flags() {
+    case "$1" in
+        baseline)    echo "-DENABLE_RAMFUNC=OFF" ;;
+        lto)         echo "-DENABLE_RAMFUNC=OFF -DENABLE_LTO=ON" ;;
+        hotcold)     echo "-DENABLE_RAMFUNC=OFF -DENABLE_HOT_COLD_OPT=ON" ;;
+        lto-hotcold) echo "-DENABLE_RAMFUNC=OFF -DENABLE_LTO=ON -DENABLE_HOT_COLD_OPT=ON" ;;
+        ramfunc)     echo "-DENABLE_LTO=ON -DENABLE_HOT_COLD_OPT=ON -DENABLE_RAMFUNC=ON" ;;
+    esac
+}
+
+# Flash the build in $1 and print "key value" lines from its boot benchmark
+run_benchmark() {
+    teensy_loader_cli -mmcu=mk64fx512 -w "$1/russefi_teensy35.hex" > /dev/null
+    sleep 1
+    stty -F "${BENCH_PORT}" 115200 raw
+    timeout "${BENCH_SECONDS}" python3 "${FW_DIR}/tools/trace_decode.py" "$1/${ELF}" "${BENCH_PORT}" \
+        | sed -n 's/.*\] bench \([a-z0-9_]*\) \([0-9]*\)$/\1 \2/p' || true
+}
+
+{
+    echo "# Build Matrix"
+    echo
+    echo "| Config | text | data | bss | Flash (text+data) | RAM (data+bss) | PIT min | PIT max | bilinear | iir2 | trim8 | inj rt | inj ct | fire rt | fire ct | pairs rt | pairs ct |"
+    echo "|--------|-----:|-----:|----:|------------------:|---------------:|--------:|--------:|---------:|-----:|------:|-------:|-------:|--------:|--------:|---------:|---------:|"
+} > "${OUT}"
+
+SYMS=""
+
+for cfg in ${CONFIGS}; do
+    dir="${FW_DIR}/build-${cfg}"
+    echo "=== ${cfg} ==="
+    bench_flag="-DENABLE_BOOT_BENCHMARK=$([ -n "${BENCH_PORT}" ] && echo ON || echo OFF)"
+    cmake -S "${FW_DIR}" -B "${dir}" -DCMAKE_BUILD_TYPE=Release $(config_flags "${cfg}") "${bench_flag}" > /dev/null
+    cmake --build "${dir}" -j"$(nproc)" > /dev/null
+
+    read -r text data bss _ < <("${SIZE}" --format=berkeley "${dir}/${ELF}" | tail -n 1)
+
+    BENCH=""
+    results=""
+    if [ -n "${BENCH_PORT}" ]; then
+        results=$(run_benchmark "${dir}")
+    fi
+    for key in ${BENCH_KEYS}; do
+        value=$(echo "${results}" | awk -v k="${key}" '$1 == k { print $2 }' | tail -n 1)
+        BENCH="${BENCH} ${value:--} |"
+    done
+
+    echo "| ${cfg} | ${text} | ${data} | ${bss} | $((text + data)) | $((data + bss)) |${BENCH}" >> "${OUT}"
+
+    for sym in ${HOT_SYMBOLS}; do
+        line=$("${NM}" -S "${dir}/${ELF}" | awk -v s="${sym}" '$4 == s { print $1, $2 }')
+        if [ -n "${line}" ]; then
+            set -- ${line}
+            SYMS="${SYMS}| ${cfg} | ${sym} | 0x${1} | $((16#${2})) |"$'\n'
+        fi
+    done
+done
+
+{
+    echo
+    echo "## Hot Symbols"
+    echo
+    echo "| Config | Symbol | Address | Size |"
+    echo "|--------|--------|--------:|-----:|"
+    printf "%s" "${SYMS}"
+} >> "${OUT}"
+
+echo "Report written to ${OUT}"
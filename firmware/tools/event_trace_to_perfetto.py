@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+###############################################################################
+# Russefi Teensy 3.5 ECU - Event Trace to Chrome Trace / Perfetto JSON
+###############################################################################
+#
+# Converts an event_trace.h dump (event_trace_save() on SD, or the
+# TS_PAGE_EVENT_TRACE chunks 0x0400, 0x0401, ... concatenated) to Chrome
+# trace event JSON. Open the result in https://ui.perfetto.dev or
+# chrome://tracing.
+#
+# Tracks:
+#   Trigger      teeth and sync changes (instants), tooth period (counter)
+#   Cylinder N   armed / fired events (instants; fired carries lateness)
+#   ADC          one instant per conversion, raw value as argument
+#   TunerStudio  one instant per packet
+#
+# Timestamps are microseconds relative to the oldest entry; the 32-bit
+# cycle counter is unwrapped entry to entry.
+#
+# Usage:
+#   tools/event_trace_to_perfetto.py trace.bin [-o trace.json]
+#
+###############################################################################
+
+import argparse
+import json
+import struct
+import sys
+
+HEADER = struct.Struct(">HHIII")
+ENTRY = struct.Struct(">IBBH")
+NO_CYLINDER = 0xFF
+
+TOOTH, SYNC, SYNC_LOSS, ARMED, FIRED, ADC, TS_PACKET = range(1, 8)
+
+TRACK_TRIGGER = 1
+TRACK_ADC = 2
+TRACK_TS = 3
+TRACK_CYLINDER = 100  # + cylinder
+
+
+def parse(data):
+    if len(data) < HEADER.size:
+        sys.exit("dump too short (%d bytes)" % len(data))
+    count, entry_size, recorded, frozen_cycles, clock_hz = HEADER.unpack_from(data)
+    if entry_size != ENTRY.size:
+        sys.exit("unexpected entry size %d" % entry_size)
+
+    available = (len(data) - HEADER.size) // ENTRY.size
+    if available < count:
+        sys.stderr.write("warning: dump truncated, %d of %d entries\n" % (available, count))
+        count = available
+
+    entries = [ENTRY.unpack_from(data, HEADER.size + i * ENTRY.size) for i in range(count)]
+    return entries, recorded, frozen_cycles, clock_hz
+
+
+def instant(name, tid, ts, args=None):
+    event = {"name": name, "ph": "i", "s": "t", "pid": 1, "tid": tid, "ts": ts}
+    if args:
+        event["args"] = args
+    return event
+
+
+def convert(entries, clock_hz):
+    events = []
+    cylinders = set()
+    elapsed = 0
+    last_cycles = None
+    last_tooth = None
+
+    for cycles, kind, cylinder, value in entries:
+        if last_cycles is not None:
+            elapsed += (cycles - last_cycles) & 0xFFFFFFFF
+        last_cycles = cycles
+        ts = elapsed * 1e6 / clock_hz
+
+        if kind == TOOTH:
+            events.append(instant("tooth %d" % value, TRACK_TRIGGER, ts, {"tooth": value}))
+            if last_tooth is not None:
+                events.append({"name": "tooth period (us)", "ph": "C", "pid": 1, "ts": ts,
+                               "args": {"period": round(ts - last_tooth, 3)}})
+            last_tooth = ts
+        elif kind == SYNC:
+            events.append(instant("sync", TRACK_TRIGGER, ts, {"sync_count": value}))
+        elif kind == SYNC_LOSS:
+            events.append(instant("SYNC LOSS", TRACK_TRIGGER, ts, {"tooth": value}))
+        elif kind in (ARMED, FIRED):
+            tid = TRACK_CYLINDER + (cylinder if cylinder != NO_CYLINDER else 0)
+            cylinders.add(cylinder)
+            if kind == ARMED:
+                events.append(instant("armed @%d deg" % value, tid, ts, {"angle": value}))
+            else:
+                events.append(instant("fired", tid, ts, {"late_us": value}))
+        elif kind == ADC:
+            events.append(instant("adc ch%d" % cylinder, TRACK_ADC, ts, {"raw": value}))
+        elif kind == TS_PACKET:
+            events.append(instant("ts cmd 0x%02x" % cylinder, TRACK_TS, ts, {"bytes": value}))
+        else:
+            events.append(instant("type %d" % kind, TRACK_TRIGGER, ts,
+                                  {"cylinder": cylinder, "value": value}))
+
+    names = {TRACK_TRIGGER: "Trigger", TRACK_ADC: "ADC", TRACK_TS: "TunerStudio"}
+    for cylinder in cylinders:
+        label = "Cylinder %d" % (cylinder + 1) if cylinder != NO_CYLINDER else "Cylinder ?"
+        names[TRACK_CYLINDER + (cylinder if cylinder != NO_CYLINDER else 0)] = label
+
+    metadata = [{"name": "process_name", "ph": "M", "pid": 1, "args": {"name": "ECU"}}]
+    for tid, name in sorted(names.items()):
+        metadata.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": tid, "args": {"name": name}})
+        metadata.append({"name": "thread_sort_index", "ph": "M", "pid": 1, "tid": tid,
+                         "args": {"sort_index": tid}})
+
+    return metadata + events
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert an event trace dump to Chrome trace / Perfetto JSON")
+    parser.add_argument("dump", help="event trace dump (SD file or concatenated TunerStudio chunks)")
+    parser.add_argument("-o", "--output", help="JSON output file (default stdout)")
+    args = parser.parse_args()
+
+    with open(args.dump, "rb") as f:
+        entries, recorded, frozen_cycles, clock_hz = parse(f.read())
+
+    trace = {
+        "traceEvents": convert(entries, clock_hz or 120000000),
+        "displayTimeUnit": "ns",
+        "metadata": {"entries": len(entries), "recorded": recorded,
+                     "lost": recorded - len(entries), "frozen_cycles": frozen_cycles,
+                     "clock_hz": clock_hz},
+    }
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(trace, f)
+    else:
+        json.dump(trace, sys.stdout)
+        sys.stdout.write("\n")
+
+    sys.stderr.write("%d entries (%d recorded, %d overwritten)\n" %
+                     (len(entries), recorded, recorded - len(entries)))
+
+
+if __name__ == "__main__":
+    main()
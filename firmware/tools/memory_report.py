@@ -0,0 +1,245 @@
+#!/usr/bin/env python3
+###############################################################################
+# Russefi Teensy 3.5 ECU - Memory Footprint Report
+###############################################################################
+#
+# Parses the GNU ld map file and prints per-object-file and per-symbol
+# flash/RAM tables. With --history, appends one CSV row per build (commit,
+# flash, RAM, per-section totals) so footprint can be tracked over commits.
+#
+# Usage:
+#   tools/memory_report.py build/russefi_teensy35.map [--top 30]
+#                          [--output report.md] [--history memory_history.csv]
+#
+# Flash = code + read-only data + load image of .data/.ramfunc
+# RAM   = .data + .ramfunc + .bss + .dmabuf + linker-reserved regions
+#         (RAM vector table, heap, main stack)
+#
+###############################################################################
+
+import argparse
+import csv
+import datetime
+import os
+import re
+import subprocess
+import sys
+from collections import defaultdict
+
+# Output sections by memory they consume
+FLASH_SECTIONS = {".vectors", ".text", ".rodata", ".ARM.extab", ".ARM",
+                  ".preinit_array", ".init_array", ".fini_array"}
+LOADED_SECTIONS = {".data", ".ramfunc"}      # RAM, with a copy in flash
+RAM_SECTIONS = {".bss", ".dmabuf", ".ram_vectors", "._user_heap_stack"}
+
+# Prefixes stripped from -ffunction-sections/-fdata-sections names
+SECTION_PREFIXES = (".text.", ".rodata.", ".data.", ".bss.", ".ramfunc.",
+                    ".fastdata.", ".dmabuf.")
+
+INPUT_RE = re.compile(r"^ (\S+)?\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(.+)$")
+SYMBOL_RE = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+([A-Za-z_.$][\w.$]*)\s*$")
+OUTPUT_RE = re.compile(r"^(\S+)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+))?")
+SIZE_RE = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+load address.*)?$")
+ASSIGN_RE = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+(_sstack|_estack) = ")
+
+
+def classify(out_section):
+    """Return (flash, ram) multipliers for an output section."""
+    if out_section in FLASH_SECTIONS:
+        return 1, 0
+    if out_section in LOADED_SECTIONS:
+        return 1, 1
+    if out_section in RAM_SECTIONS:
+        return 0, 1
+    return 0, 0
+
+
+def short_object(path):
+    """Shorten CMake object paths to the source-relative name."""
+    path = path.strip()
+    match = re.search(r"\.dir/(.+?)\.(?:obj|o)$", path)
+    if match:
+        return match.group(1)
+    if "(" in path:                      # archive member: libc_nano.a(lib_a-memcpy.o)
+        lib, member = path.split("(", 1)
+        return os.path.basename(lib) + "(" + member
+    return os.path.basename(path)
+
+
+def symbol_name(section, symbols):
+    if len(symbols) == 1:
+        return symbols[0]
+    for prefix in SECTION_PREFIXES:
+        if section.startswith(prefix):
+            return section[len(prefix):]
+    return section
+
+
+def parse_map(path):
+    """Return input section entries, output section sizes and stack size.
+
+    Entries are [out_section, in_section, size, object, symbols].
+    """
+    entries = []
+    out_sizes = {}
+    stack = {}
+    in_memory_map = False
+    out_section = None
+    out_pending = False
+    pending_name = None
+    current = None
+
+    with open(path, "r", errors="replace") as f:
+        for line in f:
+            line = line.rstrip("\n")
+
+            match = ASSIGN_RE.match(line)
+            if match:
+                stack[match.group(2)] = int(match.group(1), 16)
+                continue
+
+            if line.startswith("Linker script and memory map"):
+                in_memory_map = True
+                continue
+            if not in_memory_map:
+                continue
+
+            # Output section header (column 0), size may wrap to next line
+            if line and not line[0].isspace():
+                match = OUTPUT_RE.match(line)
+                out_section = match.group(1)
+                out_pending = match.group(3) is None
+                if not out_pending:
+                    out_sizes[out_section] = int(match.group(3), 16)
+                pending_name = None
+                current = None
+                continue
+
+            if out_pending:
+                out_pending = False
+                match = SIZE_RE.match(line)
+                if match:
+                    out_sizes[out_section] = int(match.group(2), 16)
+                    continue
+
+            # Input section whose name did not fit on one line
+            stripped = line.strip()
+            if line.startswith(" ") and not line.startswith("  ") and \
+                    stripped and " " not in stripped:
+                pending_name = stripped
+                current = None
+                continue
+
+            match = INPUT_RE.match(line)
+            if match and (match.group(1) or pending_name):
+                name = match.group(1) or pending_name
+                pending_name = None
+                if name.startswith("*fill*"):
+                    current = None
+                    continue
+                size = int(match.group(3), 16)
+                current = [out_section, name, size, short_object(match.group(4)), []]
+                entries.append(current)
+                continue
+
+            match = SYMBOL_RE.match(line)
+            if match and current is not None:
+                current[4].append(match.group(2))
+
+    stack_size = 0
+    if "_sstack" in stack and "_estack" in stack:
+        stack_size = stack["_estack"] - stack["_sstack"]
+
+    return entries, out_sizes, stack_size
+
+
+def git_revision():
+    try:
+        return subprocess.check_output(["git", "rev-parse", "--short", "HEAD"],
+                                       stderr=subprocess.DEVNULL,
+                                       cwd=os.path.dirname(os.path.abspath(__file__))).decode().strip()
+    except (OSError, subprocess.CalledProcessError):
+        return "unknown"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Per-object/per-symbol flash and RAM usage")
+    parser.add_argument("map_file")
+    parser.add_argument("--top", type=int, default=30, help="rows in each table")
+    parser.add_argument("--output", help="write markdown report to file")
+    parser.add_argument("--history", help="append totals to CSV file")
+    args = parser.parse_args()
+
+    entries, out_sizes, stack_size = parse_map(args.map_file)
+    if not entries:
+        sys.exit("No input sections found in " + args.map_file)
+
+    objects = defaultdict(lambda: [0, 0])
+    symbols = defaultdict(lambda: [0, 0, ""])
+    sections = defaultdict(int)
+
+    for out_section, in_section, size, obj, syms in entries:
+        flash, ram = classify(out_section)
+        if size == 0 or (flash == 0 and ram == 0):
+            continue
+        sections[out_section] += size
+        objects[obj][0] += size * flash
+        objects[obj][1] += size * ram
+        key = (symbol_name(in_section, syms), obj)
+        symbols[key][0] += size * flash
+        symbols[key][1] += size * ram
+        symbols[key][2] = out_section
+
+    # Space reserved by the linker script itself (no input sections)
+    for name in RAM_SECTIONS:
+        reserved = out_sizes.get(name, 0) - sections.get(name, 0)
+        if reserved > 0:
+            sections[name] += reserved
+            objects["(linker reserved)"][1] += reserved
+            symbols[(name, "(linker reserved)")][1] += reserved
+            symbols[(name, "(linker reserved)")][2] = name
+    if stack_size > 0:
+        sections["(main stack)"] = stack_size
+        objects["(linker reserved)"][1] += stack_size
+        symbols[("main stack", "(linker reserved)")][1] += stack_size
+        symbols[("main stack", "(linker reserved)")][2] = "SRAM_L"
+
+    total_flash = sum(v[0] for v in objects.values())
+    total_ram = sum(v[1] for v in objects.values())
+
+    lines = ["# Memory Footprint", "",
+             "Flash: %d bytes, RAM: %d bytes (%s)" % (total_flash, total_ram, git_revision()), "",
+             "## Sections", "", "| Section | Bytes |", "|---------|------:|"]
+    for name, size in sorted(sections.items(), key=lambda kv: -kv[1]):
+        lines.append("| %s | %d |" % (name, size))
+
+    lines += ["", "## Objects", "", "| Object | Flash | RAM |", "|--------|------:|----:|"]
+    for obj, (flash, ram) in sorted(objects.items(), key=lambda kv: -(kv[1][0] + kv[1][1]))[:args.top]:
+        lines.append("| %s | %d | %d |" % (obj, flash, ram))
+
+    lines += ["", "## Symbols", "", "| Symbol | Section | Object | Flash | RAM |",
+              "|--------|---------|--------|------:|----:|"]
+    for (sym, obj), (flash, ram, sec) in sorted(symbols.items(), key=lambda kv: -(kv[1][0] + kv[1][1]))[:args.top]:
+        lines.append("| %s | %s | %s | %d | %d |" % (sym, sec, obj, flash, ram))
+
+    report = "\n".join(lines) + "\n"
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(report)
+    else:
+        sys.stdout.write(report)
+
+    if args.history:
+        new_file = not os.path.exists(args.history)
+        columns = sorted(FLASH_SECTIONS | LOADED_SECTIONS | RAM_SECTIONS)
+        with open(args.history, "a", newline="") as f:
+            writer = csv.writer(f)
+            if new_file:
+                writer.writerow(["date", "commit", "flash", "ram"] + columns)
+            writer.writerow([datetime.datetime.now().isoformat(timespec="seconds"),
+                             git_revision(), total_flash, total_ram] +
+                            [sections.get(c, 0) for c in columns])
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,38 @@
+#!/bin/bash
+###############################################################################
+# Russefi Teensy 3.5 ECU - Stack Usage Report
+###############################################################################
+#
+# Collects the per-function .su files produced by -fstack-usage and lists
+# the largest frames. "dynamic" entries (VLAs, alloca) are flagged since
+# their depth cannot be bounded at compile time.
+#
+# Usage:
+#   tools/stack_report.sh [build_dir] [count]
+#
+# Runtime peak usage is reported by stack_monitor_high_water().
+#
+###############################################################################
+
+set -e
+
+FW_DIR="$(cd "$(dirname "$0")/.." && pwd)"
+BUILD_DIR="${1:-${FW_DIR}/build}"
+COUNT="${2:-25}"
+
+SU_FILES=$(find "${BUILD_DIR}" -name '*.su' 2>/dev/null)
+if [ -z "${SU_FILES}" ]; then
+    echo "No .su files under ${BUILD_DIR} (build with ENABLE_STACK_USAGE=ON)" >&2
+    exit 1
+fi
+
+echo "Largest stack frames (bytes):"
+printf "%8s  %-10s  %s\n" "Bytes" "Type" "Function"
+cat ${SU_FILES} | awk -F'\t' '{ printf "%8d  %-10s  %s\n", $2, $3, $1 }' | sort -rn | head -n "${COUNT}"
+
+DYNAMIC=$(cat ${SU_FILES} | awk -F'\t' '$3 ~ /dynamic/ { print $1 }')
+if [ -n "${DYNAMIC}" ]; then
+    echo
+    echo "Functions with dynamic stack usage:"
+    echo "${DYNAMIC}"
+fi
@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+###############################################################################
+# Russefi Teensy 3.5 ECU - Binary Trace Log Decoder
+###############################################################################
+#
+# Renders trace_log.h records captured from the trace UART (UART2 TX,
+# Teensy pin 8; UART0 is TunerStudio). Format strings
+# are not on the target: they are read from the .trace_fmt section of the
+# firmware ELF, where each record's format ID is the string's address.
+#
+# Frame: 'T' 'R', then 20 bytes little-endian:
+#   uint32 format ID, uint32 DWT cycle counter, uint32 args[3]
+#
+# The cycle counter wraps every 35.8 s at 120 MHz; timestamps are unwrapped
+# assuming consecutive records are less than one wrap apart (the main loop
+# logs a heartbeat every second).
+#
+# Usage:
+#   stty -F /dev/ttyACM0 115200 raw
+#   tools/trace_decode.py build/russefi_teensy35.elf /dev/ttyACM0
+#   tools/trace_decode.py build/russefi_teensy35.elf capture.bin [--clock-hz 120000000]
+#
+###############################################################################
+
+import argparse
+import re
+import struct
+import sys
+
+SYNC = b"TR"
+RECORD = struct.Struct("<5I")
+FORMAT_SECTION = ".trace_fmt"
+
+# printf conversion: flags, width, precision, length modifier, conversion
+SPEC_RE = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(?:hh|h|ll|l|z|j|t)?([diuxXoceEfgGp%])")
+
+
+def read_section(elf_path, name):
+    """Return (address, bytes) of an ELF section, 32- or 64-bit ELF."""
+    with open(elf_path, "rb") as f:
+        data = f.read()
+    if data[:4] != b"\x7fELF":
+        sys.exit(elf_path + ": not an ELF file")
+
+    is64 = data[4] == 2
+    endian = "<" if data[5] == 1 else ">"
+    if is64:
+        shoff, = struct.unpack_from(endian + "Q", data, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + "3H", data, 0x3A)
+        shdr = struct.Struct(endian + "IIQQQQIIQQ")
+    else:
+        shoff, = struct.unpack_from(endian + "I", data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + "3H", data, 0x2E)
+        shdr = struct.Struct(endian + "IIIIIIIIII")
+
+    headers = [shdr.unpack_from(data, shoff + i * shentsize) for i in range(shnum)]
+    strtab = headers[shstrndx]
+    for h in headers:
+        name_off, addr, offset, size = h[0], h[3], h[4], h[5]
+        start = strtab[4] + name_off
+        if data[start:data.index(b"\0", start)].decode() == name:
+            return addr, data[offset:offset + size]
+
+    sys.exit("%s: no %s section (built without trace_log?)" % (elf_path, name))
+
+
+def render(fmt, args):
+    """Apply the record arguments to a printf-style format string."""
+    it = iter(args)
+
+    def convert(m):
+        flags, conv = m.group(1), m.group(2)
+        if conv == "%":
+            return "%"
+        value = next(it, 0)
+        if conv in "di":
+            value = struct.unpack("<i", struct.pack("<I", value))[0]
+        elif conv in "eEfgG":
+            value = struct.unpack("<f", struct.pack("<I", value))[0]
+        elif conv == "c":
+            value = chr(value & 0xFF)
+        elif conv == "p":
+            return "0x%08x" % value
+        elif conv == "u":
+            conv = "d"
+        return ("%" + flags + conv) % value
+
+    return SPEC_RE.sub(convert, fmt)
+
+
+def frames(stream, valid):
+    """Yield records from a byte stream, resynchronizing on the sync word."""
+    buf = b""
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            return
+        buf += chunk
+        while True:
+            start = buf.find(SYNC)
+            if start < 0:
+                buf = buf[-1:]
+                break
+            if len(buf) < start + len(SYNC) + RECORD.size:
+                buf = buf[start:]
+                break
+            record = RECORD.unpack_from(buf, start + len(SYNC))
+            if not valid(record[0]):
+                # Sync word inside a record or line noise; not a real frame
+                buf = buf[start + 1:]
+                continue
+            yield record
+            buf = buf[start + len(SYNC) + RECORD.size:]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode binary trace log records")
+    parser.add_argument("elf", help="firmware ELF with the .trace_fmt section")
+    parser.add_argument("capture", nargs="?", default="-", help="capture file or serial device (default stdin)")
+    parser.add_argument("--clock-hz", type=float, default=120e6, help="core clock (DWT cycle counter rate)")
+    args = parser.parse_args()
+
+    base, strings = read_section(args.elf, FORMAT_SECTION)
+    stream = sys.stdin.buffer if args.capture == "-" else open(args.capture, "rb", buffering=0)
+
+    def valid(fmt_id):
+        return 0 < fmt_id - base < len(strings)
+
+    last = None
+    total = 0
+    for fmt_id, cycles, a, b, c in frames(stream, valid):
+        offset = fmt_id - base
+        fmt = strings[offset:strings.index(b"\0", offset)].decode(errors="replace")
+
+        total += 0 if last is None else (cycles - last) & 0xFFFFFFFF
+        last = cycles
+        sys.stdout.write("[%12.6f] %s\n" % (total / args.clock_hz, render(fmt, (a, b, c))))
+        sys.stdout.flush()
+
+
+if __name__ == "__main__":
+    main()